@@ -91,6 +91,11 @@ typedef struct EbBufferHeaderType {
     double luma_ssim;
     double cr_ssim;
     double cb_ssim;
+
+    // super-res denominator of the input picture, in [8 - 16], 8 meaning no scaling.
+    // Only used when superres_mode is SUPERRES_DYNAMIC, to change the coded width of
+    // any frame without inserting a key frame
+    uint8_t superres_denom;
 } EbBufferHeaderType;
 
 typedef struct EbComponentType {
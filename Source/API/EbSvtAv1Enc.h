@@ -59,6 +59,7 @@ typedef enum {
     SUPERRES_RANDOM,   // All frames are coded at a random scale, and super-resolved.
     SUPERRES_QTHRESH,  // Superres scale for a frame is determined based on q_index.
     SUPERRES_AUTO,     // Automatically select superres for appropriate frames.
+    SUPERRES_DYNAMIC,  // Superres scale of each frame is set by the application with the input picture.
     SUPERRES_MODES
 } SUPERRES_MODE;
 
@@ -703,6 +704,15 @@ typedef struct EbSvtAv1EncConfiguration {
    *
    * Default is 0. */
   int32_t manual_pred_struct_entry_num;
+
+  /* Per-frame budget, in microseconds, of the encode-decode wall time of a picture,
+   * from the start of its first segment to the end of its last one. When set, the
+   * SB mode decision effort (NICs, NSQ, depth and tx search) is lowered or raised as
+   * the projected time goes above or below the budget, instead of switching the
+   * whole picture to another preset. Ignored in the first pass of a two-pass encode.
+   *
+   * Default is 0 (OFF). */
+  uint32_t md_time_budget_us;
 } EbSvtAv1EncConfiguration;
 
 /* STEP 1: Call the library to construct a Component Handle.
@@ -126,6 +126,7 @@
 #define SUPERRES_DENOM "-superres-denom"
 #define SUPERRES_KF_DENOM "-superres-kf-denom"
 #define SUPERRES_QTHRES "-superres-qthres"
+#define SUPERRES_DENOM_FILE "-superres-denom-file"
 // --- end: SUPER-RESOLUTION SUPPORT
 #define HBD_MD_ENABLE_TOKEN "-hbd-md"
 #define PALETTE_TOKEN "-palette-level"
@@ -155,6 +156,7 @@
 #define INJECTOR_TOKEN "-inj" // no Eval
 #define INJECTOR_FRAMERATE_TOKEN "-inj-frm-rt" // no Eval
 #define SPEED_CONTROL_TOKEN "-speed-ctrl"
+#define MD_TIME_BUDGET_TOKEN "-md-time-budget"
 #define ASM_TYPE_TOKEN "-asm"
 #define THREAD_MGMNT "-lp"
 #define UNPIN_TOKEN "-unpin"
@@ -603,6 +605,10 @@ static void set_superres_kf_denom(const char *value, EbConfig *cfg) {
 static void set_superres_qthres(const char *value, EbConfig *cfg) {
     cfg->config.superres_qthres = (uint8_t)strtoul(value, NULL, 0);
 };
+static void set_superres_denom_file(const char *value, EbConfig *cfg) {
+    if (cfg->superres_denom_file) { fclose(cfg->superres_denom_file); }
+    FOPEN(cfg->superres_denom_file, value, "r");
+};
 // --- end: SUPER-RESOLUTION SUPPORT
 static void set_enable_hbd_mode_decision(const char *value, EbConfig *cfg) {
     cfg->config.enable_hbd_mode_decision = (uint8_t)strtoul(value, NULL, 0);
@@ -629,6 +635,9 @@ static void set_injector(const char *value, EbConfig *cfg) {
 static void speed_control_flag(const char *value, EbConfig *cfg) {
     cfg->speed_control_flag = strtol(value, NULL, 0);
 };
+static void set_md_time_budget(const char *value, EbConfig *cfg) {
+    cfg->config.md_time_budget_us = strtoul(value, NULL, 0);
+};
 static void set_injector_frame_rate(const char *value, EbConfig *cfg) {
     cfg->injector_frame_rate = strtoul(value, NULL, 0);
     if (cfg->injector_frame_rate <= 1000)
@@ -1095,6 +1104,10 @@ ConfigEntry config_entry_specific[] = {
      SPEED_CONTROL_TOKEN,
      "Enable speed control(0: OFF[default], 1: ON)",
      speed_control_flag},
+    {SINGLE_INPUT,
+     MD_TIME_BUDGET_TOKEN,
+     "Per-frame encode-decode time budget in us, adapting the SB MD effort, ignored in pass 1(0: OFF[default])",
+     set_md_time_budget},
     // Annex A parameters
     {SINGLE_INPUT,
      FILM_GRAIN_TOKEN,
@@ -1292,6 +1305,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, INJECTOR_TOKEN, "Injector", set_injector},
     {SINGLE_INPUT, INJECTOR_FRAMERATE_TOKEN, "InjectorFrameRate", set_injector_frame_rate},
     {SINGLE_INPUT, SPEED_CONTROL_TOKEN, "SpeedControlFlag", speed_control_flag},
+    {SINGLE_INPUT, MD_TIME_BUDGET_TOKEN, "MdTimeBudget", set_md_time_budget},
     // Annex A parameters
     {SINGLE_INPUT, PROFILE_TOKEN, "Profile", set_profile},
     {SINGLE_INPUT, TIER_TOKEN, "Tier", set_tier},
@@ -1310,6 +1324,7 @@ ConfigEntry config_entry[] = {
     {SINGLE_INPUT, SUPERRES_DENOM, "SuperresDenom", set_superres_denom},
     {SINGLE_INPUT, SUPERRES_KF_DENOM, "SuperresKfDenom", set_superres_kf_denom},
     {SINGLE_INPUT, SUPERRES_QTHRES, "SuperresQthres", set_superres_qthres},
+    {SINGLE_INPUT, SUPERRES_DENOM_FILE, "SuperresDenomFile", set_superres_denom_file},
 
     // double dash
     {SINGLE_INPUT, PRESET_TOKEN, "Encoder mode/Preset used[-2,-1,0,..,8]", set_enc_mode},
@@ -1453,6 +1468,11 @@ void eb_config_dtor(EbConfig *config_ptr) {
         config_ptr->qp_file = (FILE *)NULL;
     }
 
+    if (config_ptr->superres_denom_file) {
+        fclose(config_ptr->superres_denom_file);
+        config_ptr->superres_denom_file = (FILE *)NULL;
+    }
+
     if (config_ptr->stat_file) {
         fclose(config_ptr->stat_file);
         config_ptr->stat_file = (FILE *)NULL;
@@ -173,6 +173,7 @@ typedef struct EbConfig {
     FILE *        stat_file;
     FILE *        buffer_file;
     FILE *        qp_file;
+    FILE *        superres_denom_file;
     /* two pass */
     int           pass;
     const char*   stats;
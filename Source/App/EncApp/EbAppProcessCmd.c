@@ -856,6 +856,23 @@ static unsigned char send_qp_on_the_fly(FILE *const qp_file, uint8_t *use_qp_fil
     return (unsigned)CLIP3(0, 63, tmp_qp);
 }
 
+/**
+ * Reads the super-res denominator of the next picture from the superres_denom_file, one per line.
+ * Once the file is exhausted, the configured superres_denom is used for the remaining pictures.
+ */
+static uint8_t send_superres_denom_on_the_fly(FILE *const superres_denom_file,
+                                              uint8_t     default_denom) {
+    long tmp_denom            = 0;
+    int  denom_read_from_file = 0;
+
+    // skip the comment and empty lines
+    while (tmp_denom == 0 || (tmp_denom == -1 && !feof(superres_denom_file)))
+        tmp_denom = get_next_qp_from_qp_file(superres_denom_file, &denom_read_from_file);
+
+    if (tmp_denom == -1) return default_denom;
+    return (uint8_t)CLIP3(8, 16, tmp_denom);
+}
+
 static void injector(uint64_t processed_frame_count, uint32_t injector_frame_rate) {
     static uint64_t start_times_seconds;
     static uint64_t start_timesu_seconds;
@@ -944,6 +961,11 @@ void process_input_buffer(EncChannel* channel) {
             header_ptr->pts      = config->processed_frame_count - 1;
             header_ptr->pic_type = EB_AV1_INVALID_PICTURE;
             header_ptr->flags    = 0;
+            header_ptr->superres_denom =
+                config->config.superres_mode == SUPERRES_DYNAMIC && config->superres_denom_file
+                    ? send_superres_denom_on_the_fly(config->superres_denom_file,
+                                                     config->config.superres_denom)
+                    : config->config.superres_denom;
 
             // Send the picture
             svt_av1_enc_send_picture(component_handle, header_ptr);
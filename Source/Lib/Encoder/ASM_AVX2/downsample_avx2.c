@@ -0,0 +1,108 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+// Pack the low bytes of the 16-bit lanes of a and b, in order.
+static INLINE __m256i pack_even_bytes(const __m256i a, const __m256i b) {
+    return _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8);
+}
+
+/********************************************
+ * decimation_2d_avx2
+ *      The pyramid levels are built with a decimation step of 2, other steps
+ *      fall back to the C kernel.
+ ********************************************/
+void decimation_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width,
+                        uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride,
+                        uint32_t decim_step) {
+    if (decim_step != 2) {
+        decimation_2d_c(input_samples,
+                        input_stride,
+                        input_area_width,
+                        input_area_height,
+                        decim_samples,
+                        decim_stride,
+                        decim_step);
+        return;
+    }
+
+    const __m256i  mask      = _mm256_set1_epi16(0x00FF);
+    const uint32_t out_width = (input_area_width + 1) >> 1;
+
+    for (uint32_t y = 0; y < input_area_height; y += 2) {
+        uint32_t x = 0;
+        for (; 2 * x + 64 <= input_area_width; x += 32) {
+            const __m256i in0 = _mm256_loadu_si256((const __m256i *)(input_samples + 2 * x));
+            const __m256i in1 = _mm256_loadu_si256((const __m256i *)(input_samples + 2 * x + 32));
+            _mm256_storeu_si256(
+                (__m256i *)(decim_samples + x),
+                pack_even_bytes(_mm256_and_si256(in0, mask), _mm256_and_si256(in1, mask)));
+        }
+        for (; x < out_width; x++) decim_samples[x] = input_samples[2 * x];
+
+        input_samples += 2 * input_stride;
+        decim_samples += decim_stride;
+    }
+}
+
+/********************************************
+ * downsample_2d_avx2
+ *      2x2 averaging for a downsampling step of 2, other steps fall back to
+ *      the C kernel.
+ ********************************************/
+void downsample_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width,
+                        uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride,
+                        uint32_t decim_step) {
+    if (decim_step != 2) {
+        downsample_2d_c(input_samples,
+                        input_stride,
+                        input_area_width,
+                        input_area_height,
+                        decim_samples,
+                        decim_stride,
+                        decim_step);
+        return;
+    }
+
+    const __m256i  ones      = _mm256_set1_epi8(1);
+    const __m256i  round     = _mm256_set1_epi16(2);
+    const uint32_t out_width = input_area_width >> 1;
+
+    for (uint32_t y = 1; y < input_area_height; y += 2) {
+        const uint8_t *top = input_samples;
+        const uint8_t *bot = input_samples + input_stride;
+        uint32_t       x   = 0;
+        for (; x + 32 <= out_width; x += 32) {
+            __m256i s0 = _mm256_add_epi16(
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)(top + 2 * x)), ones),
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)(bot + 2 * x)), ones));
+            __m256i s1 = _mm256_add_epi16(
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)(top + 2 * x + 32)),
+                                     ones),
+                _mm256_maddubs_epi16(_mm256_loadu_si256((const __m256i *)(bot + 2 * x + 32)),
+                                     ones));
+            s0 = _mm256_srli_epi16(_mm256_add_epi16(s0, round), 2);
+            s1 = _mm256_srli_epi16(_mm256_add_epi16(s1, round), 2);
+            _mm256_storeu_si256((__m256i *)(decim_samples + x), pack_even_bytes(s0, s1));
+        }
+        for (; x < out_width; x++) {
+            const uint32_t sum = (uint32_t)top[2 * x] + (uint32_t)top[2 * x + 1] +
+                (uint32_t)bot[2 * x] + (uint32_t)bot[2 * x + 1];
+            decim_samples[x] = (uint8_t)((sum + 2) >> 2);
+        }
+
+        input_samples += 2 * input_stride;
+        decim_samples += decim_stride;
+    }
+}
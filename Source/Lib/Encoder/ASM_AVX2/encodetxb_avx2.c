@@ -12,6 +12,7 @@
 #include <immintrin.h> /* AVX2 */
 
 #include "EbDefinitions.h"
+#include "EbBitstreamUnit.h"
 #include "synonyms.h"
 #include "synonyms_avx2.h"
 
@@ -117,3 +118,194 @@ void svt_av1_txb_init_levels_avx2(const TranLow *const coeff, const int32_t widt
         xx_storeu_128(ls + 4 * 32, x_zeros);
     }
 }
+
+// Rate of 8 coefficients, given their raster positions. Lanes where valid is 0 return 0.
+// The contexts are gathered 4 bytes at a time, so coeff_contexts must be readable up to
+// 3 bytes past the last position.
+static INLINE __m256i cost_coeffs_8_avx2(const uint8_t *const levels, const TranLow *const qcoeff,
+                                         const int8_t *const coeff_contexts,
+                                         const int32_t (*base_cost)[8],
+                                         const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 +
+                                                                   COEFF_BASE_RANGE + 1],
+                                         const __m256i pos, const __m256i valid,
+                                         const int32_t bwl, const TxClass tx_class) {
+    const __m256i zero   = _mm256_setzero_si256();
+    const __m256i byte   = _mm256_set1_epi32(0xff);
+    const __m256i level  = _mm256_abs_epi32(_mm256_i32gather_epi32((const int *)qcoeff, pos, 4));
+    const __m256i ctx    = _mm256_and_si256(
+        _mm256_i32gather_epi32((const int *)coeff_contexts, pos, 1), byte);
+    const __m256i base_idx = _mm256_add_epi32(_mm256_slli_epi32(ctx, 3),
+                                              _mm256_min_epi32(level, _mm256_set1_epi32(3)));
+    __m256i       cost = _mm256_i32gather_epi32((const int *)base_cost[0], base_idx, 4);
+    cost = _mm256_add_epi32(cost,
+                            _mm256_andnot_si256(_mm256_cmpeq_epi32(level, zero),
+                                                _mm256_set1_epi32(1 << AV1_PROB_COST_SHIFT)));
+
+    const __m256i br_mask = _mm256_and_si256(
+        _mm256_cmpgt_epi32(level, _mm256_set1_epi32(NUM_BASE_LEVELS)), valid);
+    if (!_mm256_testz_si256(br_mask, br_mask)) {
+        // get_br_ctx() on the lanes above NUM_BASE_LEVELS.
+        const __m128i bwl_cnt = _mm_cvtsi32_si128(bwl);
+        const int32_t stride  = (1 << bwl) + TX_PAD_HOR;
+        const __m256i row     = _mm256_srl_epi32(pos, bwl_cnt);
+        const __m256i col     = _mm256_sub_epi32(pos, _mm256_sll_epi32(row, bwl_cnt));
+        const __m256i padded  = _mm256_add_epi32(pos, _mm256_slli_epi32(row, TX_PAD_HOR_LOG2));
+        const __m256i right   = _mm256_mask_i32gather_epi32(
+            zero, (const int *)levels, _mm256_add_epi32(padded, _mm256_set1_epi32(1)), br_mask, 1);
+        const __m256i below = _mm256_mask_i32gather_epi32(
+            zero,
+            (const int *)levels,
+            _mm256_add_epi32(padded, _mm256_set1_epi32(stride)),
+            br_mask,
+            1);
+        __m256i mag = _mm256_add_epi32(_mm256_and_si256(right, byte),
+                                       _mm256_and_si256(below, byte));
+        __m256i near;
+        if (tx_class == TX_CLASS_2D) {
+            mag  = _mm256_add_epi32(mag, _mm256_and_si256(_mm256_srli_epi32(below, 8), byte));
+            near = _mm256_and_si256(_mm256_cmpgt_epi32(_mm256_set1_epi32(2), row),
+                                    _mm256_cmpgt_epi32(_mm256_set1_epi32(2), col));
+        } else if (tx_class == TX_CLASS_HORIZ) {
+            mag  = _mm256_add_epi32(mag, _mm256_and_si256(_mm256_srli_epi32(right, 8), byte));
+            near = _mm256_cmpeq_epi32(col, zero);
+        } else {
+            const __m256i below2 = _mm256_mask_i32gather_epi32(
+                zero,
+                (const int *)levels,
+                _mm256_add_epi32(padded, _mm256_set1_epi32(2 * stride)),
+                br_mask,
+                1);
+            mag  = _mm256_add_epi32(mag, _mm256_and_si256(below2, byte));
+            near = _mm256_cmpeq_epi32(row, zero);
+        }
+        mag = _mm256_min_epi32(_mm256_srli_epi32(_mm256_add_epi32(mag, _mm256_set1_epi32(1)), 1),
+                               _mm256_set1_epi32(6));
+        const __m256i br_ctx = _mm256_add_epi32(
+            mag, _mm256_blendv_epi8(_mm256_set1_epi32(14), _mm256_set1_epi32(7), near));
+        const __m256i base_range = _mm256_min_epi32(
+            _mm256_sub_epi32(level, _mm256_set1_epi32(1 + NUM_BASE_LEVELS)),
+            _mm256_set1_epi32(COEFF_BASE_RANGE));
+        const __m256i lps_idx = _mm256_add_epi32(
+            _mm256_mullo_epi32(br_ctx,
+                               _mm256_set1_epi32(COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1)),
+            base_range);
+        cost = _mm256_add_epi32(
+            cost,
+            _mm256_mask_i32gather_epi32(zero, (const int *)lps_cost[0], lps_idx, br_mask, 4));
+
+        // Golomb part, rare enough to stay scalar.
+        const __m256i golomb_mask = _mm256_and_si256(
+            _mm256_cmpgt_epi32(level, _mm256_set1_epi32(NUM_BASE_LEVELS + COEFF_BASE_RANGE)),
+            valid);
+        int golomb_lanes = _mm256_movemask_ps(_mm256_castsi256_ps(golomb_mask));
+        if (golomb_lanes) {
+            DECLARE_ALIGNED(32, int32_t, lvl[8]);
+            DECLARE_ALIGNED(32, int32_t, golomb[8]) = {0};
+            _mm256_store_si256((__m256i *)lvl, level);
+            do {
+                const int32_t lane   = get_msb(golomb_lanes);
+                const int32_t r      = lvl[lane] - COEFF_BASE_RANGE - NUM_BASE_LEVELS;
+                golomb[lane]         = (2 * (get_msb(r) + 1) - 1) << AV1_PROB_COST_SHIFT;
+                golomb_lanes &= ~(1 << lane);
+            } while (golomb_lanes);
+            cost = _mm256_add_epi32(cost, _mm256_load_si256((const __m256i *)golomb));
+        }
+    }
+    return _mm256_and_si256(cost, valid);
+}
+
+int32_t svt_av1_cost_coeffs_txb_inner_avx2(
+    const uint8_t *const levels, const int16_t *const scan, const TranLow *const qcoeff,
+    const int8_t *const coeff_contexts, const int32_t (*base_cost)[8],
+    const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob,
+    const int32_t bwl, const TxClass tx_class) {
+    // The scan indices 1 to eob - 2 are summed in any order, 8 at a time.
+    const int32_t end  = eob - 1;
+    __m256i       acc  = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi32(-1);
+    int32_t       c    = 1;
+    for (; c + 8 <= end; c += 8) {
+        const __m256i pos = _mm256_cvtepi16_epi32(xx_loadu_128(scan + c));
+        acc               = _mm256_add_epi32(acc,
+                                             cost_coeffs_8_avx2(levels,
+                                                                qcoeff,
+                                                                coeff_contexts,
+                                                                base_cost,
+                                                                lps_cost,
+                                                                pos,
+                                                                ones,
+                                                                bwl,
+                                                                tx_class));
+    }
+    if (c < end) {
+        // Remaining lanes point at position 0 and are masked out.
+        DECLARE_ALIGNED(16, int16_t, tail[8]) = {0};
+        const int32_t n                       = end - c;
+        for (int32_t i = 0; i < n; i++) tail[i] = scan[c + i];
+        const __m256i pos   = _mm256_cvtepi16_epi32(_mm_load_si128((const __m128i *)tail));
+        const __m256i valid = _mm256_cmpgt_epi32(_mm256_set1_epi32(n),
+                                                 _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+        acc                 = _mm256_add_epi32(acc,
+                                               cost_coeffs_8_avx2(levels,
+                                                                  qcoeff,
+                                                                  coeff_contexts,
+                                                                  base_cost,
+                                                                  lps_cost,
+                                                                  pos,
+                                                                  valid,
+                                                                  bwl,
+                                                                  tx_class));
+    }
+    const __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(acc),
+                                      _mm256_extracti128_si256(acc, 1));
+    const __m128i s   = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+    return _mm_cvtsi128_si32(_mm_add_epi32(s, _mm_srli_si128(s, 4)));
+}
+
+void svt_av1_update_coeff_eob_fast_avx2(uint16_t *eob, int shift, const int16_t *dequant_ptr,
+                                        const int16_t *scan, const TranLow *coeff_ptr,
+                                        TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr) {
+    const int zbin[2] = {dequant_ptr[0] + ROUND_POWER_OF_TWO(dequant_ptr[0] * 70, 7),
+                         dequant_ptr[1] + ROUND_POWER_OF_TWO(dequant_ptr[1] * 70, 7)};
+    // (abs_coeff << (1 + shift)) < zbin is the same as abs_coeff < ceil(zbin / 2^(1 + shift)),
+    // which cannot overflow in 32 bits.
+    const int     bits   = 1 + shift;
+    const __m256i thr_dc = _mm256_set1_epi32((zbin[0] + (1 << bits) - 1) >> bits);
+    const __m256i thr_ac = _mm256_set1_epi32((zbin[1] + (1 << bits) - 1) >> bits);
+    const __m256i zero   = _mm256_setzero_si256();
+    const int     eob_in = *eob;
+    int           last   = -1; // scan index of the last coefficient that is kept
+    int           i      = eob_in - 1;
+
+    for (; i >= 7; i -= 8) {
+        const __m256i rc    = _mm256_cvtepi16_epi32(xx_loadu_128(scan + i - 7));
+        const __m256i coeff = _mm256_abs_epi32(
+            _mm256_i32gather_epi32((const int *)coeff_ptr, rc, 4));
+        const __m256i qcoeff = _mm256_i32gather_epi32((const int *)qcoeff_ptr, rc, 4);
+        const __m256i thr    = _mm256_blendv_epi8(thr_ac, thr_dc, _mm256_cmpeq_epi32(rc, zero));
+        const __m256i drop   = _mm256_or_si256(_mm256_cmpgt_epi32(thr, coeff),
+                                             _mm256_cmpeq_epi32(qcoeff, zero));
+        const int     keep   = ~_mm256_movemask_ps(_mm256_castsi256_ps(drop)) & 0xff;
+        if (keep) {
+            last = i - 7 + get_msb(keep);
+            break;
+        }
+    }
+    if (last < 0) {
+        for (; i >= 0; i--) {
+            const int rc        = scan[i];
+            const int coeff     = coeff_ptr[rc];
+            const int abs_coeff = coeff < 0 ? -coeff : coeff;
+            if ((((int64_t)abs_coeff << bits) >= zbin[rc != 0]) && qcoeff_ptr[rc] != 0) {
+                last = i;
+                break;
+            }
+        }
+    }
+    for (int j = last + 1; j < eob_in; j++) {
+        const int rc    = scan[j];
+        qcoeff_ptr[rc]  = 0;
+        dqcoeff_ptr[rc] = 0;
+    }
+    *eob = (uint16_t)(last + 1);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <string.h>
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "hash.h"
+#include "aom_dsp_rtcd.h"
+
+/* The crc32 instructions are part of SSE4.2, which every AVX2 CPU supports. */
+uint32_t svt_av1_get_crc32c_value_avx2(void *crc_calculator, uint8_t *p, size_t length) {
+    (void)crc_calculator;
+    const uint8_t *buf = p;
+    uint64_t       crc = 0xFFFFFFFF;
+
+    for (; length >= 8; length -= 8, buf += 8) {
+        uint64_t word;
+        memcpy(&word, buf, sizeof(word));
+        crc = _mm_crc32_u64(crc, word);
+    }
+    uint32_t crc32 = (uint32_t)crc;
+    if (length >= 4) {
+        uint32_t word;
+        memcpy(&word, buf, sizeof(word));
+        crc32 = _mm_crc32_u32(crc32, word);
+        length -= 4;
+        buf += 4;
+    }
+    for (; length; length--) crc32 = _mm_crc32_u8(crc32, *buf++);
+    return crc32 ^ 0xFFFFFFFF;
+}
+
+// One byte of the 24-bit table CRC of crc_calculator1, on 8 lanes.
+static INLINE __m256i crc24_byte(const int *table, const __m256i remainder, const __m256i data) {
+    const __m256i mask  = _mm256_set1_epi32(0xFF);
+    const __m256i index = _mm256_and_si256(
+        _mm256_xor_si256(_mm256_srli_epi32(remainder, 16), data), mask);
+    return _mm256_xor_si256(_mm256_slli_epi32(remainder, 8),
+                            _mm256_i32gather_epi32(table, index, 4));
+}
+
+// Store the 0/1 flags of 8 32-bit lanes to 8 bytes.
+static INLINE void store_flags(int8_t *dst, const __m256i flags) {
+    const __m256i words = _mm256_packs_epi32(flags, flags);
+    const __m256i bytes = _mm256_packs_epi16(words, words);
+    const int32_t lo    = _mm_cvtsi128_si32(_mm256_castsi256_si128(bytes));
+    const int32_t hi    = _mm_cvtsi128_si32(_mm256_extracti128_si256(bytes, 1));
+    memcpy(dst, &lo, sizeof(lo));
+    memcpy(dst + 4, &hi, sizeof(hi));
+}
+
+/* Hashes 8 2x2 blocks per iteration. The 4 pixels of each block are gathered in
+ * one 32-bit lane, in the order of the C reference, which gives the same-value
+ * flags with 2 compares and feeds the crc32 instruction with one word. */
+void svt_av1_get_block_2x2_hash_row_avx2(const uint8_t *src, int stride, int width,
+                                         void *crc_calculator1, void *crc_calculator2,
+                                         uint32_t *hash1, uint32_t *hash2, int8_t *row_same,
+                                         int8_t *col_same) {
+    const int *   table = (const int *)((CRC_CALCULATOR *)crc_calculator1)->table;
+    const __m256i one   = _mm256_set1_epi32(1);
+    const __m256i mask  = _mm256_set1_epi32(0xFFFFFF);
+    DECLARE_ALIGNED(32, uint32_t, words[8]);
+    int x = 0;
+
+    for (; x + 8 <= width; x += 8) {
+        const __m256i a = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + x)));
+        const __m256i b = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + x + 1)));
+        const __m256i c =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + stride + x)));
+        const __m256i d =
+            _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)(src + stride + x + 1)));
+
+        store_flags(row_same + x,
+                    _mm256_and_si256(
+                        _mm256_and_si256(_mm256_cmpeq_epi32(a, b), _mm256_cmpeq_epi32(c, d)),
+                        one));
+        store_flags(col_same + x,
+                    _mm256_and_si256(
+                        _mm256_and_si256(_mm256_cmpeq_epi32(a, c), _mm256_cmpeq_epi32(b, d)),
+                        one));
+
+        __m256i crc = _mm256_i32gather_epi32(table, a, 4);
+        crc         = crc24_byte(table, crc, b);
+        crc         = crc24_byte(table, crc, c);
+        crc         = crc24_byte(table, crc, d);
+        _mm256_storeu_si256((__m256i *)(hash1 + x), _mm256_and_si256(crc, mask));
+
+        const __m256i word = _mm256_or_si256(
+            _mm256_or_si256(a, _mm256_slli_epi32(b, 8)),
+            _mm256_or_si256(_mm256_slli_epi32(c, 16), _mm256_slli_epi32(d, 24)));
+        _mm256_store_si256((__m256i *)words, word);
+        for (int i = 0; i < 8; i++)
+            hash2[x + i] = _mm_crc32_u32(0xFFFFFFFF, words[i]) ^ 0xFFFFFFFF;
+    }
+
+    if (x < width)
+        svt_av1_get_block_2x2_hash_row_c(src + x,
+                                         stride,
+                                         width - x,
+                                         crc_calculator1,
+                                         crc_calculator2,
+                                         hash1 + x,
+                                         hash2 + x,
+                                         row_same + x,
+                                         col_same + x);
+}
@@ -2641,6 +2641,112 @@ void svt_av1_fwd_txfm2d_16x16_avx2(int16_t *input, int32_t *coeff, uint32_t stri
     (void)bd;
 }
 
+static INLINE void fwd_txfm_1d_8x8_avx2(TxType1D type, const __m256i *in, __m256i *out,
+                                        int8_t bit) {
+    switch (type) {
+    case DCT_1D: fdct8x8_avx2(in, out, bit, 1); break;
+    case ADST_1D:
+    case FLIPADST_1D: fadst8x8_avx2(in, out, bit, 1); break;
+    case IDTX_1D: fidtx8x8_avx2(in, out, bit, 1); break;
+    default: assert(0);
+    }
+}
+
+static INLINE void fwd_txfm_1d_16x16_avx2(TxType1D type, const __m256i *in, __m256i *out,
+                                          int8_t bit) {
+    switch (type) {
+    case DCT_1D: fdct16x16_avx2(in, out, bit, 2); break;
+    case ADST_1D:
+    case FLIPADST_1D: fadst16x16_avx2(in, out, bit, 2); break;
+    case IDTX_1D: fidtx16x16_avx2(in, out, bit, 2); break;
+    default: assert(0);
+    }
+}
+
+// Column pass of the split 2D transform, see svt_av1_fwd_txfm2d_col_c(). The
+// left/right flip is left to the row pass, so the output only depends on the
+// vertical 1D type.
+void svt_av1_fwd_txfm2d_col_avx2(int16_t *input, int32_t *buf, uint32_t input_stride,
+                                 TxSize transform_size, TxType transform_type, uint8_t bit_depth) {
+    __m256i        in[32], out[32];
+    const TxType1D vtx     = vtx_tab[transform_type];
+    const int8_t * shift   = fwd_txfm_shift_ls[transform_size];
+    const int32_t  txw_idx = get_txw_idx(transform_size);
+    const int32_t  txh_idx = get_txh_idx(transform_size);
+
+    switch (transform_size) {
+    case TX_8X8:
+        load_buffer_8x8(input, in, input_stride, vtx == FLIPADST_1D, 0, shift[0]);
+        fwd_txfm_1d_8x8_avx2(vtx, in, out, fwd_cos_bit_col[txw_idx][txh_idx]);
+        col_txfm_8x8_rounding(out, -shift[1]);
+        write_buffer_8x8(out, buf);
+        break;
+    case TX_16X16:
+        load_buffer_16x16(input, in, input_stride, vtx == FLIPADST_1D, 0, shift[0]);
+        fwd_txfm_1d_16x16_avx2(vtx, in, out, fwd_cos_bit_col[txw_idx][txh_idx]);
+        col_txfm_16x16_rounding(out, -shift[1]);
+        write_buffer_16x16(out, buf);
+        break;
+    default:
+        svt_av1_fwd_txfm2d_col_c(
+            input, buf, input_stride, transform_size, transform_type, bit_depth);
+        break;
+    }
+}
+
+// Row pass of the split 2D transform, see svt_av1_fwd_txfm2d_row_c(). The
+// left/right flip is applied on the transposed rows by reversing the order of
+// the vectors. shift[2] is 0 for the square sizes handled here.
+void svt_av1_fwd_txfm2d_row_avx2(const int32_t *buf, int32_t *output, TxSize transform_size,
+                                 TxType transform_type, uint8_t bit_depth) {
+    __m256i        in[32], tr[32], out[32];
+    const TxType1D htx     = htx_tab[transform_type];
+    const int32_t  txw_idx = get_txw_idx(transform_size);
+    const int32_t  txh_idx = get_txh_idx(transform_size);
+    const int8_t   bit     = fwd_cos_bit_row[txw_idx][txh_idx];
+
+    switch (transform_size) {
+    case TX_8X8:
+        for (int32_t i = 0; i < 8; i++) in[i] = _mm256_loadu_si256((const __m256i *)(buf + i * 8));
+        if (htx == IDTX_1D) {
+            fidtx8x8_avx2(in, out, bit, 1);
+            write_buffer_8x8(out, output);
+            break;
+        }
+        transpose_8x8_avx2(in, tr);
+        if (htx == FLIPADST_1D) {
+            for (int32_t i = 0; i < 8; i++) in[i] = tr[7 - i];
+            fwd_txfm_1d_8x8_avx2(htx, in, out, bit);
+        } else
+            fwd_txfm_1d_8x8_avx2(htx, tr, out, bit);
+        transpose_8x8_avx2(out, in);
+        write_buffer_8x8(in, output);
+        break;
+    case TX_16X16:
+        for (int32_t i = 0; i < 32; i++) in[i] = _mm256_loadu_si256((const __m256i *)(buf + i * 8));
+        if (htx == IDTX_1D) {
+            fidtx16x16_avx2(in, out, bit, 2);
+            write_buffer_16x16(out, output);
+            break;
+        }
+        transpose_16x16_avx2(in, tr);
+        if (htx == FLIPADST_1D) {
+            for (int32_t i = 0; i < 16; i++) {
+                in[2 * i]     = tr[2 * (15 - i)];
+                in[2 * i + 1] = tr[2 * (15 - i) + 1];
+            }
+            fwd_txfm_1d_16x16_avx2(htx, in, out, bit);
+        } else
+            fwd_txfm_1d_16x16_avx2(htx, tr, out, bit);
+        transpose_16x16_avx2(out, in);
+        write_buffer_16x16(in, output);
+        break;
+    default:
+        svt_av1_fwd_txfm2d_row_c(buf, output, transform_size, transform_type, bit_depth);
+        break;
+    }
+}
+
 static void av1_fdct32_new_avx2(const __m256i *input, __m256i *output, int8_t cos_bit,
                                 const int32_t col_num, const int32_t stride) {
     const int32_t *cospi      = cospi_arr(cos_bit);
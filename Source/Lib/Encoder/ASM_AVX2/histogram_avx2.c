@@ -0,0 +1,105 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <string.h>
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+// Number of interleaved sub-histograms. Consecutive samples update different
+// tables, so runs of equal samples do not serialize on the same counter.
+#define HIST_SUB_COUNT 4
+#define HIST_BIN_COUNT 256
+// Below this number of samples, clearing and merging the sub-histograms costs
+// more than it saves.
+#define HIST_MIN_AVX2_SAMPLES 1024
+
+static INLINE void add_bytes_8(uint32_t hist[HIST_SUB_COUNT][HIST_BIN_COUNT], uint64_t v) {
+    hist[0][v & 0xff]++;
+    hist[1][(v >> 8) & 0xff]++;
+    hist[2][(v >> 16) & 0xff]++;
+    hist[3][(v >> 24) & 0xff]++;
+    hist[0][(v >> 32) & 0xff]++;
+    hist[1][(v >> 40) & 0xff]++;
+    hist[2][(v >> 48) & 0xff]++;
+    hist[3][v >> 56]++;
+}
+
+void calculate_histogram_avx2(uint8_t *input_samples, uint32_t input_area_width,
+                              uint32_t input_area_height, uint32_t stride, uint8_t decim_step,
+                              uint32_t *histogram, uint64_t *sum) {
+    if ((decim_step != 1 && decim_step != 4) ||
+        (input_area_width / decim_step) * (input_area_height / decim_step) <
+            HIST_MIN_AVX2_SAMPLES) {
+        calculate_histogram_c(input_samples,
+                              input_area_width,
+                              input_area_height,
+                              stride,
+                              decim_step,
+                              histogram,
+                              sum);
+        return;
+    }
+
+    DECLARE_ALIGNED(32, uint32_t, hist[HIST_SUB_COUNT][HIST_BIN_COUNT]);
+    DECLARE_ALIGNED(32, uint64_t, lanes[4]);
+    memset(hist, 0, sizeof(hist));
+
+    // With decim_step 4 only the first byte of every 32-bit lane is a sample.
+    const __m256i mask     = decim_step == 4 ? _mm256_set1_epi32(0xff) : _mm256_set1_epi8(-1);
+    const __m256i zero     = _mm256_setzero_si256();
+    __m256i       sum_acc  = zero;
+    uint64_t      sum_tail = 0;
+
+    for (uint32_t y = 0; y < input_area_height; y += decim_step) {
+        uint32_t x = 0;
+        for (; x + 32 <= input_area_width; x += 32) {
+            const __m256i v = _mm256_and_si256(
+                _mm256_loadu_si256((const __m256i *)(input_samples + x)), mask);
+            sum_acc = _mm256_add_epi64(sum_acc, _mm256_sad_epu8(v, zero));
+            _mm256_store_si256((__m256i *)lanes, v);
+            if (decim_step == 1) {
+                add_bytes_8(hist, lanes[0]);
+                add_bytes_8(hist, lanes[1]);
+                add_bytes_8(hist, lanes[2]);
+                add_bytes_8(hist, lanes[3]);
+            } else {
+                hist[0][lanes[0] & 0xff]++;
+                hist[1][lanes[0] >> 32]++;
+                hist[2][lanes[1] & 0xff]++;
+                hist[3][lanes[1] >> 32]++;
+                hist[0][lanes[2] & 0xff]++;
+                hist[1][lanes[2] >> 32]++;
+                hist[2][lanes[3] & 0xff]++;
+                hist[3][lanes[3] >> 32]++;
+            }
+        }
+        for (; x < input_area_width; x += decim_step) {
+            hist[0][input_samples[x]]++;
+            sum_tail += input_samples[x];
+        }
+        input_samples += (stride << (decim_step >> 1));
+    }
+
+    for (int i = 0; i < HIST_BIN_COUNT; i += 8) {
+        const __m256i h01 = _mm256_add_epi32(_mm256_load_si256((const __m256i *)(hist[0] + i)),
+                                             _mm256_load_si256((const __m256i *)(hist[1] + i)));
+        const __m256i h23 = _mm256_add_epi32(_mm256_load_si256((const __m256i *)(hist[2] + i)),
+                                             _mm256_load_si256((const __m256i *)(hist[3] + i)));
+        const __m256i h   = _mm256_add_epi32(_mm256_loadu_si256((const __m256i *)(histogram + i)),
+                                           _mm256_add_epi32(h01, h23));
+        _mm256_storeu_si256((__m256i *)(histogram + i), h);
+    }
+
+    const __m128i s = _mm_add_epi64(_mm256_castsi256_si128(sum_acc),
+                                    _mm256_extracti128_si256(sum_acc, 1));
+    *sum = sum_tail + (uint64_t)_mm_cvtsi128_si64(_mm_add_epi64(s, _mm_srli_si128(s, 8)));
+}
@@ -0,0 +1,33 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+// Same multiply, divide and add per element as the C version, so the
+// accumulated system is bit-exact.
+void svt_av1_add_block_observations_internal_avx2(uint32_t n, const double *buffer, double val,
+                                                  double norm_sq, double *A, double *b) {
+    const __m256d norm = _mm256_set1_pd(norm_sq);
+    for (uint32_t i = 0; i < n; ++i) {
+        const __m256d bi  = _mm256_set1_pd(buffer[i]);
+        double *      row = A + i * n;
+        uint32_t      j   = i;
+        for (; j + 4 <= n; j += 4) {
+            const __m256d prod =
+                _mm256_div_pd(_mm256_mul_pd(bi, _mm256_loadu_pd(buffer + j)), norm);
+            _mm256_storeu_pd(row + j, _mm256_add_pd(_mm256_loadu_pd(row + j), prod));
+        }
+        for (; j < n; ++j) row[j] += (buffer[i] * buffer[j]) / norm_sq;
+        b[i] += (buffer[i] * val) / norm_sq;
+    }
+}
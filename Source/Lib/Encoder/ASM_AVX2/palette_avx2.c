@@ -12,6 +12,7 @@
 #include <immintrin.h>
 #include "EbDefinitions.h"
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #define DIVIDE_AND_ROUND(x, y) (((x) + ((y) >> 1)) / (y))
 
 static INLINE unsigned int lcg_rand16(unsigned int *state) {
@@ -396,3 +397,74 @@ void av1_k_means_dim2_avx2(const int *data, int *centroids, uint8_t *indices, in
         if (!memcmp(centroids, pre_centroids, sizeof(pre_centroids[0]) * k * 2)) break;
     }
 }
+
+// Number of non-zero entries of val_count, 8 entries per iteration.
+static INLINE int count_non_zero_avx2(const int *val_count, int size) {
+    __m256i zeros = _mm256_setzero_si256();
+    for (int i = 0; i < size; i += 8) {
+        const __m256i count = _mm256_loadu_si256((const __m256i *)(val_count + i));
+        zeros = _mm256_sub_epi32(zeros, _mm256_cmpeq_epi32(count, _mm256_setzero_si256()));
+    }
+    const __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(zeros),
+                                      _mm256_extracti128_si256(zeros, 1));
+    const __m128i sum2 = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+    return size - _mm_cvtsi128_si32(_mm_add_epi32(sum2, _mm_srli_si128(sum2, 4)));
+}
+
+/* Screen content has long runs of the same color: a run of 32 (or 16) samples is counted
+ * with one compare and one increment, other samples are counted one by one. */
+int svt_av1_count_colors_avx2(const uint8_t *src, int stride, int rows, int cols,
+                              int *val_count) {
+    const int max_pix_val = 1 << 8;
+    memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
+    for (int r = 0; r < rows; ++r) {
+        const uint8_t *row = src + r * stride;
+        int            c   = 0;
+        for (; c + 32 <= cols; c += 32) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *)(row + c));
+            if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(s, _mm256_set1_epi8(row[c]))) == -1)
+                val_count[row[c]] += 32;
+            else
+                for (int i = 0; i < 32; ++i) ++val_count[row[c + i]];
+        }
+        for (; c + 16 <= cols; c += 16) {
+            const __m128i s = _mm_loadu_si128((const __m128i *)(row + c));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(s, _mm_set1_epi8(row[c]))) == 0xFFFF)
+                val_count[row[c]] += 16;
+            else
+                for (int i = 0; i < 16; ++i) ++val_count[row[c + i]];
+        }
+        for (; c < cols; ++c) ++val_count[row[c]];
+    }
+    return count_non_zero_avx2(val_count, max_pix_val);
+}
+
+int svt_av1_count_colors_highbd_avx2(uint16_t *src, int stride, int rows, int cols, int bit_depth,
+                                     int *val_count) {
+    assert(bit_depth <= 12);
+    const int max_pix_val = 1 << bit_depth;
+    memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
+    for (int r = 0; r < rows; ++r) {
+        const uint16_t *row = src + r * stride;
+        int             c   = 0;
+        for (; c + 16 <= cols; c += 16) {
+            const __m256i s = _mm256_loadu_si256((const __m256i *)(row + c));
+            if (row[c] < max_pix_val &&
+                _mm256_movemask_epi8(_mm256_cmpeq_epi16(s, _mm256_set1_epi16(row[c]))) == -1) {
+                val_count[row[c]] += 16;
+                continue;
+            }
+            for (int i = 0; i < 16; ++i) {
+                const int this_val = row[c + i];
+                if (this_val >= max_pix_val) return 0;
+                ++val_count[this_val];
+            }
+        }
+        for (; c < cols; ++c) {
+            const int this_val = row[c];
+            if (this_val >= max_pix_val) return 0;
+            ++val_count[this_val];
+        }
+    }
+    return count_non_zero_avx2(val_count, max_pix_val);
+}
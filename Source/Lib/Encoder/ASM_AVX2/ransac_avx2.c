@@ -0,0 +1,80 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <math.h>
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "ransac.h"
+
+/* Scores an affine hypothesis on 4 points per iteration. The projection and the
+distance use the operations of the C reference in the same order, so the inliers and
+the distance sums are bit-exact. The sums are accumulated in point order.
+*/
+int svt_av1_ransac_find_inliers_avx2(const double *mat, const double *corners1,
+                                     const double *corners2, int npoints, int *inlier_indices,
+                                     double *sum_distance, double *sum_distance_squared) {
+    const __m256d m0        = _mm256_set1_pd(mat[0]);
+    const __m256d m1        = _mm256_set1_pd(mat[1]);
+    const __m256d m2        = _mm256_set1_pd(mat[2]);
+    const __m256d m3        = _mm256_set1_pd(mat[3]);
+    const __m256d m4        = _mm256_set1_pd(mat[4]);
+    const __m256d m5        = _mm256_set1_pd(mat[5]);
+    const __m256d threshold = _mm256_set1_pd(INLIER_THRESHOLD);
+    DECLARE_ALIGNED(32, double, distances[4]);
+    int num_inliers = 0;
+    int i           = 0;
+
+    for (; i + 4 <= npoints; i += 4) {
+        // Deinterleave 4 (x, y) pairs into x0 x1 x2 x3 and y0 y1 y2 y3
+        const __m256d p1_lo = _mm256_loadu_pd(corners1 + i * 2);
+        const __m256d p1_hi = _mm256_loadu_pd(corners1 + i * 2 + 4);
+        const __m256d p2_lo = _mm256_loadu_pd(corners2 + i * 2);
+        const __m256d p2_hi = _mm256_loadu_pd(corners2 + i * 2 + 4);
+        const __m256d x = _mm256_permute4x64_pd(_mm256_unpacklo_pd(p1_lo, p1_hi), 0xD8);
+        const __m256d y = _mm256_permute4x64_pd(_mm256_unpackhi_pd(p1_lo, p1_hi), 0xD8);
+        const __m256d rx = _mm256_permute4x64_pd(_mm256_unpacklo_pd(p2_lo, p2_hi), 0xD8);
+        const __m256d ry = _mm256_permute4x64_pd(_mm256_unpackhi_pd(p2_lo, p2_hi), 0xD8);
+
+        const __m256d dx = _mm256_sub_pd(
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m2, x), _mm256_mul_pd(m3, y)), m0), rx);
+        const __m256d dy = _mm256_sub_pd(
+            _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(m4, x), _mm256_mul_pd(m5, y)), m1), ry);
+        const __m256d distance =
+            _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        const int mask = _mm256_movemask_pd(_mm256_cmp_pd(distance, threshold, _CMP_LT_OQ));
+
+        if (mask) {
+            _mm256_store_pd(distances, distance);
+            for (int j = 0; j < 4; ++j) {
+                if (mask & (1 << j)) {
+                    inlier_indices[num_inliers++] = i + j;
+                    *sum_distance += distances[j];
+                    *sum_distance_squared += distances[j] * distances[j];
+                }
+            }
+        }
+    }
+
+    for (; i < npoints; ++i) {
+        const double x        = corners1[i * 2];
+        const double y        = corners1[i * 2 + 1];
+        const double dx       = mat[2] * x + mat[3] * y + mat[0] - corners2[i * 2];
+        const double dy       = mat[4] * x + mat[5] * y + mat[1] - corners2[i * 2 + 1];
+        const double distance = sqrt(dx * dx + dy * dy);
+
+        if (distance < INLIER_THRESHOLD) {
+            inlier_indices[num_inliers++] = i;
+            *sum_distance += distance;
+            *sum_distance_squared += distance * distance;
+        }
+    }
+    return num_inliers;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "EbInterPrediction.h"
+#include "aom_dsp_rtcd.h"
+
+// Filters for factor of 2 downsampling, as 8-tap kernels (see EbResize.c).
+static const int16_t down2_symeven_filter[SUBPEL_TAPS] = {-1, -3, 12, 56, 56, 12, -3, -1};
+static const int16_t down2_symodd_filter[SUBPEL_TAPS]  = {0, -3, 0, 35, 64, 35, 0, -3};
+
+/*
+ * All the horizontal resize kernels are expressed as an 8-tap filter applied at
+ * position (y >> RS_SCALE_SUBPEL_BITS) - 3 of the input row for each output sample,
+ * y starting at y0 and incremented by delta, the filter being selected by the
+ * sub-pel part of y. Input samples out of the row are clamped to its edges.
+ */
+static INLINE int32_t filter8_clamped(const uint8_t *const input, int in_length, int first,
+                                      const int16_t *filter) {
+    int32_t sum = 0;
+    for (int k = 0; k < SUBPEL_TAPS; ++k)
+        sum += filter[k] * input[AOMMAX(AOMMIN(first + k, in_length - 1), 0)];
+    return ROUND_POWER_OF_TWO(sum, FILTER_BITS);
+}
+
+static INLINE int32_t highbd_filter8_clamped(const uint16_t *const input, int in_length,
+                                             int first, const int16_t *filter) {
+    int32_t sum = 0;
+    for (int k = 0; k < SUBPEL_TAPS; ++k)
+        sum += filter[k] * input[AOMMAX(AOMMIN(first + k, in_length - 1), 0)];
+    return ROUND_POWER_OF_TWO(sum, FILTER_BITS);
+}
+
+// Reduce the madd partial sums of 8 output samples, 2 per register, to 8 rounded 16-bit values.
+static INLINE __m128i round_reduce_x8(const __m256i sum[4]) {
+    const __m256i h01 = _mm256_hadd_epi32(sum[0], sum[1]);
+    const __m256i h23 = _mm256_hadd_epi32(sum[2], sum[3]);
+    // [x0 x2 x4 x6 | x1 x3 x5 x7]
+    __m256i h = _mm256_hadd_epi32(h01, h23);
+    h         = _mm256_srai_epi32(
+        _mm256_add_epi32(h, _mm256_set1_epi32(1 << (FILTER_BITS - 1))), FILTER_BITS);
+    const __m128i lo = _mm256_castsi256_si128(h);
+    const __m128i hi = _mm256_extracti128_si256(h, 1);
+    return _mm_packs_epi32(_mm_unpacklo_epi32(lo, hi), _mm_unpackhi_epi32(lo, hi));
+}
+
+static INLINE __m256i load_filter_x2(const int16_t *f0, const int16_t *f1) {
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)f0)),
+        _mm_loadu_si128((const __m128i *)f1),
+        1);
+}
+
+static void resize_row_avx2(const uint8_t *const input, int in_length, uint8_t *output,
+                            int out_length, int32_t y, int32_t delta, const int16_t *filters) {
+    int32_t        first[8];
+    const int16_t *filter[8];
+    int            x = 0;
+
+    while (x < out_length) {
+        if (x + 8 <= out_length) {
+            for (int k = 0; k < 8; ++k) {
+                const int32_t yk = y + k * delta;
+                first[k]  = (yk >> RS_SCALE_SUBPEL_BITS) - SUBPEL_TAPS / 2 + 1;
+                filter[k] = &filters[((yk >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK) * SUBPEL_TAPS];
+            }
+            if (first[0] >= 0 && first[7] + SUBPEL_TAPS <= in_length) {
+                __m256i sum[4];
+                for (int p = 0; p < 4; ++p) {
+                    const __m128i a = _mm_loadl_epi64((const __m128i *)(input + first[2 * p]));
+                    const __m128i b = _mm_loadl_epi64((const __m128i *)(input + first[2 * p + 1]));
+                    sum[p]          = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm_unpacklo_epi64(a, b)),
+                                               load_filter_x2(filter[2 * p], filter[2 * p + 1]));
+                }
+                const __m128i res = round_reduce_x8(sum);
+                _mm_storel_epi64((__m128i *)(output + x), _mm_packus_epi16(res, res));
+                x += 8;
+                y += 8 * delta;
+                continue;
+            }
+        }
+        const int16_t *f = &filters[((y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK) * SUBPEL_TAPS];
+        output[x]        = clip_pixel(filter8_clamped(
+            input, in_length, (y >> RS_SCALE_SUBPEL_BITS) - SUBPEL_TAPS / 2 + 1, f));
+        x++;
+        y += delta;
+    }
+}
+
+static void highbd_resize_row_avx2(const uint16_t *const input, int in_length, uint16_t *output,
+                                   int out_length, int32_t y, int32_t delta,
+                                   const int16_t *filters, int bd) {
+    const __m128i  max = _mm_set1_epi16((1 << bd) - 1);
+    int32_t        first[8];
+    const int16_t *filter[8];
+    int            x = 0;
+
+    while (x < out_length) {
+        if (x + 8 <= out_length) {
+            for (int k = 0; k < 8; ++k) {
+                const int32_t yk = y + k * delta;
+                first[k]  = (yk >> RS_SCALE_SUBPEL_BITS) - SUBPEL_TAPS / 2 + 1;
+                filter[k] = &filters[((yk >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK) * SUBPEL_TAPS];
+            }
+            if (first[0] >= 0 && first[7] + SUBPEL_TAPS <= in_length) {
+                __m256i sum[4];
+                for (int p = 0; p < 4; ++p) {
+                    const __m128i a = _mm_loadu_si128((const __m128i *)(input + first[2 * p]));
+                    const __m128i b = _mm_loadu_si128((const __m128i *)(input + first[2 * p + 1]));
+                    sum[p] = _mm256_madd_epi16(
+                        _mm256_inserti128_si256(_mm256_castsi128_si256(a), b, 1),
+                        load_filter_x2(filter[2 * p], filter[2 * p + 1]));
+                }
+                const __m128i res = round_reduce_x8(sum);
+                _mm_storeu_si128((__m128i *)(output + x),
+                                 _mm_min_epi16(_mm_max_epi16(res, _mm_setzero_si128()), max));
+                x += 8;
+                y += 8 * delta;
+                continue;
+            }
+        }
+        const int16_t *f = &filters[((y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK) * SUBPEL_TAPS];
+        output[x]        = clip_pixel_highbd(
+            highbd_filter8_clamped(
+                input, in_length, (y >> RS_SCALE_SUBPEL_BITS) - SUBPEL_TAPS / 2 + 1, f),
+            bd);
+        x++;
+        y += delta;
+    }
+}
+
+static INLINE int32_t get_interp_delta(int in_length, int out_length) {
+    return (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) / out_length;
+}
+
+static INLINE int32_t get_interp_offset(int in_length, int out_length) {
+    return in_length > out_length
+        ? (((int32_t)(in_length - out_length) << (RS_SCALE_SUBPEL_BITS - 1)) + out_length / 2) /
+            out_length
+        : -(((int32_t)(out_length - in_length) << (RS_SCALE_SUBPEL_BITS - 1)) +
+            out_length / 2) /
+            out_length;
+}
+
+void svt_av1_down2_symeven_avx2(const uint8_t *const input, int length, uint8_t *output) {
+    resize_row_avx2(
+        input, length, output, (length + 1) >> 1, 0, 2 << RS_SCALE_SUBPEL_BITS, down2_symeven_filter);
+}
+
+void svt_av1_down2_symodd_avx2(const uint8_t *const input, int length, uint8_t *output) {
+    resize_row_avx2(input,
+                    length,
+                    output,
+                    (length + 1) >> 1,
+                    -(1 << RS_SCALE_SUBPEL_BITS),
+                    2 << RS_SCALE_SUBPEL_BITS,
+                    down2_symodd_filter);
+}
+
+void svt_av1_interpolate_core_avx2(const uint8_t *const input, int in_length, uint8_t *output,
+                                   int out_length, const int16_t *interp_filters,
+                                   int interp_taps) {
+    if (interp_taps != SUBPEL_TAPS) {
+        svt_av1_interpolate_core_c(
+            input, in_length, output, out_length, interp_filters, interp_taps);
+        return;
+    }
+    resize_row_avx2(input,
+                    in_length,
+                    output,
+                    out_length,
+                    get_interp_offset(in_length, out_length) + RS_SCALE_EXTRA_OFF,
+                    get_interp_delta(in_length, out_length),
+                    interp_filters);
+}
+
+void svt_av1_highbd_down2_symeven_avx2(const uint16_t *const input, int length, uint16_t *output,
+                                       int bd) {
+    highbd_resize_row_avx2(input,
+                           length,
+                           output,
+                           (length + 1) >> 1,
+                           0,
+                           2 << RS_SCALE_SUBPEL_BITS,
+                           down2_symeven_filter,
+                           bd);
+}
+
+void svt_av1_highbd_down2_symodd_avx2(const uint16_t *const input, int length, uint16_t *output,
+                                      int bd) {
+    highbd_resize_row_avx2(input,
+                           length,
+                           output,
+                           (length + 1) >> 1,
+                           -(1 << RS_SCALE_SUBPEL_BITS),
+                           2 << RS_SCALE_SUBPEL_BITS,
+                           down2_symodd_filter,
+                           bd);
+}
+
+void svt_av1_highbd_interpolate_core_avx2(const uint16_t *const input, int in_length,
+                                          uint16_t *output, int out_length, int bd,
+                                          const int16_t *interp_filters, int interp_taps) {
+    if (interp_taps != SUBPEL_TAPS) {
+        svt_av1_highbd_interpolate_core_c(
+            input, in_length, output, out_length, bd, interp_filters, interp_taps);
+        return;
+    }
+    highbd_resize_row_avx2(input,
+                           in_length,
+                           output,
+                           out_length,
+                           get_interp_offset(in_length, out_length) + RS_SCALE_EXTRA_OFF,
+                           get_interp_delta(in_length, out_length),
+                           interp_filters,
+                           bd);
+}
+
+// Filter coefficients k and k + 1 interleaved, to be used with _mm256_madd_epi16().
+static INLINE void load_vert_filter(const int16_t *filter, __m256i coeffs[SUBPEL_TAPS / 2]) {
+    for (int p = 0; p < SUBPEL_TAPS / 2; ++p)
+        coeffs[p] = _mm256_set1_epi32((int32_t)(((uint32_t)(uint16_t)filter[2 * p + 1] << 16) |
+                                                (uint16_t)filter[2 * p]));
+}
+
+// Filter 16 columns of 16-bit samples, returning them rounded as 16-bit values.
+static INLINE __m256i filter_vert_x16(const __m256i px[SUBPEL_TAPS],
+                                      const __m256i coeffs[SUBPEL_TAPS / 2]) {
+    __m256i sum_lo = _mm256_set1_epi32(1 << (FILTER_BITS - 1));
+    __m256i sum_hi = sum_lo;
+    for (int p = 0; p < SUBPEL_TAPS / 2; ++p) {
+        sum_lo = _mm256_add_epi32(
+            sum_lo,
+            _mm256_madd_epi16(_mm256_unpacklo_epi16(px[2 * p], px[2 * p + 1]), coeffs[p]));
+        sum_hi = _mm256_add_epi32(
+            sum_hi,
+            _mm256_madd_epi16(_mm256_unpackhi_epi16(px[2 * p], px[2 * p + 1]), coeffs[p]));
+    }
+    return _mm256_packs_epi32(_mm256_srai_epi32(sum_lo, FILTER_BITS),
+                              _mm256_srai_epi32(sum_hi, FILTER_BITS));
+}
+
+void svt_av1_resize_vert_row_avx2(const uint8_t *const input, int in_stride, int in_length,
+                                  int first_row, const int16_t *filter, uint8_t *output,
+                                  int width) {
+    const uint8_t *rows[SUBPEL_TAPS];
+    __m256i        coeffs[SUBPEL_TAPS / 2];
+    __m256i        px[SUBPEL_TAPS];
+    int            x = 0;
+
+    for (int k = 0; k < SUBPEL_TAPS; ++k)
+        rows[k] = input + AOMMAX(AOMMIN(first_row + k, in_length - 1), 0) * in_stride;
+    load_vert_filter(filter, coeffs);
+
+    for (; x + 16 <= width; x += 16) {
+        for (int k = 0; k < SUBPEL_TAPS; ++k)
+            px[k] = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(rows[k] + x)));
+        const __m256i res = filter_vert_x16(px, coeffs);
+        _mm_storeu_si128((__m128i *)(output + x),
+                         _mm256_castsi256_si128(
+                             _mm256_permute4x64_epi64(_mm256_packus_epi16(res, res), 0xD8)));
+    }
+    for (; x < width; ++x) {
+        int32_t sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+    }
+}
+
+void svt_av1_highbd_resize_vert_row_avx2(const uint16_t *const input, int in_stride,
+                                         int in_length, int first_row, const int16_t *filter,
+                                         uint16_t *output, int width, int bd) {
+    const uint16_t *rows[SUBPEL_TAPS];
+    const __m256i   max = _mm256_set1_epi16((1 << bd) - 1);
+    __m256i         coeffs[SUBPEL_TAPS / 2];
+    __m256i         px[SUBPEL_TAPS];
+    int             x = 0;
+
+    for (int k = 0; k < SUBPEL_TAPS; ++k)
+        rows[k] = input + AOMMAX(AOMMIN(first_row + k, in_length - 1), 0) * in_stride;
+    load_vert_filter(filter, coeffs);
+
+    for (; x + 16 <= width; x += 16) {
+        for (int k = 0; k < SUBPEL_TAPS; ++k)
+            px[k] = _mm256_loadu_si256((const __m256i *)(rows[k] + x));
+        const __m256i res = filter_vert_x16(px, coeffs);
+        _mm256_storeu_si256((__m256i *)(output + x),
+                            _mm256_min_epi16(_mm256_max_epi16(res, _mm256_setzero_si256()), max));
+    }
+    for (; x < width; ++x) {
+        int32_t sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
+    }
+}
@@ -12,6 +12,7 @@
 #include "EncodeTxbRef_C.h"
 #include "EbCommonUtils.h"
 #include "EbCoefficients.h"
+#include "EbBitstreamUnit.h"
 /*
 const int8_t av1_nz_map_ctx_offset_4x4[16] = {
     0,
@@ -428,3 +429,97 @@ void svt_av1_get_nz_map_contexts_c(const uint8_t* const levels, const int16_t* c
             get_nz_map_ctx(levels, pos, bwl, height, i, i == eob - 1, tx_size, tx_class);
     }
 }
+
+static INLINE int32_t get_golomb_cost(int32_t abs_qc) {
+    if (abs_qc >= 1 + NUM_BASE_LEVELS + COEFF_BASE_RANGE) {
+        const int32_t r      = abs_qc - COEFF_BASE_RANGE - NUM_BASE_LEVELS;
+        const int32_t length = get_msb(r) + 1;
+        return (2 * length - 1) << AV1_PROB_COST_SHIFT;
+    }
+    return 0;
+}
+
+static AOM_FORCE_INLINE int32_t cost_coeffs_txb_inner(
+    const uint8_t *const levels, const int16_t *const scan, const TranLow *const qcoeff,
+    const int8_t *const coeff_contexts, const int32_t (*base_cost)[8],
+    const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob,
+    const int32_t bwl, const TxClass tx_class) {
+    const int32_t cost_literal = 1 << AV1_PROB_COST_SHIFT;
+    int32_t       cost         = 0;
+    for (int32_t c = eob - 2; c >= 1; --c) {
+        const int32_t pos   = scan[c];
+        const int32_t level = abs(qcoeff[pos]);
+        if (level > NUM_BASE_LEVELS) {
+            const int32_t ctx        = get_br_ctx(levels, pos, bwl, tx_class);
+            const int32_t base_range = level - 1 - NUM_BASE_LEVELS;
+
+            if (base_range < COEFF_BASE_RANGE) {
+                cost += cost_literal + lps_cost[ctx][base_range] +
+                        base_cost[coeff_contexts[pos]][3];
+            } else {
+                cost += get_golomb_cost(level) + cost_literal + lps_cost[ctx][COEFF_BASE_RANGE] +
+                        base_cost[coeff_contexts[pos]][3];
+            }
+        } else if (level) {
+            cost += cost_literal + base_cost[coeff_contexts[pos]][level];
+        } else {
+            cost += base_cost[coeff_contexts[pos]][0];
+        }
+    }
+    return cost;
+}
+
+// Rate of the coefficients at scan indices 1 to eob - 2, i.e. all but the DC and the last one,
+// which take the dc sign and the eob contexts.
+int32_t svt_av1_cost_coeffs_txb_inner_c(
+    const uint8_t *const levels, const int16_t *const scan, const TranLow *const qcoeff,
+    const int8_t *const coeff_contexts, const int32_t (*base_cost)[8],
+    const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob,
+    const int32_t bwl, const TxClass tx_class) {
+#define COST_COEFFS_TXB_INNER_CASE(tx_class_literal) \
+    case tx_class_literal:                           \
+        return cost_coeffs_txb_inner(levels,         \
+                                     scan,           \
+                                     qcoeff,         \
+                                     coeff_contexts, \
+                                     base_cost,      \
+                                     lps_cost,       \
+                                     eob,            \
+                                     bwl,            \
+                                     tx_class_literal);
+    switch (tx_class) {
+        COST_COEFFS_TXB_INNER_CASE(TX_CLASS_2D);
+        COST_COEFFS_TXB_INNER_CASE(TX_CLASS_HORIZ);
+        COST_COEFFS_TXB_INNER_CASE(TX_CLASS_VERT);
+#undef COST_COEFFS_TXB_INNER_CASE
+    default: assert(0);
+    }
+    return 0;
+}
+
+/*
+ * Reduce the number of non-zero quantized coefficients before getting to the main/complex RDOQ stage
+ * (it performs an early check of whether to zero out each of the non-zero quantized coefficients,
+ * and updates the quantized coeffs if it is determined it can be zeroed out).
+ */
+void svt_av1_update_coeff_eob_fast_c(uint16_t *eob, int shift, const int16_t *dequant_ptr,
+                                     const int16_t *scan, const TranLow *coeff_ptr,
+                                     TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr) {
+    int eob_out = *eob;
+    int zbin[2] = {dequant_ptr[0] + ROUND_POWER_OF_TWO(dequant_ptr[0] * 70, 7),
+                   dequant_ptr[1] + ROUND_POWER_OF_TWO(dequant_ptr[1] * 70, 7)};
+    for (int i = *eob - 1; i >= 0; i--) {
+        const int rc         = scan[i];
+        const int qcoeff     = qcoeff_ptr[rc];
+        const int coeff      = coeff_ptr[rc];
+        const int coeff_sign = -(coeff < 0);
+        int64_t   abs_coeff  = (coeff ^ coeff_sign) - coeff_sign;
+        if (((abs_coeff << (1 + shift)) < zbin[rc != 0]) || (qcoeff == 0)) {
+            eob_out--;
+            qcoeff_ptr[rc]  = 0;
+            dqcoeff_ptr[rc] = 0;
+        } else
+            break;
+    }
+    *eob = eob_out;
+}
@@ -22,6 +22,14 @@ extern "C" {
 void svt_av1_get_nz_map_contexts_c(const uint8_t* const levels, const int16_t* const scan,
                                    const uint16_t eob, const TxSize tx_size, const TxClass tx_class,
                                    int8_t* const coeff_contexts);
+int32_t svt_av1_cost_coeffs_txb_inner_c(
+    const uint8_t* const levels, const int16_t* const scan, const TranLow* const qcoeff,
+    const int8_t* const coeff_contexts, const int32_t (*base_cost)[8],
+    const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob,
+    const int32_t bwl, const TxClass tx_class);
+void svt_av1_update_coeff_eob_fast_c(uint16_t* eob, int shift, const int16_t* dequant_ptr,
+                                     const int16_t* scan, const TranLow* coeff_ptr,
+                                     TranLow* qcoeff_ptr, TranLow* dqcoeff_ptr);
 #ifdef __cplusplus
 } // extern "C"
 #endif
@@ -322,8 +322,6 @@ typedef struct IntraBcContext {
     // [two buffers used ping-pong]
     uint32_t *     hash_value_buffer[2][2];
     uint8_t        is_exhaustive_allowed;
-    CRC_CALCULATOR crc_calculator1;
-    CRC_CALCULATOR crc_calculator2;
 } IntraBcContext;
 
 typedef struct BlkStruct {
@@ -427,6 +425,16 @@ typedef struct TplStats {
     MV mv;
     uint64_t ref_frame_poc;
 } TplStats;
+// Source-referenced part of the TPL dispenser (inter search against the PA references),
+// kept per 16x16 so it can be produced in parallel and consumed by the serial recon pass
+typedef struct TplSrcStats {
+    int64_t  srcrf_dist;
+    int64_t  srcrf_rate;
+    MV       mv;
+    uint64_t ref_frame_poc;
+    int32_t  best_rf_idx;
+    uint8_t  best_mode;
+} TplSrcStats;
 typedef struct SuperBlock {
     EbDctor                   dctor;
     struct PictureControlSet *pcs_ptr;
@@ -24,7 +24,12 @@
 #include "EbRateDistortionCost.h"
 #include "EbPictureDecisionProcess.h"
 #include "firstpass.h"
+#include "EbModeDecisionConfigurationProcess.h"
+#include "EbTime.h"
 
+#define MD_BUDGET_LEVEL_MAX 4 // Highest MD effort reduction level of the MD time budget control
+#define MD_BUDGET_HIGH_TH 105 // Raise the level when the projected frame time is above 105% of the budget
+#define MD_BUDGET_LOW_TH 80 // Lower the level when the projected frame time is below 80% of the budget
 #define FC_SKIP_TX_SR_TH025 125 // Fast cost skip tx search threshold.
 #define FC_SKIP_TX_SR_TH010 110 // Fast cost skip tx search threshold.
 void svt_av1_cdef_search(EncDecContext *context_ptr, SequenceControlSet *scs_ptr,
@@ -2159,6 +2164,30 @@ void set_txs_cycle_reduction_controls(ModeDecisionContext *mdctxt, uint8_t txs_c
         break;
     }
 }
+/*
+ * Reduce the MD effort of the SB on top of the PD_PASS_2 signal derivation, each MD time budget
+ * level adding to the reductions of the previous one.
+ */
+static void set_md_budget_controls(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                                   uint8_t md_budget_level) {
+    if (md_budget_level >= 1) {
+        context_ptr->nic_scaling_level = MAX(context_ptr->nic_scaling_level, 6);
+        if (pcs_ptr->slice_type != I_SLICE)
+            set_txt_cycle_reduction_controls(context_ptr, 5);
+    }
+    if (md_budget_level >= 2) {
+        context_ptr->nic_scaling_level = MAX(context_ptr->nic_scaling_level, 8);
+    }
+    if (md_budget_level >= 3) {
+        context_ptr->md_disallow_nsq = 1;
+        if (pcs_ptr->slice_type != I_SLICE)
+            context_ptr->tx_search_level = MIN(context_ptr->tx_search_level, TX_SEARCH_DCT_TX_TYPES);
+    }
+    if (md_budget_level >= 4) {
+        context_ptr->nic_scaling_level = 9;
+        context_ptr->tx_search_level   = MIN(context_ptr->tx_search_level, TX_SEARCH_DCT_TX_TYPES);
+    }
+}
 /******************************************************
 * Derive EncDec Settings for OQ
 Input   : encoder mode and pd pass
@@ -2762,6 +2791,10 @@ EbErrorType signal_derivation_enc_dec_kernel_oq(
             context_ptr->block_based_depth_refinement_level = 1;
         }
     }
+    // Prune the parent and sub depths of the predicted depth by cost when the EncDec time is
+    // over the MD time budget
+    if (context_ptr->md_budget_level >= 2 && pcs_ptr->slice_type != I_SLICE)
+        context_ptr->block_based_depth_refinement_level = 1;
     set_block_based_depth_refinement_controls(context_ptr, context_ptr->block_based_depth_refinement_level);
     if (pd_pass == PD_PASS_0)
         context_ptr->md_sq_mv_search_level = 0;
@@ -2827,6 +2860,10 @@ EbErrorType signal_derivation_enc_dec_kernel_oq(
             context_ptr->md_subpel_pme_level = 2;
 
     md_subpel_pme_controls(context_ptr, context_ptr->md_subpel_pme_level);
+
+    // Set md_subpel_cache_level @ MD
+    // On in M2 only, the one preset where the cached planes were repeatably faster
+    context_ptr->md_subpel_cache_level = enc_mode == ENC_M2 ? 1 : 0;
     // Set max_ref_count @ MD
     if (pd_pass == PD_PASS_0)
         context_ptr->md_max_ref_count = 4;
@@ -2889,6 +2926,9 @@ EbErrorType signal_derivation_enc_dec_kernel_oq(
         context_ptr->mds3_intra_prune_th = (uint16_t)~0;
     else
         context_ptr->mds3_intra_prune_th = 30;
+    // Reduce the MD effort when the EncDec time is over the budget
+    if (pd_pass == PD_PASS_2 && context_ptr->md_budget_level)
+        set_md_budget_controls(pcs_ptr, context_ptr, context_ptr->md_budget_level);
 
     return return_error;
 }
@@ -2900,9 +2940,12 @@ Output  : EncDec Kernel signal(s)
 EbErrorType first_pass_signal_derivation_enc_dec_kernel(
     PictureControlSet *pcs_ptr,
     ModeDecisionContext *context_ptr);
-void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
-                           uint32_t src_idx, uint32_t dst_idx, uint32_t blk_mds, uint32_t sb_org_x,
+void save_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                           uint8_t *cache, uint32_t blk_mds, uint32_t sb_org_x,
                            uint32_t sb_org_y);
+void restore_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                              uint8_t *cache, uint32_t blk_mds, uint32_t sb_org_x,
+                              uint32_t sb_org_y);
 
 static void set_parent_to_be_considered(MdcSbData *results_ptr, uint32_t blk_index, int32_t sb_size,
                                         int8_t pred_depth,
@@ -3477,6 +3520,46 @@ void generate_txt_prob(PictureControlSet * pcs_ptr,ModeDecisionContext *context_
         }
     }
 }
+/*
+ * Start the EncDec wall time of the picture at its first segment, and return the MD time budget
+ * level the SBs of the segment are coded at.
+ */
+static uint8_t start_md_budget_segment(PictureControlSet *pcs_ptr) {
+    svt_block_on_mutex(pcs_ptr->intra_mutex);
+    if (!pcs_ptr->enc_dec_started) {
+        svt_av1_get_time(&pcs_ptr->enc_dec_start_seconds, &pcs_ptr->enc_dec_start_useconds);
+        pcs_ptr->enc_dec_started = EB_TRUE;
+    }
+    const uint8_t md_budget_level = pcs_ptr->md_budget_level;
+    svt_release_mutex(pcs_ptr->intra_mutex);
+    return md_budget_level;
+}
+/*
+ * Project the EncDec wall time of the picture from the time elapsed since its first segment
+ * started and the SBs coded so far, and move the MD time budget level up (down) when the
+ * projection is above (well below) the budget.
+ */
+static void update_md_budget_level(SequenceControlSet *scs_ptr, PictureControlSet *pcs_ptr,
+                                   uint32_t sb_count) {
+    const uint64_t budget_us = scs_ptr->static_config.md_time_budget_us;
+    uint64_t       end_seconds, end_useconds;
+    svt_block_on_mutex(pcs_ptr->intra_mutex);
+    svt_av1_get_time(&end_seconds, &end_useconds);
+    const uint64_t elapsed_us =
+        (uint64_t)(svt_av1_compute_overall_elapsed_time_ms(pcs_ptr->enc_dec_start_seconds,
+                                                           pcs_ptr->enc_dec_start_useconds,
+                                                           end_seconds,
+                                                           end_useconds) *
+                   1000);
+    pcs_ptr->enc_dec_timed_sb_count += sb_count;
+    const uint64_t projected_us = elapsed_us * pcs_ptr->sb_total_count_pix /
+        pcs_ptr->enc_dec_timed_sb_count;
+    if (projected_us * 100 > budget_us * MD_BUDGET_HIGH_TH)
+        pcs_ptr->md_budget_level = MIN(pcs_ptr->md_budget_level + 1, MD_BUDGET_LEVEL_MAX);
+    else if (projected_us * 100 < budget_us * MD_BUDGET_LOW_TH && pcs_ptr->md_budget_level)
+        pcs_ptr->md_budget_level--;
+    svt_release_mutex(pcs_ptr->intra_mutex);
+}
 const uint32_t sb_class_th[NUMBER_OF_SB_CLASS] = { 0,85,75,65,60,55,50,45,40,
                                                    35,30,25,20,17,14,10,6,3,0 };
 static uint8_t determine_sb_class(
@@ -3721,6 +3804,11 @@ static void perform_pred_depth_refinement(SequenceControlSet *scs_ptr, PictureCo
                             }
                     }
 
+                    // Only keep the predicted depth at the highest MD time budget level
+                    if (context_ptr->md_budget_level >= MD_BUDGET_LEVEL_MAX) {
+                        s_depth = 0;
+                        e_depth = 0;
+                    }
                     // Check that the start and end depth are in allowed range, given other features
                     // which restrict allowable depths
                     if (context_ptr->disallow_4x4) {
@@ -3859,6 +3947,14 @@ static void build_starting_cand_block_array(SequenceControlSet *scs_ptr, Picture
         }
     }
 }
+/*
+ * Report a mode decision failure (the MD buffers created on first use could not be allocated)
+ * to the application, which stops the encoder. The kernel then exits without coding the SB.
+ */
+static void report_mode_decision_error(SequenceControlSet *scs_ptr) {
+    EbCallback *app_callback_ptr = scs_ptr->encode_context_ptr->app_callback_ptr;
+    app_callback_ptr->error_handler(app_callback_ptr->handle, EB_ENC_CL_ERROR3);
+}
 
 /* EncDec (Encode Decode) Kernel */
 /*********************************************************************************
@@ -3939,10 +4035,24 @@ void *mode_decision_kernel(void *input_ptr) {
         EncDecTasks *    enc_dec_tasks_ptr    = (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
         PictureControlSet * pcs_ptr           = (PictureControlSet *)enc_dec_tasks_ptr->pcs_wrapper_ptr->object_ptr;
         SequenceControlSet *scs_ptr           = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+        if (enc_dec_tasks_ptr->input_type == ENCDEC_TASKS_HASH_INPUT) {
+            // Segment of the IntraBC hash table build, MDC waits for the whole stage
+            svt_av1_hash_table_build_segment(pcs_ptr,
+                                             pcs_ptr->hash_stage,
+                                             enc_dec_tasks_ptr->hash_segment_index,
+                                             pcs_ptr->hash_segments_total_count);
+            svt_block_on_mutex(pcs_ptr->hash_segments_mutex);
+            if (++pcs_ptr->hash_segments_done_count == pcs_ptr->hash_segments_total_count)
+                svt_post_semaphore(pcs_ptr->hash_segments_done_semaphore);
+            svt_release_mutex(pcs_ptr->hash_segments_mutex);
+            svt_release_object(enc_dec_tasks_wrapper_ptr);
+            continue;
+        }
         context_ptr->tile_group_index = enc_dec_tasks_ptr->tile_group_index;
         context_ptr->coded_sb_count   = 0;
         segments_ptr = pcs_ptr->enc_dec_segment_ctrl[context_ptr->tile_group_index];
         EbBool last_sb_flag           = EB_FALSE;
+        uint8_t  segment_md_budget_level = 0;
         // SB Constants
         uint8_t sb_sz      = (uint8_t)scs_ptr->sb_size_pix;
         uint8_t sb_size_log2 = (uint8_t)svt_log2f(sb_sz);
@@ -3978,6 +4088,8 @@ void *mode_decision_kernel(void *input_ptr) {
             segment_band_size = (segments_ptr->sb_band_count * (segment_band_index + 1) +
                                  segments_ptr->segment_band_count - 1) /
                                 segments_ptr->segment_band_count;
+            if (scs_ptr->static_config.md_time_budget_us)
+                segment_md_budget_level = start_md_budget_segment(pcs_ptr);
 
             // Reset Coding Loop State
             reset_mode_decision(scs_ptr,
@@ -4027,6 +4139,10 @@ void *mode_decision_kernel(void *input_ptr) {
                     context_ptr->md_context->tile_index = sb_ptr->tile_info.tile_rs_index;
                     context_ptr->md_context->sb_origin_x = sb_origin_x;
                     context_ptr->md_context->sb_origin_y = sb_origin_y;
+                    // The interpolated reference planes of the previous SB are not reused
+                    if (context_ptr->md_context->subpel_plane_cache)
+                        for (int i = 0; i < MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH; i++)
+                            context_ptr->md_context->subpel_plane_cache[i].ref = NULL;
 
                     sb_row_index_start =
                         (x_sb_index + 1 == tile_group_width_in_sb && sb_row_index_count == 0)
@@ -4079,17 +4195,29 @@ void *mode_decision_kernel(void *input_ptr) {
                                     AVG_CDF_WEIGHT_TOP);
                             }
                         }
+                        // Update the rates of the CDFs that changed since the previous SB
+                        // of the segment (all of them at its first SB)
+                        const FRAME_CONTEXT *prev_fc = context_ptr->md_context->rate_est_fc_valid
+                            ? context_ptr->md_context->rate_est_fc
+                            : NULL;
                         // Initial Rate Estimation of the syntax elements
                         av1_estimate_syntax_rate(&context_ptr->md_context->rate_est_table,
                             pcs_ptr->slice_type == I_SLICE,
-                            &pcs_ptr->ec_ctx_array[sb_index]);
+                            &pcs_ptr->ec_ctx_array[sb_index],
+                            prev_fc);
                         // Initial Rate Estimation of the Motion vectors
                         av1_estimate_mv_rate(pcs_ptr,
                             &context_ptr->md_context->rate_est_table,
-                            &pcs_ptr->ec_ctx_array[sb_index]);
+                            &pcs_ptr->ec_ctx_array[sb_index],
+                            prev_fc);
 
                         av1_estimate_coefficients_rate(&context_ptr->md_context->rate_est_table,
-                            &pcs_ptr->ec_ctx_array[sb_index]);
+                            &pcs_ptr->ec_ctx_array[sb_index],
+                            prev_fc);
+                        memcpy(context_ptr->md_context->rate_est_fc,
+                               &pcs_ptr->ec_ctx_array[sb_index],
+                               sizeof(FRAME_CONTEXT));
+                        context_ptr->md_context->rate_est_fc_valid = EB_TRUE;
 
                         //let the candidate point to the new rate table.
                         uint32_t cand_index;
@@ -4100,6 +4228,9 @@ void *mode_decision_kernel(void *input_ptr) {
                         context_ptr->md_context->md_rate_estimation_ptr =
                             &context_ptr->md_context->rate_est_table;
                     }
+                    // MD time budget level of the SB, applied from the first PD pass
+                    context_ptr->md_context->md_budget_level =
+                        use_output_stat(scs_ptr) ? 0 : segment_md_budget_level;
                     // Configure the SB
                     mode_decision_configure_sb(
                         context_ptr->md_context, pcs_ptr, (uint8_t)sb_ptr->qindex);
@@ -4111,10 +4242,9 @@ void *mode_decision_kernel(void *input_ptr) {
                          pcs_ptr->parent_pcs_ptr->multi_pass_pd_level == MULTI_PASS_PD_LEVEL_4)
                         ) {
                         // Save a clean copy of the neighbor arrays
-                        copy_neighbour_arrays(pcs_ptr,
+                        save_neighbour_arrays(pcs_ptr,
                                               context_ptr->md_context,
-                                              MD_NEIGHBOR_ARRAY_INDEX,
-                                              MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
+                                              context_ptr->md_context->pd_neighbor_cache,
                                               0,
                                               sb_origin_x,
                                               sb_origin_y);
@@ -4133,16 +4263,19 @@ void *mode_decision_kernel(void *input_ptr) {
 
                         // PD0 MD Tool(s) : ME_MV(s) as INTER candidate(s), DC as INTRA candidate, luma only, Frequency domain SSE,
                         // no fast rate (no MVP table generation), MDS0 then MDS3, reduced NIC(s), 1 ref per list,..
-                        mode_decision_sb(scs_ptr,
-                                         pcs_ptr,
-                                         mdc_ptr,
-                                         sb_ptr,
-                                         sb_origin_x,
-                                         sb_origin_y,
-                                         sb_index,
-                                         context_ptr->md_context);
-                            context_ptr->md_context->sb_class = determine_sb_class(
-                                scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
+                        if (mode_decision_sb(scs_ptr,
+                                             pcs_ptr,
+                                             mdc_ptr,
+                                             sb_ptr,
+                                             sb_origin_x,
+                                             sb_origin_y,
+                                             sb_index,
+                                             context_ptr->md_context) != EB_ErrorNone) {
+                            report_mode_decision_error(scs_ptr);
+                            return NULL;
+                        }
+                        context_ptr->md_context->sb_class = determine_sb_class(
+                            scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
 
                         // Perform Pred_0 depth refinement - add depth(s) to be considered in the next stage(s)
                         perform_pred_depth_refinement(
@@ -4150,13 +4283,12 @@ void *mode_decision_kernel(void *input_ptr) {
 
                         // Re-build mdc_blk_ptr for the 2nd PD Pass [PD_PASS_1]
                         // Reset neighnor information to current SB @ position (0,0)
-                        copy_neighbour_arrays(pcs_ptr,
-                                              context_ptr->md_context,
-                                              MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                              MD_NEIGHBOR_ARRAY_INDEX,
-                                              0,
-                                              sb_origin_x,
-                                              sb_origin_y);
+                        restore_neighbour_arrays(pcs_ptr,
+                                                 context_ptr->md_context,
+                                                 context_ptr->md_context->pd_neighbor_cache,
+                                                 0,
+                                                 sb_origin_x,
+                                                 sb_origin_y);
 
                         if (pcs_ptr->parent_pcs_ptr->multi_pass_pd_level == MULTI_PASS_PD_LEVEL_1 ||
                             pcs_ptr->parent_pcs_ptr->multi_pass_pd_level == MULTI_PASS_PD_LEVEL_2 ||
@@ -4176,26 +4308,28 @@ void *mode_decision_kernel(void *input_ptr) {
                             // Output: md_blk_arr_nsq reduced set of block(s)
 
                             // PD1 MD Tool(s): PME,..
-                            mode_decision_sb(scs_ptr,
-                                             pcs_ptr,
-                                             mdc_ptr,
-                                             sb_ptr,
-                                             sb_origin_x,
-                                             sb_origin_y,
-                                             sb_index,
-                                             context_ptr->md_context);
+                            if (mode_decision_sb(scs_ptr,
+                                                 pcs_ptr,
+                                                 mdc_ptr,
+                                                 sb_ptr,
+                                                 sb_origin_x,
+                                                 sb_origin_y,
+                                                 sb_index,
+                                                 context_ptr->md_context) != EB_ErrorNone) {
+                                report_mode_decision_error(scs_ptr);
+                                return NULL;
+                            }
 
                             // Perform Pred_1 depth refinement - add depth(s) to be considered in the next stage(s)
                             perform_pred_depth_refinement(
                                 scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
                             // Reset neighnor information to current SB @ position (0,0)
-                            copy_neighbour_arrays(pcs_ptr,
-                                                  context_ptr->md_context,
-                                                  MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX,
-                                                  MD_NEIGHBOR_ARRAY_INDEX,
-                                                  0,
-                                                  sb_origin_x,
-                                                  sb_origin_y);
+                            restore_neighbour_arrays(pcs_ptr,
+                                                     context_ptr->md_context,
+                                                     context_ptr->md_context->pd_neighbor_cache,
+                                                     0,
+                                                     sb_origin_x,
+                                                     sb_origin_y);
                         }
                     }
                     // [PD_PASS_2] Signal(s) derivation
@@ -4217,14 +4351,17 @@ void *mode_decision_kernel(void *input_ptr) {
                     // Output: md_blk_arr_nsq reduced set of block(s)
 
                     // PD2 MD Tool(s): default MD Tool(s)
-                    mode_decision_sb(scs_ptr,
-                                     pcs_ptr,
-                                     mdc_ptr,
-                                     sb_ptr,
-                                     sb_origin_x,
-                                     sb_origin_y,
-                                     sb_index,
-                                     context_ptr->md_context);
+                    if (mode_decision_sb(scs_ptr,
+                                         pcs_ptr,
+                                         mdc_ptr,
+                                         sb_ptr,
+                                         sb_origin_x,
+                                         sb_origin_y,
+                                         sb_index,
+                                         context_ptr->md_context) != EB_ErrorNone) {
+                        report_mode_decision_error(scs_ptr);
+                        return NULL;
+                    }
                     generate_statistics_nsq(scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
                     generate_statistics_depth(scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
                     generate_statistics_txt(scs_ptr, pcs_ptr, context_ptr->md_context, sb_index);
@@ -4254,6 +4391,8 @@ void *mode_decision_kernel(void *input_ptr) {
                 }
                 x_sb_start_index = (x_sb_start_index > 0) ? x_sb_start_index - 1 : 0;
             }
+            if (scs_ptr->static_config.md_time_budget_us)
+                update_md_budget_level(scs_ptr, pcs_ptr, sb_segment_count);
         }
 
         svt_block_on_mutex(pcs_ptr->intra_mutex);
@@ -4278,6 +4417,25 @@ void *mode_decision_kernel(void *input_ptr) {
         svt_release_mutex(pcs_ptr->intra_mutex);
 
         if (last_sb_flag) {
+            // Hand the MD time budget level over to the next pictures, unless a picture
+            // later in decode order already did
+            if (scs_ptr->static_config.md_time_budget_us) {
+                EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+                svt_block_on_mutex(encode_context_ptr->md_budget_mutex);
+                if (encode_context_ptr->md_budget_decode_order <=
+                    pcs_ptr->parent_pcs_ptr->decode_order) {
+                    encode_context_ptr->md_budget_level        = pcs_ptr->md_budget_level;
+                    encode_context_ptr->md_budget_decode_order = pcs_ptr->parent_pcs_ptr->decode_order;
+                }
+                svt_release_mutex(encode_context_ptr->md_budget_mutex);
+            }
+            // Give the IntraBC hash table back for the update of the next pictures
+            if (pcs_ptr->parent_pcs_ptr->frm_hdr.allow_intrabc) {
+                svt_block_on_mutex(scs_ptr->encode_context_ptr->hash_table_mutex);
+                svt_av1_hash_table_take_latest(&scs_ptr->encode_context_ptr->hash_table_latest,
+                                               &pcs_ptr->hash_table);
+                svt_release_mutex(scs_ptr->encode_context_ptr->hash_table_mutex);
+            }
             // Copy film grain data from parent picture set to the reference object for further reference
             if (scs_ptr->seq_header.film_grain_params_present) {
                 if (pcs_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE &&
@@ -21,6 +21,7 @@ extern "C" {
 #define ENCDEC_TASKS_MDC_INPUT 0
 #define ENCDEC_TASKS_ENCDEC_INPUT 1
 #define ENCDEC_TASKS_CONTINUE 2
+#define ENCDEC_TASKS_HASH_INPUT 3
 
 /**************************************
      * Process Results
@@ -31,6 +32,7 @@ typedef struct EncDecTasks {
     uint32_t         input_type;
     int16_t          enc_dec_segment_row;
     uint16_t         tile_group_index;
+    uint8_t          hash_segment_index; // segment of the hash table build stage
 } EncDecTasks;
 
 typedef struct EncDecTasksInitData {
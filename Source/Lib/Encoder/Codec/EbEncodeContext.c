@@ -56,6 +56,11 @@ static void encode_context_dctor(EbPtr p) {
     EB_DESTROY_MUTEX(obj->sc_buffer_mutex);
     EB_DESTROY_MUTEX(obj->shared_reference_mutex);
     EB_DESTROY_MUTEX(obj->stat_file_mutex);
+    EB_DESTROY_SEMAPHORE(obj->tpl_disp_done_semaphore);
+    EB_DESTROY_MUTEX(obj->tpl_disp_mutex);
+    EB_DESTROY_MUTEX(obj->hash_table_mutex);
+    EB_DESTROY_MUTEX(obj->md_budget_mutex);
+    svt_av1_hash_table_record_destroy(&obj->hash_table_latest);
     EB_DELETE(obj->prediction_structure_group_ptr);
     EB_DELETE_PTR_ARRAY(obj->picture_decision_reorder_queue,
                         PICTURE_DECISION_REORDER_QUEUE_MAX_DEPTH);
@@ -181,6 +186,10 @@ EbErrorType encode_context_ctor(EncodeContext* encode_context_ptr, EbPtr object_
     encode_context_ptr->max_coded_poc_selected_ref_qp = 32;
     EB_CREATE_MUTEX(encode_context_ptr->shared_reference_mutex);
     EB_CREATE_MUTEX(encode_context_ptr->stat_file_mutex);
+    EB_CREATE_SEMAPHORE(encode_context_ptr->tpl_disp_done_semaphore, 0, 1);
+    EB_CREATE_MUTEX(encode_context_ptr->tpl_disp_mutex);
+    EB_CREATE_MUTEX(encode_context_ptr->hash_table_mutex);
+    EB_CREATE_MUTEX(encode_context_ptr->md_budget_mutex);
     encode_context_ptr->num_lap_buffers = 0; //lap not supported for now
     int *num_lap_buffers = &encode_context_ptr->num_lap_buffers;
     create_stats_buffer(&encode_context_ptr->frame_stats_buffer,
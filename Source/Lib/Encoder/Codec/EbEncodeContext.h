@@ -29,6 +29,7 @@
 #include "EbObject.h"
 #include "encoder.h"
 #include "firstpass.h"
+#include "hash_motion.h"
 
 // *Note - the queues are small for testing purposes.  They should be increased when they are done.
 #define PRE_ASSIGNMENT_MAX_DEPTH 128 // should be large enough to hold an entire prediction period
@@ -165,6 +166,11 @@ typedef struct EncodeContext {
     int64_t   sc_frame_out;
     EbHandle  sc_buffer_mutex;
     EbEncMode enc_mode;
+    // MD time budget level of the last coded picture in decode order, starting level of the
+    // next ones
+    EbHandle md_budget_mutex;
+    uint8_t  md_budget_level;
+    uint64_t md_budget_decode_order;
 
     // Rate Control
     uint32_t previous_selected_ref_qp;
@@ -188,6 +194,15 @@ typedef struct EncodeContext {
     uint64_t poc_map_idx[MAX_TPL_LA_SW];
     EbByte  mc_flow_rec_picture_buffer[MAX_TPL_LA_SW];
     EbByte  mc_flow_rec_picture_buffer_saved;
+    // TPL dispenser segments in flight on the TPL dispenser threads
+    EbHandle tpl_disp_done_semaphore;
+    EbHandle tpl_disp_mutex;
+    uint32_t tpl_disp_seg_acc;
+    uint32_t tpl_disp_seg_total_count;
+    // IntraBC hash table of the latest picture done with it, the base of the update
+    // of the next picture
+    HashTableRecord hash_table_latest;
+    EbHandle        hash_table_mutex;
     FrameInfo      frame_info;
     TwoPassCfg     two_pass_cfg; // two pass datarate control
     RATE_CONTROL   rc;
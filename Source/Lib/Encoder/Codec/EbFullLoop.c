@@ -1162,33 +1162,6 @@ static const int plane_rd_mult[REF_TYPES][PLANE_TYPES] = {
     {16, 10},
 };
 
-/*
- * Reduce the number of non-zero quantized coefficients before getting to the main/complex RDOQ stage
- * (it performs an early check of whether to zero out each of the non-zero quantized coefficients,
- * and updates the quantized coeffs if it is determined it can be zeroed out).
- */
-static INLINE void update_coeff_eob_fast(uint16_t *eob, int shift, const int16_t *dequant_ptr,
-                                         const int16_t *scan, const TranLow *coeff_ptr,
-                                         TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr) {
-    int eob_out = *eob;
-    int zbin[2] = {dequant_ptr[0] + ROUND_POWER_OF_TWO(dequant_ptr[0] * 70, 7),
-                   dequant_ptr[1] + ROUND_POWER_OF_TWO(dequant_ptr[1] * 70, 7)};
-    for (int i = *eob - 1; i >= 0; i--) {
-        const int rc         = scan[i];
-        const int qcoeff     = qcoeff_ptr[rc];
-        const int coeff      = coeff_ptr[rc];
-        const int coeff_sign = -(coeff < 0);
-        int64_t   abs_coeff  = (coeff ^ coeff_sign) - coeff_sign;
-        if (((abs_coeff << (1 + shift)) < zbin[rc != 0]) || (qcoeff == 0)) {
-            eob_out--;
-            qcoeff_ptr[rc]  = 0;
-            dqcoeff_ptr[rc] = 0;
-        } else
-            break;
-    }
-    *eob = eob_out;
-}
-
 void svt_av1_optimize_b(ModeDecisionContext *md_context, int16_t txb_skip_context,
                         int16_t dc_sign_context, const TranLow *coeff_ptr, int32_t stride,
                         intptr_t n_coeffs, const MacroblockPlane *p, TranLow *qcoeff_ptr,
@@ -1221,7 +1194,8 @@ void svt_av1_optimize_b(ModeDecisionContext *md_context, int16_t txb_skip_contex
     const LvMapEobCost *txb_eob_costs =
         &md_context->md_rate_estimation_ptr->eob_frac_bits[eob_multi_size][plane_type];
     if (fast_mode) {
-        update_coeff_eob_fast(eob, shift, p->dequant_qtx, scan, coeff_ptr, qcoeff_ptr, dqcoeff_ptr);
+        svt_av1_update_coeff_eob_fast(
+            eob, shift, p->dequant_qtx, scan, coeff_ptr, qcoeff_ptr, dqcoeff_ptr);
         if (*eob == 0) return;
     }
     const int     rshift = sharpness + 2;
@@ -20,45 +20,15 @@
 #include "EbUtility.h"
 #include "global_motion.h"
 #include "corner_detect.h"
+#include "corner_match.h"
 // Normalized distortion-based thresholds
 #define GMV_ME_SAD_TH_0  0
 #define GMV_ME_SAD_TH_1  5
 #define GMV_ME_SAD_TH_2 10
-void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
-                              EbPictureBufferDesc *input_picture_ptr) {
-    // Get downsampled pictures with a downsampling factor of 2 in each dimension
-    EbPaReferenceObject *pa_reference_object;
-    EbPictureBufferDesc *quarter_ref_pic_ptr;
-    EbPictureBufferDesc *quarter_picture_ptr;
-    EbPictureBufferDesc *sixteenth_ref_pic_ptr;
-    EbPictureBufferDesc *sixteenth_picture_ptr;
-    SequenceControlSet * scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
-    pa_reference_object =
-            (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
-    quarter_picture_ptr =
-            (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-            ? (EbPictureBufferDesc *)pa_reference_object->quarter_filtered_picture_ptr
-            : (EbPictureBufferDesc *)pa_reference_object->quarter_decimated_picture_ptr;
-    sixteenth_picture_ptr =
-        (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-            ? (EbPictureBufferDesc *)pa_reference_object->sixteenth_filtered_picture_ptr
-            : (EbPictureBufferDesc *)pa_reference_object->sixteenth_decimated_picture_ptr;
-    uint32_t num_of_list_to_search =
-            (pcs_ptr->slice_type == P_SLICE) ? (uint32_t)REF_LIST_0 : (uint32_t)REF_LIST_1;
-    // Initilize global motion to be OFF for all references frames.
-    memset(pcs_ptr->is_global_motion, EB_FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
-    // Initilize wmtype to be IDENTITY for all references frames
-    // Ref List Loop
-    for (uint32_t list_index = REF_LIST_0; list_index <= num_of_list_to_search; ++list_index) {
-        uint32_t num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE
-            ? pcs_ptr->ref_list0_count_try
-            : list_index == REF_LIST_0 ? pcs_ptr->ref_list0_count_try
-            : pcs_ptr->ref_list1_count_try;
-        // Ref Picture Loop
-        for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic_to_search; ++ref_pic_index) {
-            pcs_ptr->global_motion_estimation[list_index][ref_pic_index].wmtype = IDENTITY;
-        }
-    }
+/* Derives the number of references searched per list by the GM segments from the ME
+ * distortion of the picture; called once the ME of all the SBs is done. */
+void global_motion_estimation_ref_count(PictureParentControlSet *pcs_ptr,
+                                        EbPictureBufferDesc *    input_picture_ptr) {
     // Derive total_me_sad
     uint32_t total_me_sad = 0;
     for (uint16_t sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
@@ -81,62 +51,89 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *conte
     else
         global_motion_estimation_level = 3;
 
-    if (global_motion_estimation_level)
-    for (uint32_t list_index = REF_LIST_0; list_index <= num_of_list_to_search; ++list_index) {
-        uint32_t num_of_ref_pic_to_search;
-            num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE
-                                          ? pcs_ptr->ref_list0_count_try
-                                          : list_index == REF_LIST_0 ? pcs_ptr->ref_list0_count_try
-                                          : pcs_ptr->ref_list1_count_try;
-        if (global_motion_estimation_level == 1)
-            num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 1);
-        else if (global_motion_estimation_level == 2)
-            num_of_ref_pic_to_search = MIN(num_of_ref_pic_to_search, 2);
-        // Ref Picture Loop
-        for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic_to_search;
-             ++ref_pic_index) {
-            EbPaReferenceObject *reference_object;
-            EbPictureBufferDesc *ref_picture_ptr;
-                reference_object =
-                        (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index]
-                                ->object_ptr;
-
-            // Set the source and the reference picture to be used by the global motion search
-            // based on the input search mode
-            if (pcs_ptr->gm_level == GM_DOWN16) {
-                sixteenth_ref_pic_ptr =
-                    (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-                    ? (EbPictureBufferDesc *)reference_object->sixteenth_filtered_picture_ptr
-                    : (EbPictureBufferDesc *)reference_object->sixteenth_decimated_picture_ptr;
-                ref_picture_ptr = sixteenth_ref_pic_ptr;
-                input_picture_ptr = sixteenth_picture_ptr;
+    uint8_t max_ref_count = global_motion_estimation_level == 0
+        ? 0
+        : global_motion_estimation_level == 1 ? 1
+        : global_motion_estimation_level == 2 ? 2 : REF_LIST_MAX_DEPTH;
+    pcs_ptr->gm_ref_count_search[REF_LIST_0] = MIN(pcs_ptr->ref_list0_count_try, max_ref_count);
+    pcs_ptr->gm_ref_count_search[REF_LIST_1] = pcs_ptr->slice_type == B_SLICE
+        ? MIN(pcs_ptr->ref_list1_count_try, max_ref_count)
+        : 0;
+}
 
-            }
-            else if (pcs_ptr->gm_level == GM_DOWN) {
-                quarter_ref_pic_ptr =
-                        (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-                        ? (EbPictureBufferDesc *)reference_object->quarter_filtered_picture_ptr
-                        : (EbPictureBufferDesc *)reference_object->quarter_decimated_picture_ptr;
-                ref_picture_ptr   = quarter_ref_pic_ptr;
-                input_picture_ptr = quarter_picture_ptr;
-            } else {
-                ref_picture_ptr = (EbPictureBufferDesc *)reference_object->input_padded_picture_ptr;
-            }
+/* Returns the corners of pic detected within width x height. The corners are kept in the
+ * cache of pa_ref_obj, so that they are detected once for all the pictures referencing it,
+ * unless the cache already holds the corners of an other search level, in which case they
+ * are detected into local_corners. */
+static int *get_picture_corners(EbPaReferenceObject *pa_ref_obj, EbPictureBufferDesc *pic,
+                                uint8_t level, int width, int height, int *local_corners,
+                                int *num_corners) {
+    unsigned char *buffer = pic->buffer_y + pic->origin_x + pic->origin_y * pic->stride_y;
+    svt_block_on_mutex(pa_ref_obj->gm_corners_mutex);
+    if (!pa_ref_obj->gm_corners_valid) {
+        pa_ref_obj->gm_num_corners    = svt_av1_fast_corner_detect(
+            buffer, width, height, pic->stride_y, pa_ref_obj->gm_corners, MAX_CORNERS);
+        pa_ref_obj->gm_corners_level  = level;
+        pa_ref_obj->gm_corners_width  = (uint16_t)width;
+        pa_ref_obj->gm_corners_height = (uint16_t)height;
+        pa_ref_obj->gm_corners_valid  = EB_TRUE;
+    }
+    const EbBool cache_hit = pa_ref_obj->gm_corners_level == level &&
+        pa_ref_obj->gm_corners_width == width && pa_ref_obj->gm_corners_height == height;
+    svt_release_mutex(pa_ref_obj->gm_corners_mutex);
 
-            compute_global_motion(input_picture_ptr,
-                                  ref_picture_ptr,
-                                  &pcs_ptr->global_motion_estimation[list_index][ref_pic_index],
-                                  pcs_ptr->frm_hdr.allow_high_precision_mv);
-        }
+    if (cache_hit) {
+        *num_corners = pa_ref_obj->gm_num_corners;
+        return pa_ref_obj->gm_corners;
+    }
+    *num_corners = svt_av1_fast_corner_detect(
+        buffer, width, height, pic->stride_y, local_corners, MAX_CORNERS);
+    return local_corners;
+}
 
-        if (context_ptr->gm_identiy_exit) {
-            if (list_index == 0) {
-                if (pcs_ptr->global_motion_estimation[0][0].wmtype == IDENTITY) {
-                    break;
-                }
-            }
+// Returns the picture of pa_ref_obj searched at the global motion level of pcs_ptr
+static EbPictureBufferDesc *get_gm_picture(SequenceControlSet *     scs_ptr,
+                                           PictureParentControlSet *pcs_ptr,
+                                           EbPaReferenceObject *    pa_ref_obj) {
+    const EbBool filtered = scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED;
+    if (pcs_ptr->gm_level == GM_DOWN16)
+        return filtered ? pa_ref_obj->sixteenth_filtered_picture_ptr
+                        : pa_ref_obj->sixteenth_decimated_picture_ptr;
+    if (pcs_ptr->gm_level == GM_DOWN)
+        return filtered ? pa_ref_obj->quarter_filtered_picture_ptr
+                        : pa_ref_obj->quarter_decimated_picture_ptr;
+    return pa_ref_obj->input_padded_picture_ptr;
+}
+
+/* Sets the global motion of the searched references once all the GM segments are done,
+ * applying the identity exit of list 1 as the search was done list after list. */
+static void global_motion_estimation_finalize(PictureParentControlSet *pcs_ptr,
+                                              MeContext *              context_ptr) {
+    uint32_t num_of_list_to_search =
+            (pcs_ptr->slice_type == P_SLICE) ? (uint32_t)REF_LIST_0 : (uint32_t)REF_LIST_1;
+    // Initilize global motion to be OFF for all references frames.
+    memset(pcs_ptr->is_global_motion, EB_FALSE, MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH);
+    // Initilize wmtype to be IDENTITY for all references frames
+    // Ref List Loop
+    for (uint32_t list_index = REF_LIST_0; list_index <= num_of_list_to_search; ++list_index) {
+        uint32_t num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE
+            ? pcs_ptr->ref_list0_count_try
+            : list_index == REF_LIST_0 ? pcs_ptr->ref_list0_count_try
+            : pcs_ptr->ref_list1_count_try;
+        // Ref Picture Loop
+        for (uint32_t ref_pic_index = 0; ref_pic_index < num_of_ref_pic_to_search; ++ref_pic_index) {
+            pcs_ptr->global_motion_estimation[list_index][ref_pic_index].wmtype = IDENTITY;
         }
     }
+    for (uint32_t list_index = REF_LIST_0; list_index <= num_of_list_to_search; ++list_index) {
+        if (list_index == REF_LIST_1 && context_ptr->gm_identiy_exit &&
+            pcs_ptr->global_motion_estimation[0][0].wmtype == IDENTITY)
+            break;
+        for (uint32_t ref_pic_index = 0; ref_pic_index < pcs_ptr->gm_ref_count_search[list_index];
+             ++ref_pic_index)
+            pcs_ptr->global_motion_estimation[list_index][ref_pic_index] =
+                pcs_ptr->gm_segment_params[list_index][ref_pic_index];
+    }
     for (uint32_t list_index = REF_LIST_0; list_index <= num_of_list_to_search; ++list_index) {
         uint32_t num_of_ref_pic_to_search = pcs_ptr->slice_type == P_SLICE
             ? pcs_ptr->ref_list0_count
@@ -155,13 +152,114 @@ void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *conte
     }
 }
 
-void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *ref_pic,
+/* Global motion segment: searches the references of the picture assigned to segment_index,
+ * the list 0 references being dealt round-robin to the gm_segments_total_count segments. The
+ * list 1 references are searched by the first segment after the first list 0 reference, and
+ * skipped when it exits on identity. The last segment to complete sets the global motion of
+ * the picture. */
+void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
+                              EbPictureBufferDesc *input_picture_ptr, uint32_t segment_index) {
+    SequenceControlSet * scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+    EbPaReferenceObject *pa_reference_object =
+            (EbPaReferenceObject *)pcs_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
+    // Get the source picture at the search level; the full resolution source is shared with
+    // the PA reference only when it was not denoised
+    EbPictureBufferDesc *frm_pic      = get_gm_picture(scs_ptr, pcs_ptr, pa_reference_object);
+    const EbBool         frm_cachable = pcs_ptr->gm_level != GM_FULL ||
+        scs_ptr->static_config.film_grain_denoise_strength == 0;
+    if (pcs_ptr->gm_level == GM_FULL) frm_pic = input_picture_ptr;
+
+    int  local_corners[2 * MAX_CORNERS];
+    int *frm_corners     = NULL;
+    int  num_frm_corners = 0;
+
+    for (uint32_t list_index = REF_LIST_0; list_index < MAX_NUM_OF_REF_PIC_LIST; ++list_index) {
+        if (list_index == REF_LIST_1) {
+            if (segment_index != 0) break;
+            if (context_ptr->gm_identiy_exit &&
+                (pcs_ptr->gm_ref_count_search[REF_LIST_0] == 0 ||
+                 pcs_ptr->gm_segment_params[REF_LIST_0][0].wmtype == IDENTITY))
+                break;
+        }
+        for (uint32_t ref_pic_index = 0; ref_pic_index < pcs_ptr->gm_ref_count_search[list_index];
+             ++ref_pic_index) {
+            if (list_index == REF_LIST_0 &&
+                ref_pic_index % pcs_ptr->gm_segments_total_count != segment_index)
+                continue;
+            if (frm_corners == NULL) {
+                if (frm_cachable)
+                    frm_corners = get_picture_corners(pa_reference_object,
+                                                      frm_pic,
+                                                      pcs_ptr->gm_level,
+                                                      frm_pic->width,
+                                                      frm_pic->height,
+                                                      local_corners,
+                                                      &num_frm_corners);
+                else {
+                    frm_corners     = local_corners;
+                    num_frm_corners = svt_av1_fast_corner_detect(
+                        frm_pic->buffer_y + frm_pic->origin_x +
+                            frm_pic->origin_y * frm_pic->stride_y,
+                        frm_pic->width,
+                        frm_pic->height,
+                        frm_pic->stride_y,
+                        local_corners,
+                        MAX_CORNERS);
+                }
+            }
+            EbPaReferenceObject *reference_object =
+                (EbPaReferenceObject *)pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index]
+                    ->object_ptr;
+            EbPictureBufferDesc *ref_pic = get_gm_picture(scs_ptr, pcs_ptr, reference_object);
+            // The reference corners are detected within the source area
+            int  ref_local_corners[2 * MAX_CORNERS];
+            int  num_ref_corners;
+            int *ref_corners = get_picture_corners(reference_object,
+                                                   ref_pic,
+                                                   pcs_ptr->gm_level,
+                                                   frm_pic->width,
+                                                   frm_pic->height,
+                                                   ref_local_corners,
+                                                   &num_ref_corners);
+
+            compute_global_motion(frm_pic,
+                                  frm_corners,
+                                  num_frm_corners,
+                                  ref_pic,
+                                  ref_corners,
+                                  num_ref_corners,
+                                  &pcs_ptr->gm_segment_params[list_index][ref_pic_index],
+                                  pcs_ptr->frm_hdr.allow_high_precision_mv);
+        }
+    }
+
+    svt_block_on_mutex(pcs_ptr->gm_segments_mutex);
+    const EbBool last_segment = ++pcs_ptr->gm_segments_done_count ==
+        pcs_ptr->gm_segments_total_count;
+    svt_release_mutex(pcs_ptr->gm_segments_mutex);
+    if (last_segment) global_motion_estimation_finalize(pcs_ptr, context_ptr);
+}
+
+void compute_global_motion(EbPictureBufferDesc *input_pic, int *frm_corners, int num_frm_corners,
+                           EbPictureBufferDesc *ref_pic, int *ref_corners, int num_ref_corners,
                            EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv) {
     MotionModel params_by_motion[RANSAC_NUM_MOTIONS];
+    EbBool      alloc_failed = EB_FALSE;
     for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) {
         memset(&params_by_motion[m], 0, sizeof(params_by_motion[m]));
         params_by_motion[m].inliers =
             malloc(sizeof(*(params_by_motion[m].inliers)) * 2 * MAX_CORNERS);
+        if (params_by_motion[m].inliers == NULL) alloc_failed = EB_TRUE;
+    }
+    // find correspondences between the two images, shared by all the models
+    int *correspondences = (int *)malloc(num_frm_corners * 4 * sizeof(*correspondences));
+    if (correspondences == NULL) alloc_failed = EB_TRUE;
+    // Out of memory: keep the identity model, as when no model beats it
+    if (alloc_failed) {
+        *bestWarpedMotion = default_warp_params;
+        free(correspondences);
+        for (int m = 0; m < RANSAC_NUM_MOTIONS; m++) { free(params_by_motion[m].inliers); }
+        return;
     }
 
     // clang-format off
@@ -181,14 +279,18 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
     const EbWarpedMotionParams *ref_params = &default_warp_params;
 
     {
-        int frm_corners[2 * MAX_CORNERS], inliers_by_motion[RANSAC_NUM_MOTIONS];
-        // compute interest points using FAST features
-        int num_frm_corners = svt_av1_fast_corner_detect(frm_buffer,
-                                                     input_pic->width,
-                                                     input_pic->height,
-                                                     input_pic->stride_y,
-                                                     frm_corners,
-                                                     MAX_CORNERS);
+        int inliers_by_motion[RANSAC_NUM_MOTIONS];
+        int num_correspondences = svt_av1_determine_correspondence(frm_buffer,
+                                                                   frm_corners,
+                                                                   num_frm_corners,
+                                                                   ref_buffer,
+                                                                   ref_corners,
+                                                                   num_ref_corners,
+                                                                   input_pic->width,
+                                                                   input_pic->height,
+                                                                   input_pic->stride_y,
+                                                                   ref_pic->stride_y,
+                                                                   correspondences);
 
         TransformationType model;
         EbWarpedMotionParams tmp_wm_params;
@@ -206,19 +308,12 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
             }
 
             svt_av1_compute_global_motion(model,
-                                      frm_buffer,
-                                      input_pic->width,
-                                      input_pic->height,
-                                      input_pic->stride_y,
-                                      frm_corners,
-                                      num_frm_corners,
-                                      ref_buffer,
-                                      ref_pic->stride_y,
-                                      EB_8BIT,
-                                      gm_estimation_type,
-                                      inliers_by_motion,
-                                      params_by_motion,
-                                      RANSAC_NUM_MOTIONS);
+                                          correspondences,
+                                          num_correspondences,
+                                          gm_estimation_type,
+                                          inliers_by_motion,
+                                          params_by_motion,
+                                          RANSAC_NUM_MOTIONS);
 
             for (unsigned i = 0; i < RANSAC_NUM_MOTIONS; ++i) {
                 if (inliers_by_motion[i] == 0) continue;
@@ -283,6 +378,7 @@ void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *
             }
             if (global_motion.wmtype != IDENTITY) { break; }
         }
+        free(correspondences);
     }
 
     *bestWarpedMotion = global_motion;
@@ -16,9 +16,12 @@
 #include "EbPictureBufferDesc.h"
 #include "EbMotionEstimationContext.h"
 
+void global_motion_estimation_ref_count(PictureParentControlSet *pcs_ptr,
+                                        EbPictureBufferDesc *    input_picture_ptr);
 void global_motion_estimation(PictureParentControlSet *pcs_ptr, MeContext *context_ptr,
-                              EbPictureBufferDesc *input_picture_ptr);
-void compute_global_motion(EbPictureBufferDesc *input_pic, EbPictureBufferDesc *ref_pic,
+                              EbPictureBufferDesc *input_picture_ptr, uint32_t segment_index);
+void compute_global_motion(EbPictureBufferDesc *input_pic, int *frm_corners, int num_frm_corners,
+                           EbPictureBufferDesc *ref_pic, int *ref_corners, int num_ref_corners,
                            EbWarpedMotionParams *bestWarpedMotion, int allow_high_precision_mv);
 
 #endif // EbGlobalMotionEstimation_h
@@ -26,14 +26,20 @@
 #include "EbLog.h"
 #include "EbIntraPrediction.h"
 #include "EbMotionEstimation.h"
+#include "EbTplDispenserTasks.h"
 /**************************************
  * Context
  **************************************/
 typedef struct InitialRateControlContext {
     EbFifo *motion_estimation_results_input_fifo_ptr;
     EbFifo *initialrate_control_results_output_fifo_ptr;
+    EbFifo *tpl_disp_tasks_output_fifo_ptr;
 } InitialRateControlContext;
 
+typedef struct TplDispContext {
+    EbFifo *tpl_disp_tasks_input_fifo_ptr;
+} TplDispContext;
+
 /**************************************
 * Macros
 **************************************/
@@ -57,6 +63,31 @@ EbErrorType initial_rate_control_context_ctor(EbThreadContext *  thread_context_
         enc_handle_ptr->motion_estimation_results_resource_ptr, 0);
     context_ptr->initialrate_control_results_output_fifo_ptr = svt_system_resource_get_producer_fifo(
         enc_handle_ptr->initial_rate_control_results_resource_ptr, 0);
+    if (enc_handle_ptr->tpl_disp_tasks_resource_ptr)
+        context_ptr->tpl_disp_tasks_output_fifo_ptr = svt_system_resource_get_producer_fifo(
+            enc_handle_ptr->tpl_disp_tasks_resource_ptr, 0);
+
+    return EB_ErrorNone;
+}
+
+static void tpl_disp_context_dctor(EbPtr p) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)p;
+    TplDispContext * obj                = (TplDispContext *)thread_context_ptr->priv;
+    EB_FREE_ARRAY(obj);
+}
+
+/************************************************
+* TPL Dispenser Context Constructor
+************************************************/
+EbErrorType tpl_disp_context_ctor(EbThreadContext *  thread_context_ptr,
+                                  const EbEncHandle *enc_handle_ptr, int index) {
+    TplDispContext *context_ptr;
+    EB_CALLOC_ARRAY(context_ptr, 1);
+    thread_context_ptr->priv  = context_ptr;
+    thread_context_ptr->dctor = tpl_disp_context_dctor;
+
+    context_ptr->tpl_disp_tasks_input_fifo_ptr = svt_system_resource_get_consumer_fifo(
+        enc_handle_ptr->tpl_disp_tasks_resource_ptr, index);
 
     return EB_ErrorNone;
 }
@@ -580,49 +611,9 @@ static uint8_t is_me_data_valid(
     return 0;
 }
 /************************************************
-* Genrate TPL MC Flow Dispenser  Based on Lookahead
-** LAD Window: sliding window size
+* Derive the TPL quantizer index of a picture
 ************************************************/
-void tpl_mc_flow_dispenser(
-    EncodeContext                   *encode_context_ptr,
-    SequenceControlSet              *scs_ptr,
-    PictureParentControlSet         *pcs_ptr,
-    int32_t                          frame_idx)
-{
-    uint32_t    picture_width_in_sb = (pcs_ptr->enhanced_picture_ptr->width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
-    uint32_t    picture_width_in_mb = (pcs_ptr->enhanced_picture_ptr->width + 16 - 1) / 16;
-    uint32_t    picture_height_in_sb = (pcs_ptr->enhanced_picture_ptr->height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
-    int16_t     x_curr_mv = 0;
-    int16_t     y_curr_mv = 0;
-    uint32_t    me_mb_offset = 0;
-    TxSize      tx_size = TX_16X16;
-    EbPictureBufferDesc  *ref_pic_ptr;
-    struct      ScaleFactors sf;
-    BlockGeom   blk_geom;
-    uint32_t    kernel = (EIGHTTAP_REGULAR << 16) | EIGHTTAP_REGULAR;
-    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
-    TplStats  tpl_stats;
-
-    (void)scs_ptr;
-
-    DECLARE_ALIGNED(32, uint8_t, predictor8[256 * 2]);
-    DECLARE_ALIGNED(32, int16_t, src_diff[256]);
-    DECLARE_ALIGNED(32, TranLow, coeff[256]);
-    DECLARE_ALIGNED(32, TranLow, qcoeff[256]);
-    DECLARE_ALIGNED(32, TranLow, dqcoeff[256]);
-    DECLARE_ALIGNED(32, TranLow, best_coeff[256]);
-    uint8_t *predictor = predictor8;
-
-    blk_geom.bwidth  = 16;
-    blk_geom.bheight = 16;
-
-    svt_av1_setup_scale_factors_for_frame(
-                &sf, picture_width_in_sb * BLOCK_SIZE_64,
-                picture_height_in_sb * BLOCK_SIZE_64,
-                picture_width_in_sb * BLOCK_SIZE_64,
-                picture_height_in_sb * BLOCK_SIZE_64);
-
-    MacroblockPlane mb_plane;
+static int32_t get_tpl_qindex(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
     int32_t qIndex = quantizer_to_qindex[(uint8_t)scs_ptr->static_config.qp];
 
     const  double delta_rate_new[7][6] =
@@ -649,7 +640,18 @@ void tpl_mc_flow_dispenser(
             8);
     qIndex =
        (qIndex + delta_qindex);
+    return qIndex;
+}
 
+/************************************************
+* Build the TPL quantizer of a picture
+** Has to be done before the picture is dispensed
+************************************************/
+static void tpl_mc_flow_quantizer_init(
+    SequenceControlSet              *scs_ptr,
+    PictureParentControlSet         *pcs_ptr)
+{
+    int32_t qIndex = get_tpl_qindex(scs_ptr, pcs_ptr);
     Quants *const quants_bd = &pcs_ptr->quants_bd;
     Dequants *const deq_bd = &pcs_ptr->deq_bd;
     svt_av1_set_quantizer(
@@ -664,238 +666,345 @@ void tpl_mc_flow_dispenser(
         pcs_ptr->frm_hdr.quantization_params.delta_q_ac[AOM_PLANE_V],
         quants_bd,
         deq_bd);
-    mb_plane.quant_qtx       = pcs_ptr->quants_bd.y_quant[qIndex];
-    mb_plane.quant_fp_qtx    = pcs_ptr->quants_bd.y_quant_fp[qIndex];
-    mb_plane.round_fp_qtx    = pcs_ptr->quants_bd.y_round_fp[qIndex];
-    mb_plane.quant_shift_qtx = pcs_ptr->quants_bd.y_quant_shift[qIndex];
-    mb_plane.zbin_qtx        = pcs_ptr->quants_bd.y_zbin[qIndex];
-    mb_plane.round_qtx       = pcs_ptr->quants_bd.y_round[qIndex];
-    mb_plane.dequant_qtx     = pcs_ptr->deq_bd.y_dequant_qtx[qIndex];
     pcs_ptr->base_rdmult = svt_av1_compute_rd_mult_based_on_qindex((AomBitDepth)8/*scs_ptr->static_config.encoder_bit_depth*/, qIndex) / 6;
+}
 
-    // Walk the first N entries in the sliding window
-    for (uint32_t sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
-        {
-            SbParams *sb_params = &scs_ptr->sb_params_array[sb_index];
-            uint32_t pa_blk_index = 0;
-            while (pa_blk_index < CU_MAX_COUNT) {
-                const CodedBlockStats *blk_stats_ptr;
-                blk_stats_ptr = get_coded_blk_stats(pa_blk_index);
-                uint8_t bsize = blk_stats_ptr->size;
-                EbBool small_boundary_blk = EB_FALSE;
-
-                //if(sb_params->raster_scan_blk_validity[md_scan_to_raster_scan[pa_blk_index]])
-                {
-                    uint32_t cu_origin_x = sb_params->origin_x + blk_stats_ptr->origin_x;
-                    uint32_t cu_origin_y = sb_params->origin_y + blk_stats_ptr->origin_y;
-                    if ((blk_stats_ptr->origin_x % 16) == 0 && (blk_stats_ptr->origin_y % 16) == 0 &&
-                            ((pcs_ptr->enhanced_picture_ptr->width - cu_origin_x) < 16 || (pcs_ptr->enhanced_picture_ptr->height - cu_origin_y) < 16))
-                        small_boundary_blk = EB_TRUE;
-                }
-                if(bsize != 16 && !small_boundary_blk) {
-                    pa_blk_index++;
+static void get_tpl_mb_plane(PictureParentControlSet *pcs_ptr, int32_t qIndex, MacroblockPlane *mb_plane) {
+    mb_plane->quant_qtx       = pcs_ptr->quants_bd.y_quant[qIndex];
+    mb_plane->quant_fp_qtx    = pcs_ptr->quants_bd.y_quant_fp[qIndex];
+    mb_plane->round_fp_qtx    = pcs_ptr->quants_bd.y_round_fp[qIndex];
+    mb_plane->quant_shift_qtx = pcs_ptr->quants_bd.y_quant_shift[qIndex];
+    mb_plane->zbin_qtx        = pcs_ptr->quants_bd.y_zbin[qIndex];
+    mb_plane->round_qtx       = pcs_ptr->quants_bd.y_round[qIndex];
+    mb_plane->dequant_qtx     = pcs_ptr->deq_bd.y_dequant_qtx[qIndex];
+}
+
+//Given one PA block of a 64x64 SB, indicate if the TPL dispenser processes it:
+//the 16x16 blocks, and the 16x16 aligned blocks that are cut by the picture boundaries
+static EbBool is_tpl_dispenser_blk(
+    const PictureParentControlSet *pcs_ptr,
+    const SbParams                *sb_params,
+    const CodedBlockStats         *blk_stats_ptr,
+    uint32_t                       pa_blk_index) {
+
+    EbBool small_boundary_blk = EB_FALSE;
+    uint32_t cu_origin_x = sb_params->origin_x + blk_stats_ptr->origin_x;
+    uint32_t cu_origin_y = sb_params->origin_y + blk_stats_ptr->origin_y;
+    if ((blk_stats_ptr->origin_x % 16) == 0 && (blk_stats_ptr->origin_y % 16) == 0 &&
+            ((pcs_ptr->enhanced_picture_ptr->width - cu_origin_x) < 16 || (pcs_ptr->enhanced_picture_ptr->height - cu_origin_y) < 16))
+        small_boundary_blk = EB_TRUE;
+    if (blk_stats_ptr->size != 16 && !small_boundary_blk)
+        return EB_FALSE;
+    return sb_params->raster_scan_blk_validity[md_scan_to_raster_scan[pa_blk_index]];
+}
+
+/************************************************
+* Genrate TPL MC Flow Dispenser Source Stats
+** Inter search of one 64x64 SB row against the PA references.
+** Only reads source data, so the rows of all the pictures of
+** the sliding window can be dispensed in parallel.
+************************************************/
+static void tpl_mc_flow_dispenser_src_sb_row(
+    EncodeContext                   *encode_context_ptr,
+    SequenceControlSet              *scs_ptr,
+    PictureParentControlSet         *pcs_ptr,
+    int32_t                          frame_idx,
+    uint32_t                         sb_row)
+{
+    uint32_t    picture_width_in_sb = (pcs_ptr->enhanced_picture_ptr->width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+    uint32_t    picture_width_in_mb = (pcs_ptr->enhanced_picture_ptr->width + 16 - 1) / 16;
+    uint32_t    picture_height_in_sb = (pcs_ptr->enhanced_picture_ptr->height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+    int16_t     x_curr_mv = 0;
+    int16_t     y_curr_mv = 0;
+    uint32_t    me_mb_offset = 0;
+    TxSize      tx_size = TX_16X16;
+    EbPictureBufferDesc  *ref_pic_ptr;
+    struct      ScaleFactors sf;
+    BlockGeom   blk_geom;
+    uint32_t    kernel = (EIGHTTAP_REGULAR << 16) | EIGHTTAP_REGULAR;
+    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+
+    DECLARE_ALIGNED(32, uint8_t, predictor8[256 * 2]);
+    DECLARE_ALIGNED(32, int16_t, src_diff[256]);
+    DECLARE_ALIGNED(32, TranLow, coeff[256]);
+    DECLARE_ALIGNED(32, TranLow, qcoeff[256]);
+    DECLARE_ALIGNED(32, TranLow, dqcoeff[256]);
+    DECLARE_ALIGNED(32, TranLow, best_coeff[256]);
+    uint8_t *predictor = predictor8;
+
+    blk_geom.bwidth  = 16;
+    blk_geom.bheight = 16;
+
+    svt_av1_setup_scale_factors_for_frame(
+                &sf, picture_width_in_sb * BLOCK_SIZE_64,
+                picture_height_in_sb * BLOCK_SIZE_64,
+                picture_width_in_sb * BLOCK_SIZE_64,
+                picture_height_in_sb * BLOCK_SIZE_64);
+
+    MacroblockPlane mb_plane;
+    get_tpl_mb_plane(pcs_ptr, get_tpl_qindex(scs_ptr, pcs_ptr), &mb_plane);
+
+    const uint32_t sb_row_start = sb_row * scs_ptr->pic_width_in_sb;
+    const uint32_t sb_row_end   = MIN(sb_row_start + scs_ptr->pic_width_in_sb, pcs_ptr->sb_total_count);
+    for (uint32_t sb_index = sb_row_start; sb_index < sb_row_end; ++sb_index) {
+        SbParams *sb_params = &scs_ptr->sb_params_array[sb_index];
+        for (uint32_t pa_blk_index = 0; pa_blk_index < CU_MAX_COUNT; ++pa_blk_index) {
+            const CodedBlockStats *blk_stats_ptr = get_coded_blk_stats(pa_blk_index);
+            if (!is_tpl_dispenser_blk(pcs_ptr, sb_params, blk_stats_ptr, pa_blk_index))
+                continue;
+            uint32_t mb_origin_x = sb_params->origin_x + blk_stats_ptr->origin_x;
+            uint32_t mb_origin_y = sb_params->origin_y + blk_stats_ptr->origin_y;
+            int64_t inter_cost;
+            int64_t recon_error = 1, sse = 1;
+            uint64_t best_ref_poc = 0;
+            int32_t best_rf_idx = -1;
+            int64_t best_inter_cost = INT64_MAX;
+            MV final_best_mv = {0, 0};
+            uint32_t max_inter_ref = MAX_PA_ME_MV;
+            OisMbResults *ois_mb_results_ptr = pcs_ptr->ois_mb_results[(mb_origin_y >> 4) * picture_width_in_mb + (mb_origin_x >> 4)];
+            int64_t best_intra_cost = ois_mb_results_ptr->intra_cost;
+            uint8_t best_mode = DC_PRED;
+            uint8_t *src_mb = input_picture_ptr->buffer_y + input_picture_ptr->origin_x + mb_origin_x +
+                             (input_picture_ptr->origin_y + mb_origin_y) * input_picture_ptr->stride_y;
+            TplSrcStats *tpl_src_stats_ptr = &pcs_ptr->tpl_src_stats_buffer[(mb_origin_y >> 4) * picture_width_in_mb + (mb_origin_x >> 4)];
+            memset(tpl_src_stats_ptr, 0, sizeof(*tpl_src_stats_ptr));
+            blk_geom.origin_x = blk_stats_ptr->origin_x;
+            blk_geom.origin_y = blk_stats_ptr->origin_y;
+            me_mb_offset = get_me_info_index(pcs_ptr->max_number_of_pus_per_sb, &blk_geom, 0, 0);
+            for(uint32_t rf_idx = 0; rf_idx < max_inter_ref; rf_idx++) {
+                uint32_t list_index = rf_idx < 4 ? 0 : 1;
+                uint32_t ref_pic_index = rf_idx >= 4 ? (rf_idx - 4) : rf_idx;
+
+                if( (list_index == 0 && (ref_pic_index+1) > pcs_ptr->ref_list0_count_try) ||
+                    (list_index == 1 && (ref_pic_index+1) > pcs_ptr->ref_list1_count_try) )
+                    continue;
+                if( !is_me_data_valid( pcs_ptr->pa_me_data->me_results[sb_index], me_mb_offset, list_index, ref_pic_index))
+                    continue;
+                if(!pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index])
+                    continue;
+                uint64_t ref_poc = pcs_ptr->ref_pic_poc_array[list_index][ref_pic_index];
+                uint32_t ref_frame_idx = 0;
+                while(ref_frame_idx < MAX_TPL_LA_SW && encode_context_ptr->poc_map_idx[ref_frame_idx] != ref_poc)
+                    ref_frame_idx++;
+                if(ref_frame_idx == MAX_TPL_LA_SW || (int32_t)ref_frame_idx >= frame_idx) {
                     continue;
                 }
-                if (sb_params->raster_scan_blk_validity[md_scan_to_raster_scan[pa_blk_index]]) {
-                    uint32_t mb_origin_x = sb_params->origin_x + blk_stats_ptr->origin_x;
-                    uint32_t mb_origin_y = sb_params->origin_y + blk_stats_ptr->origin_y;
-                    const int dst_buffer_stride = input_picture_ptr->stride_y;
-                    const int dst_mb_offset = mb_origin_y * dst_buffer_stride + mb_origin_x;
-                    const int dst_basic_offset = input_picture_ptr->origin_y * input_picture_ptr->stride_y + input_picture_ptr->origin_x;
-                    uint8_t *dst_buffer = encode_context_ptr->mc_flow_rec_picture_buffer[frame_idx] + dst_basic_offset + dst_mb_offset;
-                    int64_t inter_cost;
-                    int64_t recon_error = 1, sse = 1;
-                    uint64_t best_ref_poc = 0;
-                    int32_t best_rf_idx = -1;
-                    int64_t best_inter_cost = INT64_MAX;
-                    MV final_best_mv = {0, 0};
-                    uint32_t max_inter_ref = MAX_PA_ME_MV;
-                    OisMbResults *ois_mb_results_ptr = pcs_ptr->ois_mb_results[(mb_origin_y >> 4) * picture_width_in_mb + (mb_origin_x >> 4)];
-                    int64_t best_intra_cost = ois_mb_results_ptr->intra_cost;
-                    uint8_t best_mode = DC_PRED;
-                    uint8_t *src_mb = input_picture_ptr->buffer_y + input_picture_ptr->origin_x + mb_origin_x +
-                                     (input_picture_ptr->origin_y + mb_origin_y) * input_picture_ptr->stride_y;
-                    memset(&tpl_stats, 0, sizeof(tpl_stats));
-                    blk_geom.origin_x = blk_stats_ptr->origin_x;
-                    blk_geom.origin_y = blk_stats_ptr->origin_y;
-                    me_mb_offset = get_me_info_index(pcs_ptr->max_number_of_pus_per_sb, &blk_geom, 0, 0);
-                    for(uint32_t rf_idx = 0; rf_idx < max_inter_ref; rf_idx++) {
-                        uint32_t list_index = rf_idx < 4 ? 0 : 1;
-                        uint32_t ref_pic_index = rf_idx >= 4 ? (rf_idx - 4) : rf_idx;
-
-                        if( (list_index == 0 && (ref_pic_index+1) > pcs_ptr->ref_list0_count_try) ||
-                            (list_index == 1 && (ref_pic_index+1) > pcs_ptr->ref_list1_count_try) )
-                            continue;
-                        if( !is_me_data_valid( pcs_ptr->pa_me_data->me_results[sb_index], me_mb_offset, list_index, ref_pic_index))
-                            continue;
-                        if(!pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index])
-                            continue;
-                        uint64_t ref_poc = pcs_ptr->ref_pic_poc_array[list_index][ref_pic_index];
-                        uint32_t ref_frame_idx = 0;
-                        while(ref_frame_idx < MAX_TPL_LA_SW && encode_context_ptr->poc_map_idx[ref_frame_idx] != ref_poc)
-                            ref_frame_idx++;
-                        if(ref_frame_idx == MAX_TPL_LA_SW || (int32_t)ref_frame_idx >= frame_idx) {
-                            continue;
-                        }
 
-                        EbPaReferenceObject * referenceObject = (EbPaReferenceObject*)pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
-                        ref_pic_ptr = (EbPictureBufferDesc*)referenceObject->input_padded_picture_ptr;
-
-                        const int ref_basic_offset = ref_pic_ptr->origin_y * ref_pic_ptr->stride_y + ref_pic_ptr->origin_x;
-                        const int ref_mb_offset = mb_origin_y * ref_pic_ptr->stride_y + mb_origin_x;
-                        uint8_t *ref_mb = ref_pic_ptr->buffer_y + ref_basic_offset + ref_mb_offset;
-
-                        struct Buf2D ref_buf = { NULL, ref_pic_ptr->buffer_y + ref_basic_offset,
-                                                  ref_pic_ptr->width, ref_pic_ptr->height,
-                                                  ref_pic_ptr->stride_y };
-                        const MeSbResults *me_results = pcs_ptr->pa_me_data->me_results[sb_index];
-                        x_curr_mv = me_results->me_mv_array[me_mb_offset * MAX_PA_ME_MV + (list_index ? 4 : 0) + ref_pic_index].x_mv << 1;
-                        y_curr_mv = me_results->me_mv_array[me_mb_offset * MAX_PA_ME_MV + (list_index ? 4 : 0) + ref_pic_index].y_mv << 1;
-                        InterPredParams inter_pred_params;
-                        svt_av1_init_inter_params(&inter_pred_params, 16, 16, mb_origin_y,
-                                mb_origin_x, 0, 0, 8, 0, 0,
-                                &sf, &ref_buf, kernel);
-
-                        inter_pred_params.conv_params = get_conv_params(0, 0, 0, 8);
-
-                        MV best_mv = {y_curr_mv, x_curr_mv};
-                        av1_build_inter_predictor(pcs_ptr->av1_cm,
-                                                  ref_mb,
-                                                  input_picture_ptr->stride_y,
-                                                  predictor,
-                                                  16,
-                                                  &best_mv,
-                                                  mb_origin_x,
-                                                  mb_origin_y,
-                                                  &inter_pred_params);
-                        svt_aom_subtract_block(16, 16, src_diff, 16, src_mb, input_picture_ptr->stride_y, predictor, 16);
-
-                        svt_av1_wht_fwd_txfm(src_diff, 16, coeff, tx_size, 8, 0);
-
-                        inter_cost = svt_aom_satd(coeff, 256);
-                        if (inter_cost < best_inter_cost) {
-                            memcpy(best_coeff, coeff, sizeof(best_coeff));
-                            best_ref_poc = ref_poc;
-                            best_rf_idx = rf_idx;
-                            best_inter_cost = inter_cost;
-                            final_best_mv = best_mv;
-
-                            if (best_inter_cost < best_intra_cost) best_mode = NEWMV;
-                        }
-                    } // rf_idx
-                    if(best_inter_cost < INT64_MAX) {
-                        uint16_t eob = 0;
-                        get_quantize_error(&mb_plane, best_coeff, qcoeff, dqcoeff, tx_size, &eob, &recon_error, &sse);
-                        int rate_cost = pcs_ptr->tpl_opt_flag? 0 : rate_estimator(qcoeff, eob, tx_size);
-                        tpl_stats.srcrf_rate = rate_cost << TPL_DEP_COST_SCALE_LOG2;
-                    }
-                    best_intra_cost = AOMMAX(best_intra_cost, 1);
-                    if (frame_is_intra_only(pcs_ptr))
-                        best_inter_cost = 0;
-                    else
-                        best_inter_cost = AOMMIN(best_intra_cost, best_inter_cost);
-
-                    tpl_stats.srcrf_dist = recon_error << (TPL_DEP_COST_SCALE_LOG2);
-
-                    if (best_mode == NEWMV) {
-                        // inter recon with rec_picture as reference pic
-                        uint64_t ref_poc = best_ref_poc;
-                        uint32_t ref_frame_idx = 0;
-                        while(ref_frame_idx < MAX_TPL_LA_SW && encode_context_ptr->poc_map_idx[ref_frame_idx] != ref_poc)
-                            ref_frame_idx++;
-                        assert(ref_frame_idx != MAX_TPL_LA_SW);
-
-                        const int ref_basic_offset = input_picture_ptr->origin_y * input_picture_ptr->stride_y + input_picture_ptr->origin_x;
-                        const int ref_mb_offset = mb_origin_y * input_picture_ptr->stride_y + mb_origin_x;
-                        uint8_t *ref_mb = encode_context_ptr->mc_flow_rec_picture_buffer[ref_frame_idx] + ref_basic_offset + ref_mb_offset;
-
-                        struct Buf2D ref_buf = { NULL, encode_context_ptr->mc_flow_rec_picture_buffer[ref_frame_idx] + ref_basic_offset,
-                                                  input_picture_ptr->width, input_picture_ptr->height,
-                                                  input_picture_ptr->stride_y};
-                        InterPredParams inter_pred_params;
-                        svt_av1_init_inter_params(&inter_pred_params, 16, 16, mb_origin_y,
-                            mb_origin_x, 0, 0, 8, 0, 0,
-                            &sf, &ref_buf, kernel);
-
-                        inter_pred_params.conv_params = get_conv_params(0, 0, 0, 8);
-                        av1_build_inter_predictor(pcs_ptr->av1_cm,
-                                                  ref_mb,
-                                                  input_picture_ptr->stride_y,
-                                                  dst_buffer,
-                                                  dst_buffer_stride,
-                                                  &final_best_mv,
-                                                  mb_origin_x,
-                                                  mb_origin_y,
-                                                  &inter_pred_params);
-                    } else {
-                        // intra recon
-                        uint8_t *above_row;
-                        uint8_t *left_col;
-                        DECLARE_ALIGNED(16, uint8_t, left_data[MAX_TX_SIZE * 2 + 32]);
-                        DECLARE_ALIGNED(16, uint8_t, above_data[MAX_TX_SIZE * 2 + 32]);
-
-                        above_row = above_data + 16;
-                        left_col = left_data + 16;
-                        uint8_t *recon_buffer =
-                            encode_context_ptr->mc_flow_rec_picture_buffer[frame_idx] +
-                            dst_basic_offset;
-                        update_neighbor_samples_array_open_loop_mb_recon(above_row - 1,
-                                                                         left_col - 1,
-                                                                         recon_buffer,
-                                                                         dst_buffer_stride,
-                                                                         mb_origin_x,
-                                                                         mb_origin_y,
-                                                                         16,
-                                                                         16,
-                                                                         input_picture_ptr->width,
-                                                                         input_picture_ptr->height);
-                        uint8_t ois_intra_mode = ois_mb_results_ptr->intra_mode;
-                        int32_t p_angle = av1_is_directional_mode((PredictionMode)ois_intra_mode) ? mode_to_angle_map[(PredictionMode)ois_intra_mode] : 0;
-                        // Edge filter
-                        if(av1_is_directional_mode((PredictionMode)ois_intra_mode) && 1/*scs_ptr->seq_header.enable_intra_edge_filter*/) {
-                            filter_intra_edge(ois_mb_results_ptr, ois_intra_mode, scs_ptr->seq_header.max_frame_width, scs_ptr->seq_header.max_frame_height, p_angle, mb_origin_x, mb_origin_y, above_row, left_col);
-                        }
-                        // PRED
-                        intra_prediction_open_loop_mb(p_angle,
-                                                      ois_intra_mode,
-                                                      mb_origin_x,
-                                                      mb_origin_y,
-                                                      TX_16X16,
-                                                      above_row,
-                                                      left_col,
-                                                      dst_buffer,
-                                                      dst_buffer_stride);
-                    }
+                EbPaReferenceObject * referenceObject = (EbPaReferenceObject*)pcs_ptr->ref_pa_pic_ptr_array[list_index][ref_pic_index]->object_ptr;
+                ref_pic_ptr = (EbPictureBufferDesc*)referenceObject->input_padded_picture_ptr;
+
+                const int ref_basic_offset = ref_pic_ptr->origin_y * ref_pic_ptr->stride_y + ref_pic_ptr->origin_x;
+                const int ref_mb_offset = mb_origin_y * ref_pic_ptr->stride_y + mb_origin_x;
+                uint8_t *ref_mb = ref_pic_ptr->buffer_y + ref_basic_offset + ref_mb_offset;
+
+                struct Buf2D ref_buf = { NULL, ref_pic_ptr->buffer_y + ref_basic_offset,
+                                          ref_pic_ptr->width, ref_pic_ptr->height,
+                                          ref_pic_ptr->stride_y };
+                const MeSbResults *me_results = pcs_ptr->pa_me_data->me_results[sb_index];
+                x_curr_mv = me_results->me_mv_array[me_mb_offset * MAX_PA_ME_MV + (list_index ? 4 : 0) + ref_pic_index].x_mv << 1;
+                y_curr_mv = me_results->me_mv_array[me_mb_offset * MAX_PA_ME_MV + (list_index ? 4 : 0) + ref_pic_index].y_mv << 1;
+                InterPredParams inter_pred_params;
+                svt_av1_init_inter_params(&inter_pred_params, 16, 16, mb_origin_y,
+                        mb_origin_x, 0, 0, 8, 0, 0,
+                        &sf, &ref_buf, kernel);
+
+                inter_pred_params.conv_params = get_conv_params(0, 0, 0, 8);
+
+                MV best_mv = {y_curr_mv, x_curr_mv};
+                av1_build_inter_predictor(pcs_ptr->av1_cm,
+                                          ref_mb,
+                                          input_picture_ptr->stride_y,
+                                          predictor,
+                                          16,
+                                          &best_mv,
+                                          mb_origin_x,
+                                          mb_origin_y,
+                                          &inter_pred_params);
+                svt_aom_subtract_block(16, 16, src_diff, 16, src_mb, input_picture_ptr->stride_y, predictor, 16);
+
+                svt_av1_wht_fwd_txfm(src_diff, 16, coeff, tx_size, 8, 0);
+
+                inter_cost = svt_aom_satd(coeff, 256);
+                if (inter_cost < best_inter_cost) {
+                    memcpy(best_coeff, coeff, sizeof(best_coeff));
+                    best_ref_poc = ref_poc;
+                    best_rf_idx = rf_idx;
+                    best_inter_cost = inter_cost;
+                    final_best_mv = best_mv;
+
+                    if (best_inter_cost < best_intra_cost) best_mode = NEWMV;
+                }
+            } // rf_idx
+            if(best_inter_cost < INT64_MAX) {
+                uint16_t eob = 0;
+                get_quantize_error(&mb_plane, best_coeff, qcoeff, dqcoeff, tx_size, &eob, &recon_error, &sse);
+                int rate_cost = pcs_ptr->tpl_opt_flag? 0 : rate_estimator(qcoeff, eob, tx_size);
+                tpl_src_stats_ptr->srcrf_rate = rate_cost << TPL_DEP_COST_SCALE_LOG2;
+            }
+            tpl_src_stats_ptr->srcrf_dist = recon_error << (TPL_DEP_COST_SCALE_LOG2);
+            tpl_src_stats_ptr->mv = final_best_mv;
+            tpl_src_stats_ptr->ref_frame_poc = best_ref_poc;
+            tpl_src_stats_ptr->best_rf_idx = best_rf_idx;
+            tpl_src_stats_ptr->best_mode = best_mode;
+        }
+    }
+}
 
-                    svt_aom_subtract_block(16, 16, src_diff, 16, src_mb, input_picture_ptr->stride_y, dst_buffer, dst_buffer_stride);
-                    svt_av1_wht_fwd_txfm(src_diff, 16, coeff, tx_size, 8, 0);
+/************************************************
+* Genrate TPL MC Flow Dispenser  Based on Lookahead
+** LAD Window: sliding window size
+** Reconstruction part of the dispenser; the source stats of
+** the picture have to be dispensed beforehand.
+************************************************/
+void tpl_mc_flow_dispenser(
+    EncodeContext                   *encode_context_ptr,
+    SequenceControlSet              *scs_ptr,
+    PictureParentControlSet         *pcs_ptr,
+    int32_t                          frame_idx)
+{
+    uint32_t    picture_width_in_sb = (pcs_ptr->enhanced_picture_ptr->width + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+    uint32_t    picture_width_in_mb = (pcs_ptr->enhanced_picture_ptr->width + 16 - 1) / 16;
+    uint32_t    picture_height_in_sb = (pcs_ptr->enhanced_picture_ptr->height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64;
+    TxSize      tx_size = TX_16X16;
+    struct      ScaleFactors sf;
+    uint32_t    kernel = (EIGHTTAP_REGULAR << 16) | EIGHTTAP_REGULAR;
+    EbPictureBufferDesc *input_picture_ptr = pcs_ptr->enhanced_picture_ptr;
+    TplStats  tpl_stats;
 
-                    uint16_t eob = 0;
+    DECLARE_ALIGNED(32, int16_t, src_diff[256]);
+    DECLARE_ALIGNED(32, TranLow, coeff[256]);
+    DECLARE_ALIGNED(32, TranLow, qcoeff[256]);
+    DECLARE_ALIGNED(32, TranLow, dqcoeff[256]);
 
-                    get_quantize_error(&mb_plane, coeff, qcoeff, dqcoeff, tx_size, &eob, &recon_error, &sse);
-                    int rate_cost = pcs_ptr->tpl_opt_flag ? 0 : rate_estimator(qcoeff, eob, tx_size);
+    svt_av1_setup_scale_factors_for_frame(
+                &sf, picture_width_in_sb * BLOCK_SIZE_64,
+                picture_height_in_sb * BLOCK_SIZE_64,
+                picture_width_in_sb * BLOCK_SIZE_64,
+                picture_height_in_sb * BLOCK_SIZE_64);
 
-                    if(eob) {
-                        av1_inv_transform_recon8bit((int32_t*)dqcoeff, dst_buffer, dst_buffer_stride, dst_buffer, dst_buffer_stride, TX_16X16, DCT_DCT, PLANE_TYPE_Y, eob, 0);
-                    }
+    MacroblockPlane mb_plane;
+    get_tpl_mb_plane(pcs_ptr, get_tpl_qindex(scs_ptr, pcs_ptr), &mb_plane);
 
-                    tpl_stats.recrf_dist = recon_error << (TPL_DEP_COST_SCALE_LOG2);
-                    tpl_stats.recrf_rate = rate_cost << TPL_DEP_COST_SCALE_LOG2;
-                    if (best_mode != NEWMV) {
-                        tpl_stats.srcrf_dist = recon_error << (TPL_DEP_COST_SCALE_LOG2);
-                        tpl_stats.srcrf_rate = rate_cost << TPL_DEP_COST_SCALE_LOG2;
-                    }
-                    tpl_stats.recrf_dist = AOMMAX(tpl_stats.srcrf_dist, tpl_stats.recrf_dist);
-                    tpl_stats.recrf_rate = AOMMAX(tpl_stats.srcrf_rate, tpl_stats.recrf_rate);
-                    if (!frame_is_intra_only(pcs_ptr) && best_rf_idx != -1) {
-                        tpl_stats.mv = final_best_mv;
-                        tpl_stats.ref_frame_poc = best_ref_poc;
-                    }
-                    // Motion flow dependency dispenser.
-                    result_model_store(pcs_ptr, &tpl_stats, mb_origin_x, mb_origin_y);
+    // Walk the first N entries in the sliding window
+    for (uint32_t sb_index = 0; sb_index < pcs_ptr->sb_total_count; ++sb_index) {
+        SbParams *sb_params = &scs_ptr->sb_params_array[sb_index];
+        for (uint32_t pa_blk_index = 0; pa_blk_index < CU_MAX_COUNT; ++pa_blk_index) {
+            const CodedBlockStats *blk_stats_ptr = get_coded_blk_stats(pa_blk_index);
+            if (!is_tpl_dispenser_blk(pcs_ptr, sb_params, blk_stats_ptr, pa_blk_index))
+                continue;
+            uint32_t mb_origin_x = sb_params->origin_x + blk_stats_ptr->origin_x;
+            uint32_t mb_origin_y = sb_params->origin_y + blk_stats_ptr->origin_y;
+            const int dst_buffer_stride = input_picture_ptr->stride_y;
+            const int dst_mb_offset = mb_origin_y * dst_buffer_stride + mb_origin_x;
+            const int dst_basic_offset = input_picture_ptr->origin_y * input_picture_ptr->stride_y + input_picture_ptr->origin_x;
+            uint8_t *dst_buffer = encode_context_ptr->mc_flow_rec_picture_buffer[frame_idx] + dst_basic_offset + dst_mb_offset;
+            int64_t recon_error = 1, sse = 1;
+            OisMbResults *ois_mb_results_ptr = pcs_ptr->ois_mb_results[(mb_origin_y >> 4) * picture_width_in_mb + (mb_origin_x >> 4)];
+            const TplSrcStats *tpl_src_stats_ptr = &pcs_ptr->tpl_src_stats_buffer[(mb_origin_y >> 4) * picture_width_in_mb + (mb_origin_x >> 4)];
+            uint8_t best_mode = tpl_src_stats_ptr->best_mode;
+            uint8_t *src_mb = input_picture_ptr->buffer_y + input_picture_ptr->origin_x + mb_origin_x +
+                             (input_picture_ptr->origin_y + mb_origin_y) * input_picture_ptr->stride_y;
+            memset(&tpl_stats, 0, sizeof(tpl_stats));
+            tpl_stats.srcrf_dist = tpl_src_stats_ptr->srcrf_dist;
+            tpl_stats.srcrf_rate = tpl_src_stats_ptr->srcrf_rate;
+
+            if (best_mode == NEWMV) {
+                // inter recon with rec_picture as reference pic
+                uint64_t ref_poc = tpl_src_stats_ptr->ref_frame_poc;
+                uint32_t ref_frame_idx = 0;
+                while(ref_frame_idx < MAX_TPL_LA_SW && encode_context_ptr->poc_map_idx[ref_frame_idx] != ref_poc)
+                    ref_frame_idx++;
+                assert(ref_frame_idx != MAX_TPL_LA_SW);
+
+                const int ref_basic_offset = input_picture_ptr->origin_y * input_picture_ptr->stride_y + input_picture_ptr->origin_x;
+                const int ref_mb_offset = mb_origin_y * input_picture_ptr->stride_y + mb_origin_x;
+                uint8_t *ref_mb = encode_context_ptr->mc_flow_rec_picture_buffer[ref_frame_idx] + ref_basic_offset + ref_mb_offset;
+
+                struct Buf2D ref_buf = { NULL, encode_context_ptr->mc_flow_rec_picture_buffer[ref_frame_idx] + ref_basic_offset,
+                                          input_picture_ptr->width, input_picture_ptr->height,
+                                          input_picture_ptr->stride_y};
+                InterPredParams inter_pred_params;
+                svt_av1_init_inter_params(&inter_pred_params, 16, 16, mb_origin_y,
+                    mb_origin_x, 0, 0, 8, 0, 0,
+                    &sf, &ref_buf, kernel);
+
+                inter_pred_params.conv_params = get_conv_params(0, 0, 0, 8);
+                MV final_best_mv = tpl_src_stats_ptr->mv;
+                av1_build_inter_predictor(pcs_ptr->av1_cm,
+                                          ref_mb,
+                                          input_picture_ptr->stride_y,
+                                          dst_buffer,
+                                          dst_buffer_stride,
+                                          &final_best_mv,
+                                          mb_origin_x,
+                                          mb_origin_y,
+                                          &inter_pred_params);
+            } else {
+                // intra recon
+                uint8_t *above_row;
+                uint8_t *left_col;
+                DECLARE_ALIGNED(16, uint8_t, left_data[MAX_TX_SIZE * 2 + 32]);
+                DECLARE_ALIGNED(16, uint8_t, above_data[MAX_TX_SIZE * 2 + 32]);
+
+                above_row = above_data + 16;
+                left_col = left_data + 16;
+                uint8_t *recon_buffer =
+                    encode_context_ptr->mc_flow_rec_picture_buffer[frame_idx] +
+                    dst_basic_offset;
+                update_neighbor_samples_array_open_loop_mb_recon(above_row - 1,
+                                                                 left_col - 1,
+                                                                 recon_buffer,
+                                                                 dst_buffer_stride,
+                                                                 mb_origin_x,
+                                                                 mb_origin_y,
+                                                                 16,
+                                                                 16,
+                                                                 input_picture_ptr->width,
+                                                                 input_picture_ptr->height);
+                uint8_t ois_intra_mode = ois_mb_results_ptr->intra_mode;
+                int32_t p_angle = av1_is_directional_mode((PredictionMode)ois_intra_mode) ? mode_to_angle_map[(PredictionMode)ois_intra_mode] : 0;
+                // Edge filter
+                if(av1_is_directional_mode((PredictionMode)ois_intra_mode) && 1/*scs_ptr->seq_header.enable_intra_edge_filter*/) {
+                    filter_intra_edge(ois_mb_results_ptr, ois_intra_mode, scs_ptr->seq_header.max_frame_width, scs_ptr->seq_header.max_frame_height, p_angle, mb_origin_x, mb_origin_y, above_row, left_col);
                 }
-                pa_blk_index++;
+                // PRED
+                intra_prediction_open_loop_mb(p_angle,
+                                              ois_intra_mode,
+                                              mb_origin_x,
+                                              mb_origin_y,
+                                              TX_16X16,
+                                              above_row,
+                                              left_col,
+                                              dst_buffer,
+                                              dst_buffer_stride);
             }
+
+            svt_aom_subtract_block(16, 16, src_diff, 16, src_mb, input_picture_ptr->stride_y, dst_buffer, dst_buffer_stride);
+            svt_av1_wht_fwd_txfm(src_diff, 16, coeff, tx_size, 8, 0);
+
+            uint16_t eob = 0;
+
+            get_quantize_error(&mb_plane, coeff, qcoeff, dqcoeff, tx_size, &eob, &recon_error, &sse);
+            int rate_cost = pcs_ptr->tpl_opt_flag ? 0 : rate_estimator(qcoeff, eob, tx_size);
+
+            if(eob) {
+                av1_inv_transform_recon8bit((int32_t*)dqcoeff, dst_buffer, dst_buffer_stride, dst_buffer, dst_buffer_stride, TX_16X16, DCT_DCT, PLANE_TYPE_Y, eob, 0);
+            }
+
+            tpl_stats.recrf_dist = recon_error << (TPL_DEP_COST_SCALE_LOG2);
+            tpl_stats.recrf_rate = rate_cost << TPL_DEP_COST_SCALE_LOG2;
+            if (best_mode != NEWMV) {
+                tpl_stats.srcrf_dist = recon_error << (TPL_DEP_COST_SCALE_LOG2);
+                tpl_stats.srcrf_rate = rate_cost << TPL_DEP_COST_SCALE_LOG2;
+            }
+            tpl_stats.recrf_dist = AOMMAX(tpl_stats.srcrf_dist, tpl_stats.recrf_dist);
+            tpl_stats.recrf_rate = AOMMAX(tpl_stats.srcrf_rate, tpl_stats.recrf_rate);
+            if (!frame_is_intra_only(pcs_ptr) && tpl_src_stats_ptr->best_rf_idx != -1) {
+                tpl_stats.mv = tpl_src_stats_ptr->mv;
+                tpl_stats.ref_frame_poc = tpl_src_stats_ptr->ref_frame_poc;
+            }
+            // Motion flow dependency dispenser.
+            result_model_store(pcs_ptr, &tpl_stats, mb_origin_x, mb_origin_y);
         }
     }
     // padding current recon picture
@@ -1163,11 +1272,78 @@ static void generate_r0beta(PictureParentControlSet *pcs_ptr)
     return;
 }
 
+/************************************************
+* Check if the TPL recon of a picture depends on the recon
+* of one of the sliding window pictures flagged as changed
+************************************************/
+static EbBool is_tpl_rec_changed(
+    EncodeContext                   *encode_context_ptr,
+    PictureParentControlSet         *pcs_ptr,
+    const EbBool                     is_rec_changed[MAX_TPL_LA_SW])
+{
+    uint32_t picture_width_in_mb  = (pcs_ptr->enhanced_picture_ptr->width  + 16 - 1) / 16;
+    uint32_t picture_height_in_mb = (pcs_ptr->enhanced_picture_ptr->height + 16 - 1) / 16;
+
+    for (uint32_t mb_index = 0; mb_index < picture_width_in_mb * picture_height_in_mb; mb_index++) {
+        const TplSrcStats *tpl_src_stats_ptr = &pcs_ptr->tpl_src_stats_buffer[mb_index];
+        if (tpl_src_stats_ptr->best_mode != NEWMV)
+            continue;
+        uint32_t ref_frame_idx = 0;
+        while(ref_frame_idx < MAX_TPL_LA_SW && encode_context_ptr->poc_map_idx[ref_frame_idx] != tpl_src_stats_ptr->ref_frame_poc)
+            ref_frame_idx++;
+        if (ref_frame_idx == MAX_TPL_LA_SW || is_rec_changed[ref_frame_idx])
+            return EB_TRUE;
+    }
+    return EB_FALSE;
+}
+
+/************************************************
+* Dispense the TPL source stats of the sliding window
+** One task per 64x64 SB row of each picture is sent to
+** the TPL dispenser threads; returns once all are done.
+************************************************/
+static void tpl_mc_flow_dispenser_src(
+    InitialRateControlContext       *context_ptr,
+    EncodeContext                   *encode_context_ptr,
+    SequenceControlSet              *scs_ptr,
+    PictureParentControlSet         *pcs_array[MAX_TPL_LA_SW],
+    int32_t                          start_frame_idx,
+    int32_t                          end_frame_idx)
+{
+    EbObjectWrapper *out_task_wrapper_ptr;
+    uint32_t         seg_total_count = 0;
+
+    for (int32_t frame_idx = start_frame_idx; frame_idx < end_frame_idx; frame_idx++) {
+        tpl_mc_flow_quantizer_init(scs_ptr, pcs_array[frame_idx]);
+        seg_total_count += (pcs_array[frame_idx]->sb_total_count + scs_ptr->pic_width_in_sb - 1) / scs_ptr->pic_width_in_sb;
+    }
+    if (seg_total_count == 0)
+        return;
+    encode_context_ptr->tpl_disp_seg_acc         = 0;
+    encode_context_ptr->tpl_disp_seg_total_count = seg_total_count;
+
+    for (int32_t frame_idx = start_frame_idx; frame_idx < end_frame_idx; frame_idx++) {
+        PictureParentControlSet *pcs_ptr = pcs_array[frame_idx];
+        uint32_t sb_row_count = (pcs_ptr->sb_total_count + scs_ptr->pic_width_in_sb - 1) / scs_ptr->pic_width_in_sb;
+        for (uint32_t sb_row = 0; sb_row < sb_row_count; sb_row++) {
+            svt_get_empty_object(context_ptr->tpl_disp_tasks_output_fifo_ptr,
+                                 &out_task_wrapper_ptr);
+            TplDispenserTasks *out_task_ptr = (TplDispenserTasks *)out_task_wrapper_ptr->object_ptr;
+            out_task_ptr->pcs_wrapper_ptr = pcs_ptr->p_pcs_wrapper_ptr;
+            out_task_ptr->frame_idx       = frame_idx;
+            out_task_ptr->sb_row_index    = (uint16_t)sb_row;
+            svt_post_full_object(out_task_wrapper_ptr);
+        }
+    }
+    svt_block_on_semaphore(encode_context_ptr->tpl_disp_done_semaphore);
+}
+
 /************************************************
 * Genrate TPL MC Flow Based on Lookahead
 ** LAD Window: sliding window size
 ************************************************/
 EbErrorType tpl_mc_flow(
+    InitialRateControlContext       *context_ptr,
     EncodeContext                   *encode_context_ptr,
     SequenceControlSet              *scs_ptr,
     PictureParentControlSet         *pcs_ptr)
@@ -1243,7 +1419,11 @@ EbErrorType tpl_mc_flow(
         // dispenser I0 or frame_idx0 pic in LA1
         int32_t sw_length = MIN(17, (frames_in_sw));
         EbPictureBufferDesc *input_picture_ptr = pcs_array[0]->enhanced_picture_ptr;
-        encode_context_ptr->poc_map_idx[0] = pcs_array[0]->picture_number;
+        for (int32_t frame_idx = 0; frame_idx < sw_length; frame_idx++)
+            encode_context_ptr->poc_map_idx[frame_idx] = pcs_array[frame_idx]->picture_number;
+        // The source stats do not depend on the TPL recon pictures, so they are
+        // dispensed once, in parallel, for both dispenser passes below
+        tpl_mc_flow_dispenser_src(context_ptr, encode_context_ptr, scs_ptr, pcs_array, start_is_intra ? 0 : 1, sw_length);
         for(int32_t frame_idx = 0; frame_idx < sw_length; frame_idx++) {
             if (!start_is_intra && frame_idx == 0) {
                 uint8_t *dst_buffer = encode_context_ptr->mc_flow_rec_picture_buffer[0];
@@ -1267,6 +1447,11 @@ EbErrorType tpl_mc_flow(
         // The second part is for the next base layer frame to use the available pictures.
         // i.e. POC 16 have access to picture 1,2,...15. So dispenser and synthesizer are called.
         // In the next call, the stats for POC 16 is updated using pictures 17,... 32
+        // Only the pictures whose recon changes, i.e. the ones inter predicted (directly or
+        // not) from the frame_idx0 recon when it is replaced by its input, are dispensed again.
+        // The dispenser output of the others is the one of the first part.
+        EbBool is_rec_changed[MAX_TPL_LA_SW] = { EB_FALSE };
+        is_rec_changed[0] = sw_length > 1 && pcs_array[1]->temporal_layer_index == 0;
         encode_context_ptr->poc_map_idx[0] = pcs_array[0]->picture_number;
         for (int32_t frame_idx = 1; frame_idx < sw_length; frame_idx++) {
             encode_context_ptr->poc_map_idx[frame_idx] = pcs_array[frame_idx]->picture_number;
@@ -1278,11 +1463,20 @@ EbErrorType tpl_mc_flow(
                            (pcs_array[0]->enhanced_picture_ptr->origin_y * 2 +
                             pcs_array[0]->enhanced_picture_ptr->height));
             }
-            for (uint32_t blky = 0; blky < (picture_height_in_mb << shift); blky++) {
-                memset(pcs_array[frame_idx]->tpl_stats[blky * (picture_width_in_mb << shift)], 0, (picture_width_in_mb << shift) * sizeof(TplStats));
-            }
+            is_rec_changed[frame_idx] = is_tpl_rec_changed(encode_context_ptr, pcs_array[frame_idx], is_rec_changed);
+            if (is_rec_changed[frame_idx]) {
+                for (uint32_t blky = 0; blky < (picture_height_in_mb << shift); blky++) {
+                    memset(pcs_array[frame_idx]->tpl_stats[blky * (picture_width_in_mb << shift)], 0, (picture_width_in_mb << shift) * sizeof(TplStats));
+                }
 
-            tpl_mc_flow_dispenser(encode_context_ptr, scs_ptr, pcs_array[frame_idx], frame_idx);
+                tpl_mc_flow_dispenser(encode_context_ptr, scs_ptr, pcs_array[frame_idx], frame_idx);
+            } else {
+                // reset the costs propagated by the synthesizer of the first part
+                for (uint32_t blk_idx = 0; blk_idx < (picture_height_in_mb << shift) * (picture_width_in_mb << shift); blk_idx++) {
+                    pcs_array[frame_idx]->tpl_stats[blk_idx]->mc_dep_dist = 0;
+                    pcs_array[frame_idx]->tpl_stats[blk_idx]->mc_dep_rate = 0;
+                }
+            }
             if (frame_idx == 1 && pcs_array[frame_idx]->temporal_layer_index == 0) {
                 // save frame_idx1 picture buffer for next LA
                 memcpy(encode_context_ptr->mc_flow_rec_picture_buffer_saved, encode_context_ptr->mc_flow_rec_picture_buffer[frame_idx], input_picture_ptr->stride_y * (input_picture_ptr->origin_y * 2 + input_picture_ptr->height));
@@ -1361,7 +1555,8 @@ void *initial_rate_control_kernel(void *input_ptr) {
 
         // If the picture is complete, proceed
         if (SEGMENT_COMPLETION_MASK_TEST(pcs_ptr->me_segments_completion_mask,
-                                         pcs_ptr->me_segments_total_count)) {
+                                         pcs_ptr->me_segments_total_count +
+                                             pcs_ptr->gm_segments_total_count)) {
             SequenceControlSet *scs_ptr = (SequenceControlSet *)
                                               pcs_ptr->scs_wrapper_ptr->object_ptr;
             EncodeContext *encode_context_ptr = (EncodeContext *)scs_ptr->encode_context_ptr;
@@ -1577,7 +1772,7 @@ void *initial_rate_control_kernel(void *input_ptr) {
                         if (scs_ptr->static_config.look_ahead_distance != 0 &&
                             scs_ptr->static_config.enable_tpl_la &&
                             pcs_ptr->temporal_layer_index == 0) {
-                            tpl_mc_flow(encode_context_ptr, scs_ptr, pcs_ptr);
+                            tpl_mc_flow(context_ptr, encode_context_ptr, scs_ptr, pcs_ptr);
                         }
                         // Get Empty Results Object
                         svt_get_empty_object(
@@ -1625,3 +1820,34 @@ void *initial_rate_control_kernel(void *input_ptr) {
     }
     return NULL;
 }
+
+/* TPL Dispenser Kernel */
+void *tpl_disp_kernel(void *input_ptr) {
+    EbThreadContext *thread_context_ptr = (EbThreadContext *)input_ptr;
+    TplDispContext * context_ptr        = (TplDispContext *)thread_context_ptr->priv;
+    EbObjectWrapper *in_task_wrapper_ptr;
+
+    for (;;) {
+        // Get Input Full Object
+        EB_GET_FULL_OBJECT(context_ptr->tpl_disp_tasks_input_fifo_ptr, &in_task_wrapper_ptr);
+
+        TplDispenserTasks *      in_task_ptr = (TplDispenserTasks *)in_task_wrapper_ptr->object_ptr;
+        PictureParentControlSet *pcs_ptr     = (PictureParentControlSet *)
+                                               in_task_ptr->pcs_wrapper_ptr->object_ptr;
+        SequenceControlSet *scs_ptr = (SequenceControlSet *)pcs_ptr->scs_wrapper_ptr->object_ptr;
+        EncodeContext *     encode_context_ptr = scs_ptr->encode_context_ptr;
+
+        tpl_mc_flow_dispenser_src_sb_row(
+            encode_context_ptr, scs_ptr, pcs_ptr, in_task_ptr->frame_idx, in_task_ptr->sb_row_index);
+
+        // Release the Input Task
+        svt_release_object(in_task_wrapper_ptr);
+
+        svt_block_on_mutex(encode_context_ptr->tpl_disp_mutex);
+        encode_context_ptr->tpl_disp_seg_acc++;
+        if (encode_context_ptr->tpl_disp_seg_acc == encode_context_ptr->tpl_disp_seg_total_count)
+            svt_post_semaphore(encode_context_ptr->tpl_disp_done_semaphore);
+        svt_release_mutex(encode_context_ptr->tpl_disp_mutex);
+    }
+    return NULL;
+}
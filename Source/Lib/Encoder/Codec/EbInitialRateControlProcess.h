@@ -24,4 +24,9 @@ EbErrorType initial_rate_control_context_ctor(EbThreadContext *  thread_context_
 
 extern void *initial_rate_control_kernel(void *input_ptr);
 
+EbErrorType tpl_disp_context_ctor(EbThreadContext *  thread_context_ptr,
+                                  const EbEncHandle *enc_handle_ptr, int index);
+
+extern void *tpl_disp_kernel(void *input_ptr);
+
 #endif // EbInitialRateControl_h
@@ -11,6 +11,7 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "EbMdRateEstimation.h"
 #include "EbCommonUtils.h"
@@ -63,235 +64,327 @@ void av1_get_syntax_rate_from_cdf(int32_t *costs, const AomCdfProb *cdf, const i
 }
 int av1_filter_intra_allowed_bsize(uint8_t enable_filter_intra, BlockSize bs);
 
+// The costs of a CDF are only recomputed when it differs from prev_fc, the CDFs the table was
+// last built from (all of them are computed when prev_fc is NULL).
+#define CDF_CHANGED(fc, prev_fc, cdf) \
+    (!(prev_fc) || memcmp((prev_fc)->cdf, (fc)->cdf, sizeof((fc)->cdf)))
+#define UPDATE_RATE_FROM_CDF(fc, prev_fc, costs, cdf, inv_map)               \
+    do {                                                                     \
+        if (CDF_CHANGED(fc, prev_fc, cdf))                                   \
+            av1_get_syntax_rate_from_cdf(costs, (fc)->cdf, inv_map);         \
+    } while (0)
+
 /*************************************************************
 * av1_estimate_syntax_rate()
 * Estimate the rate for each syntax elements and for
 * all scenarios based on the frame CDF
 **************************************************************/
 void av1_estimate_syntax_rate(MdRateEstimationContext *md_rate_estimation_array, EbBool is_i_slice,
-                              FRAME_CONTEXT *fc) {
+                              FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc) {
     int32_t i, j;
 
     md_rate_estimation_array->initialized = 1;
 
     for (i = 0; i < PARTITION_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->partition_fac_bits[i], fc->partition_cdf[i], NULL);
+        UPDATE_RATE_FROM_CDF(
+            fc, prev_fc, md_rate_estimation_array->partition_fac_bits[i], partition_cdf[i], NULL);
 
     //if (cm->skip_mode_flag) { // NM - Hardcoded to true
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_mode_fac_bits[i], fc->skip_mode_cdfs[i], NULL);
+        UPDATE_RATE_FROM_CDF(
+            fc, prev_fc, md_rate_estimation_array->skip_mode_fac_bits[i], skip_mode_cdfs[i], NULL);
     //}
 
     for (i = 0; i < SKIP_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->skip_fac_bits[i], fc->skip_cdfs[i], NULL);
+        UPDATE_RATE_FROM_CDF(
+            fc, prev_fc, md_rate_estimation_array->skip_fac_bits[i], skip_cdfs[i], NULL);
     for (i = 0; i < KF_MODE_CONTEXTS; ++i)
         for (j = 0; j < KF_MODE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->y_mode_fac_bits[i][j], fc->kf_y_cdf[i][j], NULL);
+            UPDATE_RATE_FROM_CDF(
+                fc, prev_fc, md_rate_estimation_array->y_mode_fac_bits[i][j], kf_y_cdf[i][j], NULL);
 
     for (i = 0; i < BlockSize_GROUPS; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->mb_mode_fac_bits[i], fc->y_mode_cdf[i], NULL);
+        UPDATE_RATE_FROM_CDF(
+            fc, prev_fc, md_rate_estimation_array->mb_mode_fac_bits[i], y_mode_cdf[i], NULL);
 
     for (i = 0; i < CFL_ALLOWED_TYPES; ++i) {
         for (j = 0; j < INTRA_MODES; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
-                                         fc->uv_mode_cdf[i][j],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->intra_uv_mode_fac_bits[i][j],
+                                 uv_mode_cdf[i][j],
+                                 NULL);
     }
 
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->filter_intra_mode_fac_bits, fc->filter_intra_mode_cdf, NULL);
+    UPDATE_RATE_FROM_CDF(fc,
+                         prev_fc,
+                         md_rate_estimation_array->filter_intra_mode_fac_bits,
+                         filter_intra_mode_cdf,
+                         NULL);
     for (i = 0; i < BlockSizeS_ALL; ++i) {
         if (av1_filter_intra_allowed_bsize(1, i))
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->filter_intra_fac_bits[i], fc->filter_intra_cdfs[i], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->filter_intra_fac_bits[i],
+                                 filter_intra_cdfs[i],
+                                 NULL);
     }
     for (i = 0; i < SWITCHABLE_FILTER_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->switchable_interp_fac_bitss[i],
-                                     fc->switchable_interp_cdf[i],
-                                     NULL);
+        UPDATE_RATE_FROM_CDF(fc,
+                             prev_fc,
+                             md_rate_estimation_array->switchable_interp_fac_bitss[i],
+                             switchable_interp_cdf[i],
+                             NULL);
 
     for (i = 0; i < PALATTE_BSIZE_CTXS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->palette_ysize_fac_bits[i], fc->palette_y_size_cdf[i], NULL);
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_size_fac_bits[i],
-                                     fc->palette_uv_size_cdf[i],
-                                     NULL);
+        UPDATE_RATE_FROM_CDF(fc,
+                             prev_fc,
+                             md_rate_estimation_array->palette_ysize_fac_bits[i],
+                             palette_y_size_cdf[i],
+                             NULL);
+        UPDATE_RATE_FROM_CDF(fc,
+                             prev_fc,
+                             md_rate_estimation_array->palette_uv_size_fac_bits[i],
+                             palette_uv_size_cdf[i],
+                             NULL);
         for (j = 0; j < PALETTE_Y_MODE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ymode_fac_bits[i][j],
-                                         fc->palette_y_mode_cdf[i][j],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->palette_ymode_fac_bits[i][j],
+                                 palette_y_mode_cdf[i][j],
+                                 NULL);
     }
 
     for (i = 0; i < PALETTE_UV_MODE_CONTEXTS; ++i)
-        av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_mode_fac_bits[i],
-                                     fc->palette_uv_mode_cdf[i],
-                                     NULL);
+        UPDATE_RATE_FROM_CDF(fc,
+                             prev_fc,
+                             md_rate_estimation_array->palette_uv_mode_fac_bits[i],
+                             palette_uv_mode_cdf[i],
+                             NULL);
     for (i = 0; i < PALETTE_SIZES; ++i) {
         for (j = 0; j < PALETTE_COLOR_INDEX_CONTEXTS; ++j) {
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_ycolor_fac_bitss[i][j],
-                                         fc->palette_y_color_index_cdf[i][j],
-                                         NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->palette_uv_color_fac_bits[i][j],
-                                         fc->palette_uv_color_index_cdf[i][j],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->palette_ycolor_fac_bitss[i][j],
+                                 palette_y_color_index_cdf[i][j],
+                                 NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->palette_uv_color_fac_bits[i][j],
+                                 palette_uv_color_index_cdf[i][j],
+                                 NULL);
         }
     }
 
-    int32_t sign_fac_bits[CFL_JOINT_SIGNS];
-    av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
-    for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
-        int32_t *fac_bits_u = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
-        int32_t *fac_bits_v = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
-        if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
-        else {
-            const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
-            av1_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
-        }
-        if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
-            memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
-        else {
-            int32_t cdf_index = CFL_CONTEXT_V(joint_sign);
-            if ((cdf_index < CFL_ALPHA_CONTEXTS) && (cdf_index >= 0)) {
-                const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[cdf_index];
-                av1_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+    if (CDF_CHANGED(fc, prev_fc, cfl_sign_cdf) || CDF_CHANGED(fc, prev_fc, cfl_alpha_cdf)) {
+        int32_t sign_fac_bits[CFL_JOINT_SIGNS];
+        av1_get_syntax_rate_from_cdf(sign_fac_bits, fc->cfl_sign_cdf, NULL);
+        for (int32_t joint_sign = 0; joint_sign < CFL_JOINT_SIGNS; joint_sign++) {
+            int32_t *fac_bits_u = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_U];
+            int32_t *fac_bits_v = md_rate_estimation_array->cfl_alpha_fac_bits[joint_sign][CFL_PRED_V];
+            if (CFL_SIGN_U(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_u, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_u));
+            else {
+                const AomCdfProb *cdf_u = fc->cfl_alpha_cdf[CFL_CONTEXT_U(joint_sign)];
+                av1_get_syntax_rate_from_cdf(fac_bits_u, cdf_u, NULL);
             }
+            if (CFL_SIGN_V(joint_sign) == CFL_SIGN_ZERO)
+                memset(fac_bits_v, 0, CFL_ALPHABET_SIZE * sizeof(*fac_bits_v));
+            else {
+                int32_t cdf_index = CFL_CONTEXT_V(joint_sign);
+                if ((cdf_index < CFL_ALPHA_CONTEXTS) && (cdf_index >= 0)) {
+                    const AomCdfProb *cdf_v = fc->cfl_alpha_cdf[cdf_index];
+                    av1_get_syntax_rate_from_cdf(fac_bits_v, cdf_v, NULL);
+                }
+            }
+            for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
         }
-        for (int32_t u = 0; u < CFL_ALPHABET_SIZE; u++) fac_bits_u[u] += sign_fac_bits[joint_sign];
     }
 
     for (i = 0; i < MAX_TX_CATS; ++i)
         for (j = 0; j < TX_SIZE_CONTEXTS; ++j)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->tx_size_fac_bits[i][j], fc->tx_size_cdf[i][j], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->tx_size_fac_bits[i][j],
+                                 tx_size_cdf[i][j],
+                                 NULL);
 
     for (i = 0; i < TXFM_PARTITION_CONTEXTS; ++i) {
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->txfm_partition_fac_bits[i], fc->txfm_partition_cdf[i], NULL);
+        UPDATE_RATE_FROM_CDF(fc,
+                             prev_fc,
+                             md_rate_estimation_array->txfm_partition_fac_bits[i],
+                             txfm_partition_cdf[i],
+                             NULL);
     }
 
     for (i = TX_4X4; i < EXT_TX_SIZES; ++i) {
         int32_t s;
         for (s = 1; s < EXT_TX_SETS_INTER; ++s) {
             if (use_inter_ext_tx_for_txsize[s][i])
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
-                                             fc->inter_ext_tx_cdf[s][i],
-                                             av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->inter_tx_type_fac_bits[s][i],
+                                     inter_ext_tx_cdf[s][i],
+                                     av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[1][s]]);
         }
         for (s = 1; s < EXT_TX_SETS_INTRA; ++s) {
             if (use_intra_ext_tx_for_txsize[s][i]) {
                 for (j = 0; j < INTRA_MODES; ++j)
-                    av1_get_syntax_rate_from_cdf(
-                        md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
-                        fc->intra_ext_tx_cdf[s][i][j],
-                        av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
+                    UPDATE_RATE_FROM_CDF(fc,
+                                         prev_fc,
+                                         md_rate_estimation_array->intra_tx_type_fac_bits[s][i][j],
+                                         intra_ext_tx_cdf[s][i][j],
+                                         av1_ext_tx_inv[av1_ext_tx_set_idx_to_type[0][s]]);
             }
         }
     }
     for (i = 0; i < DIRECTIONAL_MODES; ++i)
-        av1_get_syntax_rate_from_cdf(
-            md_rate_estimation_array->angle_delta_fac_bits[i], fc->angle_delta_cdf[i], NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->switchable_restore_fac_bits, fc->switchable_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->wiener_restore_fac_bits, fc->wiener_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(
-        md_rate_estimation_array->sgrproj_restore_fac_bits, fc->sgrproj_restore_cdf, NULL);
-    av1_get_syntax_rate_from_cdf(md_rate_estimation_array->intrabc_fac_bits, fc->intrabc_cdf, NULL);
+        UPDATE_RATE_FROM_CDF(fc,
+                             prev_fc,
+                             md_rate_estimation_array->angle_delta_fac_bits[i],
+                             angle_delta_cdf[i],
+                             NULL);
+    UPDATE_RATE_FROM_CDF(fc,
+                         prev_fc,
+                         md_rate_estimation_array->switchable_restore_fac_bits,
+                         switchable_restore_cdf,
+                         NULL);
+    UPDATE_RATE_FROM_CDF(
+        fc, prev_fc, md_rate_estimation_array->wiener_restore_fac_bits, wiener_restore_cdf, NULL);
+    UPDATE_RATE_FROM_CDF(
+        fc, prev_fc, md_rate_estimation_array->sgrproj_restore_fac_bits, sgrproj_restore_cdf, NULL);
+    UPDATE_RATE_FROM_CDF(
+        fc, prev_fc, md_rate_estimation_array->intrabc_fac_bits, intrabc_cdf, NULL);
 
     if (!is_i_slice) { // NM - Hardcoded to true
         for (i = 0; i < COMP_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_inter_fac_bits[i], fc->comp_inter_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_inter_fac_bits[i],
+                                 comp_inter_cdf[i],
+                                 NULL);
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < SINGLE_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->single_ref_fac_bits[i][j],
-                                             fc->single_ref_cdf[i][j],
-                                             NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->single_ref_fac_bits[i][j],
+                                     single_ref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < COMP_REF_TYPE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_type_fac_bits[i],
-                                         fc->comp_ref_type_cdf[i],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_ref_type_fac_bits[i],
+                                 comp_ref_type_cdf[i],
+                                 NULL);
         for (i = 0; i < UNI_COMP_REF_CONTEXTS; ++i) {
             for (j = 0; j < UNIDIR_COMP_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
-                                             fc->uni_comp_ref_cdf[i][j],
-                                             NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->uni_comp_ref_fac_bits[i][j],
+                                     uni_comp_ref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < FWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_ref_fac_bits[i][j],
-                                             fc->comp_ref_cdf[i][j],
-                                             NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->comp_ref_fac_bits[i][j],
+                                     comp_ref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < REF_CONTEXTS; ++i) {
             for (j = 0; j < BWD_REFS - 1; ++j)
-                av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
-                                             fc->comp_bwdref_cdf[i][j],
-                                             NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->comp_bwd_ref_fac_bits[i][j],
+                                     comp_bwdref_cdf[i][j],
+                                     NULL);
         }
 
         for (i = 0; i < INTRA_INTER_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->intra_inter_fac_bits[i], fc->intra_inter_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->intra_inter_fac_bits[i],
+                                 intra_inter_cdf[i],
+                                 NULL);
         for (i = 0; i < NEWMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->new_mv_mode_fac_bits[i], fc->newmv_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(
+                fc, prev_fc, md_rate_estimation_array->new_mv_mode_fac_bits[i], newmv_cdf[i], NULL);
         for (i = 0; i < GLOBALMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->zero_mv_mode_fac_bits[i], fc->zeromv_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->zero_mv_mode_fac_bits[i],
+                                 zeromv_cdf[i],
+                                 NULL);
         for (i = 0; i < REFMV_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->ref_mv_mode_fac_bits[i], fc->refmv_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(
+                fc, prev_fc, md_rate_estimation_array->ref_mv_mode_fac_bits[i], refmv_cdf[i], NULL);
         for (i = 0; i < DRL_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->drl_mode_fac_bits[i], fc->drl_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(
+                fc, prev_fc, md_rate_estimation_array->drl_mode_fac_bits[i], drl_cdf[i], NULL);
         for (i = 0; i < INTER_MODE_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_compound_mode_fac_bits[i],
-                                         fc->inter_compound_mode_cdf[i],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->inter_compound_mode_fac_bits[i],
+                                 inter_compound_mode_cdf[i],
+                                 NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->compound_type_fac_bits[i],
-                                         fc->compound_type_cdf[i],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->compound_type_fac_bits[i],
+                                 compound_type_cdf[i],
+                                 NULL);
         for (i = 0; i < BlockSizeS_ALL; ++i) {
             if (get_interinter_wedge_bits((BlockSize)i))
-                av1_get_syntax_rate_from_cdf(
-                    md_rate_estimation_array->wedge_idx_fac_bits[i], fc->wedge_idx_cdf[i], NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     md_rate_estimation_array->wedge_idx_fac_bits[i],
+                                     wedge_idx_cdf[i],
+                                     NULL);
         }
         for (i = 0; i < BlockSize_GROUPS; ++i) {
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->inter_intra_fac_bits[i], fc->interintra_cdf[i], NULL);
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->inter_intra_mode_fac_bits[i],
-                                         fc->interintra_mode_cdf[i],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->inter_intra_fac_bits[i],
+                                 interintra_cdf[i],
+                                 NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->inter_intra_mode_fac_bits[i],
+                                 interintra_mode_cdf[i],
+                                 NULL);
         }
         for (i = 0; i < BlockSizeS_ALL; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
-                                         fc->wedge_interintra_cdf[i],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->wedge_inter_intra_fac_bits[i],
+                                 wedge_interintra_cdf[i],
+                                 NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits[i], fc->motion_mode_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->motion_mode_fac_bits[i],
+                                 motion_mode_cdf[i],
+                                 NULL);
         for (i = BLOCK_8X8; i < BlockSizeS_ALL; i++)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->motion_mode_fac_bits1[i], fc->obmc_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(
+                fc, prev_fc, md_rate_estimation_array->motion_mode_fac_bits1[i], obmc_cdf[i], NULL);
         for (i = 0; i < COMP_INDEX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(
-                md_rate_estimation_array->comp_idx_fac_bits[i], fc->compound_index_cdf[i], NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_idx_fac_bits[i],
+                                 compound_index_cdf[i],
+                                 NULL);
         for (i = 0; i < COMP_GROUP_IDX_CONTEXTS; ++i)
-            av1_get_syntax_rate_from_cdf(md_rate_estimation_array->comp_group_idx_fac_bits[i],
-                                         fc->comp_group_idx_cdf[i],
-                                         NULL);
+            UPDATE_RATE_FROM_CDF(fc,
+                                 prev_fc,
+                                 md_rate_estimation_array->comp_group_idx_fac_bits[i],
+                                 comp_group_idx_cdf[i],
+                                 NULL);
     }
 }
 
@@ -352,7 +445,8 @@ void svt_av1_build_nmv_cost_table(int32_t *mvjoint, int32_t *mvcost[2], const Nm
 * based on the frame CDF
 ***************************************************************************/
 void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
-                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc)
+                          MdRateEstimationContext *md_rate_estimation_array, FRAME_CONTEXT *fc,
+                          const FRAME_CONTEXT *prev_fc)
 
 {
     int32_t *    nmvcost[2];
@@ -364,17 +458,19 @@ void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
     nmvcost_hp[0] = &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX];
     nmvcost_hp[1] = &md_rate_estimation_array->nmv_costs_hp[1][MV_MAX];
 
-    svt_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
-                                 frm_hdr->allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
-                                 &fc->nmvc,
-                                 frm_hdr->allow_high_precision_mv);
+    if (!prev_fc || memcmp(&prev_fc->nmvc, &fc->nmvc, sizeof(fc->nmvc)))
+        svt_av1_build_nmv_cost_table(md_rate_estimation_array->nmv_vec_cost, //out
+                                     frm_hdr->allow_high_precision_mv ? nmvcost_hp : nmvcost, //out
+                                     &fc->nmvc,
+                                     frm_hdr->allow_high_precision_mv);
     md_rate_estimation_array->nmvcoststack[0] =
         frm_hdr->allow_high_precision_mv ? &md_rate_estimation_array->nmv_costs_hp[0][MV_MAX]
                                          : &md_rate_estimation_array->nmv_costs[0][MV_MAX];
     md_rate_estimation_array->nmvcoststack[1] =
         frm_hdr->allow_high_precision_mv ? &md_rate_estimation_array->nmv_costs_hp[1][MV_MAX]
                                          : &md_rate_estimation_array->nmv_costs[1][MV_MAX];
-    if (frm_hdr->allow_intrabc) {
+    if (frm_hdr->allow_intrabc &&
+        (!prev_fc || memcmp(&prev_fc->ndvc, &fc->ndvc, sizeof(fc->ndvc)))) {
         int32_t *dvcost[2] = {&md_rate_estimation_array->dv_cost[0][MV_MAX],
                               &md_rate_estimation_array->dv_cost[1][MV_MAX]};
         svt_av1_build_nmv_cost_table(
@@ -386,8 +482,22 @@ void av1_estimate_mv_rate(PictureControlSet *      pcs_ptr,
 * Estimate the rate of the quantised coefficient
 * based on the frame CDF
 ***************************************************************************/
+static const AomCdfProb *get_eob_flag_cdf(const FRAME_CONTEXT *fc, int eob_multi_size, int plane,
+                                          int ctx) {
+    switch (eob_multi_size) {
+    case 0: return fc->eob_flag_cdf16[plane][ctx];
+    case 1: return fc->eob_flag_cdf32[plane][ctx];
+    case 2: return fc->eob_flag_cdf64[plane][ctx];
+    case 3: return fc->eob_flag_cdf128[plane][ctx];
+    case 4: return fc->eob_flag_cdf256[plane][ctx];
+    case 5: return fc->eob_flag_cdf512[plane][ctx];
+    case 6:
+    default: return fc->eob_flag_cdf1024[plane][ctx];
+    }
+}
+
 void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_array,
-                                    FRAME_CONTEXT *          fc) {
+                                    FRAME_CONTEXT *fc, const FRAME_CONTEXT *prev_fc) {
     const int32_t num_planes     = 3; // NM - Hardcoded to 3
     const int32_t nplanes        = AOMMIN(num_planes, PLANE_TYPES);
 
@@ -395,18 +505,12 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
         for (int plane = 0; plane < nplanes; ++plane) {
             LvMapEobCost *pcost = &md_rate_estimation_array->eob_frac_bits[eob_multi_size][plane];
             for (int ctx = 0; ctx < 2; ++ctx) {
-                AomCdfProb *pcdf;
-                switch (eob_multi_size) {
-                case 0: pcdf = fc->eob_flag_cdf16[plane][ctx]; break;
-                case 1: pcdf = fc->eob_flag_cdf32[plane][ctx]; break;
-                case 2: pcdf = fc->eob_flag_cdf64[plane][ctx]; break;
-                case 3: pcdf = fc->eob_flag_cdf128[plane][ctx]; break;
-                case 4: pcdf = fc->eob_flag_cdf256[plane][ctx]; break;
-                case 5: pcdf = fc->eob_flag_cdf512[plane][ctx]; break;
-                case 6:
-                default: pcdf = fc->eob_flag_cdf1024[plane][ctx]; break;
-                }
-                av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
+                const AomCdfProb *pcdf = get_eob_flag_cdf(fc, eob_multi_size, plane, ctx);
+                if (!prev_fc ||
+                    memcmp(get_eob_flag_cdf(prev_fc, eob_multi_size, plane, ctx),
+                           pcdf,
+                           CDF_SIZE(5 + eob_multi_size) * sizeof(*pcdf)))
+                    av1_get_syntax_rate_from_cdf(pcost->eob_cost[ctx], pcdf, NULL);
             }
         }
     }
@@ -415,15 +519,18 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
             LvMapCoeffCost *pcost = &md_rate_estimation_array->coeff_fac_bits[tx_size][plane];
 
             for (int ctx = 0; ctx < TXB_SKIP_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->txb_skip_cost[ctx], fc->txb_skip_cdf[tx_size][ctx], NULL);
+                UPDATE_RATE_FROM_CDF(
+                    fc, prev_fc, pcost->txb_skip_cost[ctx], txb_skip_cdf[tx_size][ctx], NULL);
 
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS_EOB; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_eob_cost[ctx], fc->coeff_base_eob_cdf[tx_size][plane][ctx], NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     pcost->base_eob_cost[ctx],
+                                     coeff_base_eob_cdf[tx_size][plane][ctx],
+                                     NULL);
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->base_cost[ctx], fc->coeff_base_cdf[tx_size][plane][ctx], NULL);
+                UPDATE_RATE_FROM_CDF(
+                    fc, prev_fc, pcost->base_cost[ctx], coeff_base_cdf[tx_size][plane][ctx], NULL);
             for (int ctx = 0; ctx < SIG_COEF_CONTEXTS; ++ctx) {
                 pcost->base_cost[ctx][4] = 0;
                 pcost->base_cost[ctx][5] =
@@ -432,14 +539,20 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
                 pcost->base_cost[ctx][7] = pcost->base_cost[ctx][3] - pcost->base_cost[ctx][2];
             }
             for (int ctx = 0; ctx < EOB_COEF_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->eob_extra_cost[ctx], fc->eob_extra_cdf[tx_size][plane][ctx], NULL);
+                UPDATE_RATE_FROM_CDF(fc,
+                                     prev_fc,
+                                     pcost->eob_extra_cost[ctx],
+                                     eob_extra_cdf[tx_size][plane][ctx],
+                                     NULL);
 
             for (int ctx = 0; ctx < DC_SIGN_CONTEXTS; ++ctx)
-                av1_get_syntax_rate_from_cdf(
-                    pcost->dc_sign_cost[ctx], fc->dc_sign_cdf[plane][ctx], NULL);
+                UPDATE_RATE_FROM_CDF(
+                    fc, prev_fc, pcost->dc_sign_cost[ctx], dc_sign_cdf[plane][ctx], NULL);
 
             for (int ctx = 0; ctx < LEVEL_CONTEXTS; ++ctx) {
+                if (!CDF_CHANGED(
+                        fc, prev_fc, coeff_br_cdf[AOMMIN(tx_size, TX_32X32)][plane][ctx]))
+                    continue;
                 int32_t br_rate[BR_CDF_SIZE];
                 int32_t prev_cost = 0;
                 int32_t i, j;
@@ -468,6 +581,8 @@ void av1_estimate_coefficients_rate(MdRateEstimationContext *md_rate_estimation_
         }
     }
 }
+#undef UPDATE_RATE_FROM_CDF
+#undef CDF_CHANGED
 static INLINE int av1_get_skip_mode_context(const MacroBlockD *xd) {
     const MbModeInfo *const above_mi        = xd->above_mbmi;
     const MbModeInfo *const left_mi         = xd->left_mbmi;
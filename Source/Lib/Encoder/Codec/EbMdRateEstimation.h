@@ -184,28 +184,32 @@ extern "C" {
         const int32_t                  *inv_map);
     /**************************************************************************
     * Estimate the rate for each syntax elements and for
-    * all scenarios based on the frame CDF
+    * all scenarios based on the frame CDF. When prev_fc is not NULL, only the
+    * rates of the CDFs that differ from prev_fc are updated.
     ***************************************************************************/
     extern void av1_estimate_syntax_rate(
         MdRateEstimationContext      *md_rate_estimation_array,
         EbBool                          is_i_slice,
-        FRAME_CONTEXT                  *fc);
+        FRAME_CONTEXT                  *fc,
+        const FRAME_CONTEXT            *prev_fc);
     /**************************************************************************
     * Estimate the rate of the quantised coefficient
-    * based on the frame CDF
+    * based on the frame CDF (incrementally from prev_fc when not NULL)
     ***************************************************************************/
     extern void av1_estimate_coefficients_rate(
         MdRateEstimationContext  *md_rate_estimation_array,
-        FRAME_CONTEXT              *fc);
+        FRAME_CONTEXT              *fc,
+        const FRAME_CONTEXT        *prev_fc);
     /**************************************************************************
     * av1_estimate_mv_rate()
     * Estimate the rate of motion vectors
-    * based on the frame CDF
+    * based on the frame CDF (incrementally from prev_fc when not NULL)
     ***************************************************************************/
 extern void av1_estimate_mv_rate(
         struct PictureControlSet *pcs_ptr,
         MdRateEstimationContext  *md_rate_estimation_array,
-        FRAME_CONTEXT            *fc);
+        FRAME_CONTEXT            *fc,
+        const FRAME_CONTEXT      *prev_fc);
 #define AVG_CDF_WEIGHT_LEFT      3
 #define AVG_CDF_WEIGHT_TOP       1
 
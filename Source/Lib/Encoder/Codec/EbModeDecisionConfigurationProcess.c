@@ -1106,6 +1106,12 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
         memset(pcs_ptr->pred_depth_count, 0, sizeof(uint32_t) * DEPTH_DELTA_NUM * (NUMBER_OF_SHAPES-1));
         // Init tx_type selection
         memset(pcs_ptr->txt_cnt, 0, sizeof(uint32_t) * TXT_DEPTH_DELTA_NUM * TX_TYPES);
+        // Init the MD time budget from the level of the last coded picture
+        pcs_ptr->enc_dec_started        = EB_FALSE;
+        pcs_ptr->enc_dec_timed_sb_count = 0;
+        svt_block_on_mutex(scs_ptr->encode_context_ptr->md_budget_mutex);
+        pcs_ptr->md_budget_level = scs_ptr->encode_context_ptr->md_budget_level;
+        svt_release_mutex(scs_ptr->encode_context_ptr->md_budget_mutex);
         // Compute Tc, and Beta offsets for a given picture
         // Set reference cdef strength
         set_reference_cdef_strength(pcs_ptr);
@@ -1169,13 +1175,14 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
         // Initial Rate Estimation of the syntax elements
         av1_estimate_syntax_rate(md_rate_estimation_array,
             pcs_ptr->slice_type == I_SLICE ? EB_TRUE : EB_FALSE,
-            &pcs_ptr->md_frame_context);
+            &pcs_ptr->md_frame_context,
+            NULL);
         // Initial Rate Estimation of the Motion vectors
         av1_estimate_mv_rate(
-            pcs_ptr, md_rate_estimation_array, &pcs_ptr->md_frame_context);
+            pcs_ptr, md_rate_estimation_array, &pcs_ptr->md_frame_context, NULL);
         // Initial Rate Estimation of the quantized coefficients
         av1_estimate_coefficients_rate(md_rate_estimation_array,
-            &pcs_ptr->md_frame_context);
+            &pcs_ptr->md_frame_context, NULL);
         if (frm_hdr->allow_intrabc) {
             int            i;
             int            speed          = 1;
@@ -1205,119 +1212,59 @@ void *mode_decision_configuration_kernel(void *input_ptr) {
                 sf->max_exaustive_pct = intrabc_max_mesh_pct[mesh_speed];
             }
 
-            {
-                // add to hash table
+            svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
+            svt_av1_crc32c_calculator_init(&pcs_ptr->crc_calculator2);
+            // add to hash table
+            // The table is updated from the latest picture done with its table when that
+            // picture has the same size, and left as is when nothing changed.
+            EncodeContext *encode_context_ptr = scs_ptr->encode_context_ptr;
+            svt_block_on_mutex(encode_context_ptr->hash_table_mutex);
+            svt_av1_hash_table_take_latest(&pcs_ptr->hash_table,
+                                           &encode_context_ptr->hash_table_latest);
+            svt_release_mutex(encode_context_ptr->hash_table_mutex);
+            svt_av1_hash_table_prepare_update(pcs_ptr);
+            if (pcs_ptr->hash_dirty_top < pcs_ptr->hash_dirty_bottom) {
                 const int pic_width = pcs_ptr->parent_pcs_ptr->aligned_width;
                 const int pic_height = pcs_ptr->parent_pcs_ptr->aligned_height;
-
-                uint32_t *block_hash_values[2][2];
-                int8_t *  is_block_same[2][3];
                 int       k, j;
 
                 for (k = 0; k < 2; k++) {
                     for (j = 0; j < 2; j++)
-                        block_hash_values[k][j] = malloc(sizeof(uint32_t) * pic_width * pic_height);
+                        pcs_ptr->hash_block_values[k][j] =
+                            malloc(sizeof(uint32_t) * pic_width * pic_height);
                     for (j = 0; j < 3; j++)
-                        is_block_same[k][j] = malloc(sizeof(int8_t) * pic_width * pic_height);
+                        pcs_ptr->hash_is_block_same[k][j] =
+                            malloc(sizeof(int8_t) * pic_width * pic_height);
                 }
 
-                //pcs_ptr->hash_table.p_lookup_table = NULL;
-                //svt_av1_hash_table_create(&pcs_ptr->hash_table);
-
-                Yv12BufferConfig cpi_source;
-                link_eb_to_aom_buffer_desc_8bit(pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                                                &cpi_source);
-
-                svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator1, 24, 0x5D6DCB);
-                svt_av1_crc_calculator_init(&pcs_ptr->crc_calculator2, 24, 0x864CFB);
-
-                svt_av1_generate_block_2x2_hash_value(
-                    &cpi_source, block_hash_values[0], is_block_same[0], pcs_ptr);
-                svt_av1_generate_block_hash_value(&cpi_source,
-                                              4,
-                                              block_hash_values[0],
-                                              block_hash_values[1],
-                                              is_block_same[0],
-                                              is_block_same[1],
-                                              pcs_ptr);
-                svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[1],
-                                                            is_block_same[1][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            4);
-                svt_av1_generate_block_hash_value(&cpi_source,
-                                              8,
-                                              block_hash_values[1],
-                                              block_hash_values[0],
-                                              is_block_same[1],
-                                              is_block_same[0],
-                                              pcs_ptr);
-                svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[0],
-                                                            is_block_same[0][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            8);
-                svt_av1_generate_block_hash_value(&cpi_source,
-                                              16,
-                                              block_hash_values[0],
-                                              block_hash_values[1],
-                                              is_block_same[0],
-                                              is_block_same[1],
-                                              pcs_ptr);
-                svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[1],
-                                                            is_block_same[1][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            16);
-                svt_av1_generate_block_hash_value(&cpi_source,
-                                              32,
-                                              block_hash_values[1],
-                                              block_hash_values[0],
-                                              is_block_same[1],
-                                              is_block_same[0],
-                                              pcs_ptr);
-                svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[0],
-                                                            is_block_same[0][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            32);
-                svt_av1_generate_block_hash_value(&cpi_source,
-                                              64,
-                                              block_hash_values[0],
-                                              block_hash_values[1],
-                                              is_block_same[0],
-                                              is_block_same[1],
-                                              pcs_ptr);
-                svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[1],
-                                                            is_block_same[1][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            64);
-
-                svt_av1_generate_block_hash_value(&cpi_source,
-                                              128,
-                                              block_hash_values[1],
-                                              block_hash_values[0],
-                                              is_block_same[1],
-                                              is_block_same[0],
-                                              pcs_ptr);
-                svt_av1_add_to_hash_map_by_row_with_precal_data(&pcs_ptr->hash_table,
-                                                            block_hash_values[0],
-                                                            is_block_same[0][2],
-                                                            pic_width,
-                                                            pic_height,
-                                                            128);
+                // Each stage is split in segments run by the EncDec threads, and the
+                // next stage starts when all the segments are done.
+                pcs_ptr->hash_segments_total_count =
+                    (uint8_t)MAX(1, MIN(scs_ptr->enc_dec_process_init_count, HASH_SEGMENTS_MAX));
+                for (uint8_t stage = 0; stage < HASH_TABLE_BUILD_STAGES; stage++) {
+                    pcs_ptr->hash_stage               = stage;
+                    pcs_ptr->hash_segments_done_count = 0;
+                    for (uint8_t seg = 0; seg < pcs_ptr->hash_segments_total_count; seg++) {
+                        svt_get_empty_object(context_ptr->mode_decision_configuration_output_fifo_ptr,
+                                             &enc_dec_tasks_wrapper_ptr);
+                        EncDecTasks *enc_dec_tasks_ptr =
+                            (EncDecTasks *)enc_dec_tasks_wrapper_ptr->object_ptr;
+                        enc_dec_tasks_ptr->pcs_wrapper_ptr = rate_control_results_ptr->pcs_wrapper_ptr;
+                        enc_dec_tasks_ptr->input_type      = ENCDEC_TASKS_HASH_INPUT;
+                        enc_dec_tasks_ptr->hash_segment_index = seg;
+                        svt_post_full_object(enc_dec_tasks_wrapper_ptr);
+                    }
+                    svt_block_on_semaphore(pcs_ptr->hash_segments_done_semaphore);
+                }
 
+                svt_av1_hash_table_save_source(pcs_ptr);
                 for (k = 0; k < 2; k++) {
-                    for (j = 0; j < 2; j++) free(block_hash_values[k][j]);
-                    for (j = 0; j < 3; j++) free(is_block_same[k][j]);
+                    for (j = 0; j < 2; j++) free(pcs_ptr->hash_block_values[k][j]);
+                    for (j = 0; j < 3; j++) free(pcs_ptr->hash_is_block_same[k][j]);
                 }
             }
+            free(pcs_ptr->hash_dirty_sum);
+            pcs_ptr->hash_dirty_sum = NULL;
 
             svt_av1_init3smotion_compensation(
                 &pcs_ptr->ss_cfg, pcs_ptr->parent_pcs_ptr->enhanced_picture_ptr->stride_y);
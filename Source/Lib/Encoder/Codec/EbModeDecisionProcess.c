@@ -49,6 +49,16 @@ static void mode_decision_context_dctor(EbPtr p) {
     EB_FREE_ALIGNED_ARRAY(obj->cfl_temp_luma_recon16bit);
     EB_FREE_ALIGNED_ARRAY(obj->cfl_temp_luma_recon);
     if (obj->is_md_rate_estimation_ptr_owner) EB_FREE_ARRAY(obj->md_rate_estimation_ptr);
+    EB_FREE_ARRAY(obj->rate_est_fc);
+    EB_FREE_ARRAY(obj->pd_neighbor_cache);
+    EB_FREE_ARRAY(obj->nsq_neighbor_cache);
+    if (obj->subpel_plane_cache) {
+        for (int i = 0; i < MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH; i++)
+            for (int phase = 0; phase < SUBPEL_CACHE_PHASES; phase++)
+                EB_FREE_ARRAY(obj->subpel_plane_cache[i].plane[phase]);
+        EB_FREE_ARRAY(obj->subpel_plane_cache);
+    }
+    EB_FREE_ARRAY(obj->subpel_tile_pred);
     EB_FREE_ARRAY(obj->fast_candidate_array);
     EB_FREE_ARRAY(obj->fast_candidate_ptr_array);
     EB_FREE_ARRAY(obj->fast_cost_array);
@@ -88,7 +98,6 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
                                        EbFifo *mode_decision_configuration_input_fifo_ptr,
                                        EbFifo *mode_decision_output_fifo_ptr,
                                        uint8_t enable_hbd_mode_decision, uint8_t cfg_palette) {
-    uint32_t buffer_index;
     uint32_t cand_index;
     uint32_t block_max_count_sb = (sb_size == MAX_SB_SIZE) ? BLOCK_MAX_COUNT_SB_128 :
                                                              BLOCK_MAX_COUNT_SB_64;
@@ -111,6 +120,9 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
     // MD rate Estimation tables
     EB_MALLOC_ARRAY(context_ptr->md_rate_estimation_ptr, 1);
     context_ptr->is_md_rate_estimation_ptr_owner = EB_TRUE;
+    EB_MALLOC_ARRAY(context_ptr->rate_est_fc, 1);
+    EB_MALLOC_ARRAY(context_ptr->pd_neighbor_cache, MD_NEIGHBOR_CACHE_SIZE);
+    EB_MALLOC_ARRAY(context_ptr->nsq_neighbor_cache, MD_NEIGHBOR_CACHE_SIZE);
 
     EB_MALLOC_ARRAY(context_ptr->md_local_blk_unit, block_max_count_sb);
     EB_MALLOC_ARRAY(context_ptr->md_blk_arr_nsq, block_max_count_sb);
@@ -309,13 +321,26 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
            svt_picture_buffer_desc_ctor,
            (EbPtr)&double_width_picture_buffer_desc_init_data);
 
-    // Candidate Buffers
+    // Candidate Buffers: only the first one is created here (used by EncDec), the others on
+    // first use by MD and the first pass
     EB_ALLOC_PTR_ARRAY(context_ptr->candidate_buffer_ptr_array, MAX_NFL_BUFF);
-    for (buffer_index = 0; buffer_index < MAX_NFL_BUFF_Y; ++buffer_index) {
+    context_ptr->cand_buff_count_y  = 0;
+    context_ptr->cand_buff_count_uv = 0;
+    return mode_decision_alloc_candidate_buffers(context_ptr, 1, 0);
+}
+
+/******************************************************
+ * Create the candidate buffers up to count_y full buffers and count_uv chroma buffers
+ ******************************************************/
+EbErrorType mode_decision_alloc_candidate_buffers(ModeDecisionContext *context_ptr,
+                                                  uint32_t count_y, uint32_t count_uv) {
+    assert(count_y <= MAX_NFL_BUFF_Y && count_uv <= MAX_NFL_BUFF - MAX_NFL_BUFF_Y);
+    for (uint32_t buffer_index = context_ptr->cand_buff_count_y; buffer_index < count_y;
+         ++buffer_index) {
         EB_NEW(context_ptr->candidate_buffer_ptr_array[buffer_index],
                mode_decision_candidate_buffer_ctor,
                context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT,
-               sb_size,
+               context_ptr->sb_size,
                PICTURE_BUFFER_DESC_FULL_MASK,
                context_ptr->temp_residual_ptr,
                context_ptr->temp_recon_ptr,
@@ -323,13 +348,16 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
                &(context_ptr->full_cost_array[buffer_index]),
                &(context_ptr->full_cost_skip_ptr[buffer_index]),
                &(context_ptr->full_cost_merge_ptr[buffer_index]));
+        context_ptr->cand_buff_count_y = buffer_index + 1;
     }
 
-    for (buffer_index = MAX_NFL_BUFF_Y; buffer_index < MAX_NFL_BUFF; ++buffer_index) {
+    for (uint32_t buffer_index = MAX_NFL_BUFF_Y + context_ptr->cand_buff_count_uv;
+         buffer_index < MAX_NFL_BUFF_Y + count_uv;
+         ++buffer_index) {
         EB_NEW(context_ptr->candidate_buffer_ptr_array[buffer_index],
                mode_decision_candidate_buffer_ctor,
                context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT,
-               sb_size,
+               context_ptr->sb_size,
                PICTURE_BUFFER_DESC_CHROMA_MASK,
                context_ptr->temp_residual_ptr,
                context_ptr->temp_recon_ptr,
@@ -337,6 +365,7 @@ EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr, EbColor
                &(context_ptr->full_cost_array[buffer_index]),
                &(context_ptr->full_cost_skip_ptr[buffer_index]),
                &(context_ptr->full_cost_merge_ptr[buffer_index]));
+        context_ptr->cand_buff_count_uv = buffer_index + 1 - MAX_NFL_BUFF_Y;
     }
     return EB_ErrorNone;
 }
@@ -456,6 +485,7 @@ void reset_mode_decision(SequenceControlSet *scs_ptr, ModeDecisionContext *conte
         EB_FREE_ARRAY(context_ptr->md_rate_estimation_ptr);
     }
     context_ptr->md_rate_estimation_ptr = pcs_ptr->md_rate_estimation_array;
+    context_ptr->rate_est_fc_valid      = EB_FALSE;
     uint32_t cand_index;
     for (cand_index = 0; cand_index < MODE_DECISION_CANDIDATE_MAX_COUNT; ++cand_index)
         context_ptr->fast_candidate_ptr_array[cand_index]->md_rate_estimation_ptr =
@@ -218,6 +218,32 @@ typedef struct MdSubPelSearchCtrls {
     int subpel_iters_per_step;                   // Maximum number of steps in logarithmic subpel search before giving up.
     uint8_t eight_pel_search_enabled;            // 0: OFF; 1: ON
 }MdSubPelSearchCtrls;
+// Number of MD neighbor arrays saved and restored around the PD passes and the NSQ shapes,
+// each with a NEIGHBOR_ARRAY_CACHE_SIZE slot
+#define MD_NEIGHBOR_CACHE_COUNT 20
+#define MD_NEIGHBOR_CACHE_SIZE (MD_NEIGHBOR_CACHE_COUNT * NEIGHBOR_ARRAY_CACHE_SIZE)
+#define SUBPEL_CACHE_MARGIN 64 // Search margin around the SB covered by the cached planes
+#define SUBPEL_CACHE_PHASES 16 // Quarter-pel (x, y) phases, the full-pel one is not stored
+#define SUBPEL_CACHE_TILE_LOG2 3
+#define SUBPEL_CACHE_MAX_TILES ((MAX_SB_SIZE + 2 * SUBPEL_CACHE_MARGIN) >> SUBPEL_CACHE_TILE_LOG2)
+// Size of the scratch a run of tiles, up to MAX_SB_SIZE wide and a window high, is interpolated in
+#define SUBPEL_CACHE_TILE_PRED_SIZE (MAX_SB_SIZE * (MAX_SB_SIZE + 2 * SUBPEL_CACHE_MARGIN))
+/*
+ * Reference luma interpolated at the half and quarter-pel phases over the SB plus
+ * SUBPEL_CACHE_MARGIN, for the MD subpel search. The planes are filled by 8x8 tiles, when a
+ * block of the SB first reaches them, so the blocks of the other shapes and depths that
+ * search the same area read their prediction instead of interpolating it again.
+ */
+typedef struct SubpelPlaneCache {
+    uint8_t *          plane[SUBPEL_CACHE_PHASES]; // Allocated on first use
+    uint32_t           tile_valid[SUBPEL_CACHE_PHASES][SUBPEL_CACHE_MAX_TILES]; // Row bitmasks
+    SUBPEL_SEARCH_TYPE plane_filter[SUBPEL_CACHE_PHASES];
+    uint16_t           phase_used; // Phases with a plane started in the current window
+    const uint8_t *    ref; // Reference sample at the top-left of the window, NULL when unset
+    int                ref_stride;
+    int                size; // Width and height of the window
+    uint8_t *          tile_pred; // Tile interpolation scratch, shared by the caches of a context
+} SubpelPlaneCache;
 typedef struct CoeffBSwMdCtrls {
     uint8_t enabled;                // 0:  OFF; 1:  ON
     uint8_t mode_offset;            // Offset to the mode to switch to
@@ -237,10 +263,18 @@ typedef struct ModeDecisionContext {
     MdRateEstimationContext *     md_rate_estimation_ptr;
     EbBool                        is_md_rate_estimation_ptr_owner;
     struct MdRateEstimationContext rate_est_table;
+    // CDFs rate_est_table was last built from; at the next SB only the rates of the CDFs that
+    // changed are updated. Invalidated at the start of every segment.
+    FRAME_CONTEXT *               rate_est_fc;
+    EbBool                        rate_est_fc_valid;
     InterPredictionContext *      inter_prediction_context;
     MdBlkStruct *                md_local_blk_unit;
     BlkStruct *                  md_blk_arr_nsq;
     MdcSbData *mdc_sb_array;
+    // SB-local copies of the MD neighbor arrays: over the SB, restored after each PD pass,
+    // and over the square block, restored after its NSQ shapes
+    uint8_t *pd_neighbor_cache;
+    uint8_t *nsq_neighbor_cache;
 
     NeighborArrayUnit *intra_luma_mode_neighbor_array;
     NeighborArrayUnit *intra_chroma_mode_neighbor_array;
@@ -495,6 +529,9 @@ typedef struct ModeDecisionContext {
     MdSubPelSearchCtrls md_subpel_me_ctrls;
     uint8_t md_subpel_pme_level;
     MdSubPelSearchCtrls md_subpel_pme_ctrls;
+    uint8_t           md_subpel_cache_level; // 0: OFF; 1: cache the subpel planes of the SB
+    SubpelPlaneCache *subpel_plane_cache; // [list_idx * REF_LIST_MAX_DEPTH + ref_idx], allocated on first use
+    uint8_t *         subpel_tile_pred; // Tile interpolation scratch of the caches
     uint8_t      md_max_ref_count;
     RefResults    pme_res[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     ObmcControls obmc_ctrls;
@@ -526,9 +563,15 @@ typedef struct ModeDecisionContext {
     uint32_t ad_md_prob[DEPTH_DELTA_NUM][NUMBER_OF_SHAPES-1];
     uint32_t txt_cnt[TXT_DEPTH_DELTA_NUM][TX_TYPES];
     uint32_t txt_prob[TXT_DEPTH_DELTA_NUM][TX_TYPES];
+    uint8_t md_budget_level; // MD time budget level of the SB
     uint8_t skip_intra;
     EbPictureBufferDesc* temp_residual_ptr;
     EbPictureBufferDesc* temp_recon_ptr;
+    // Number of candidate buffers created so far: the full ones from index 0 and the chroma
+    // ones from index MAX_NFL_BUFF_Y. They are created on first use, so a context only holds
+    // the buffers the NICs of its presets need.
+    uint32_t             cand_buff_count_y;
+    uint32_t             cand_buff_count_uv;
     // Array for all nearest/near MVs for a block for single ref case
     MV mvp_array[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH][MAX_MVP_CANIDATES];
     // Count of all nearest/near MVs for a block for single ref case
@@ -561,6 +604,9 @@ extern EbErrorType mode_decision_context_ctor(ModeDecisionContext *context_ptr,
                                               uint8_t enable_hbd_mode_decision,
                                               uint8_t cfg_palette);
 
+extern EbErrorType mode_decision_alloc_candidate_buffers(ModeDecisionContext *context_ptr,
+                                                         uint32_t count_y, uint32_t count_uv);
+
 extern const EbAv1LambdaAssignFunc av1_lambda_assignment_function_table[4];
 
 // Table that converts 0-63 Q-range values passed in outside to the Qindex
@@ -13,6 +13,7 @@
 
 #include "EbEncHandle.h"
 #include "EbUtility.h"
+#include "aom_dsp_rtcd.h"
 #include "EbPictureControlSet.h"
 #include "EbPictureDecisionResults.h"
 #include "EbMotionEstimationProcess.h"
@@ -322,16 +323,10 @@ EbErrorType signal_derivation_me_kernel_oq(SequenceControlSet *       scs_ptr,
         context_ptr->me_context_ptr->me_search_method = FULL_SAD_SEARCH;
     else
         context_ptr->me_context_ptr->me_search_method = SUB_SAD_SEARCH;
-    if (scs_ptr->static_config.enable_global_motion == EB_TRUE &&
-        pcs_ptr->frame_superres_enabled == EB_FALSE) {
-        if (enc_mode <= ENC_M6)
-            context_ptr->me_context_ptr->compute_global_motion = EB_TRUE;
-        else
-            context_ptr->me_context_ptr->compute_global_motion = EB_FALSE;
-        //TODO: enclose all gm signals into a control
-        context_ptr->me_context_ptr->gm_identiy_exit = EB_TRUE;
-    } else
-        context_ptr->me_context_ptr->compute_global_motion = EB_FALSE;
+    // The GM segments are set at picture decision (enable_global_motion, no super-res, <= M6)
+    context_ptr->me_context_ptr->compute_global_motion = pcs_ptr->gm_segments_total_count > 0;
+    //TODO: enclose all gm signals into a control
+    context_ptr->me_context_ptr->gm_identiy_exit = EB_TRUE;
 
     // Set hme/me based reference pruning level (0-4)
     if (enc_mode <= ENC_MR)
@@ -725,6 +720,7 @@ void *motion_estimation_kernel(void *input_ptr) {
                 signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
             // Segments
             uint32_t segment_index   = in_results_ptr->segment_index;
+            EbBool   me_done         = EB_FALSE;
             uint32_t pic_width_in_sb = (pcs_ptr->aligned_width + scs_ptr->sb_sz - 1) /
                 scs_ptr->sb_sz;
             uint32_t picture_height_in_sb = (pcs_ptr->aligned_height + scs_ptr->sb_sz - 1) /
@@ -841,19 +837,20 @@ void *motion_estimation_kernel(void *input_ptr) {
                                            context_ptr->me_context_ptr,
                                            input_picture_ptr);
                         svt_block_on_mutex(pcs_ptr->me_processed_sb_mutex);
-                        pcs_ptr->me_processed_sb_count++;
+                        if (++pcs_ptr->me_processed_sb_count == pcs_ptr->sb_total_count)
+                            me_done = EB_TRUE;
                         svt_release_mutex(pcs_ptr->me_processed_sb_mutex);
                     }
                 }
             }
-            // Global motion estimation
-            // TODO: create an other kernel ?
-            if (context_ptr->me_context_ptr->compute_global_motion &&
-                // Compute only when ME of all 64x64 SBs is performed
-                pcs_ptr->me_processed_sb_count == pcs_ptr->sb_total_count) {
-
-                global_motion_estimation(
-                    pcs_ptr, context_ptr->me_context_ptr, input_picture_ptr);
+            // Global motion estimation: release the GM segments once the ME of all the SBs
+            // is performed
+            if (context_ptr->me_context_ptr->compute_global_motion && me_done) {
+                global_motion_estimation_ref_count(pcs_ptr, input_picture_ptr);
+                for (uint32_t gm_segment_index = 0;
+                     gm_segment_index < pcs_ptr->gm_segments_total_count;
+                     ++gm_segment_index)
+                    svt_post_semaphore(pcs_ptr->gm_me_done_semaphore);
             }
             if (scs_ptr->static_config.look_ahead_distance != 0 &&
                 scs_ptr->static_config.enable_tpl_la)
@@ -1028,6 +1025,32 @@ void *motion_estimation_kernel(void *input_ptr) {
             // Release the Input Results
             svt_release_object(in_results_wrapper_ptr);
 
+            // Post the Full Results Object
+            svt_post_full_object(out_results_wrapper_ptr);
+        } else if (in_results_ptr->task_type == 2) {
+            // ME Kernel Signal(s) derivation
+            signal_derivation_me_kernel_oq(scs_ptr, pcs_ptr, context_ptr);
+
+            // Global motion segment, once the ME of all the SBs is performed
+            svt_block_on_semaphore(pcs_ptr->gm_me_done_semaphore);
+            global_motion_estimation(pcs_ptr,
+                                     context_ptr->me_context_ptr,
+                                     input_picture_ptr,
+                                     in_results_ptr->segment_index);
+
+            // Get Empty Results Object
+            svt_get_empty_object(context_ptr->motion_estimation_results_output_fifo_ptr,
+                                &out_results_wrapper_ptr);
+
+            MotionEstimationResults *out_results_ptr = (MotionEstimationResults *)
+                                                           out_results_wrapper_ptr->object_ptr;
+            out_results_ptr->pcs_wrapper_ptr = in_results_ptr->pcs_wrapper_ptr;
+            out_results_ptr->segment_index   = pcs_ptr->me_segments_total_count +
+                in_results_ptr->segment_index;
+
+            // Release the Input Results
+            svt_release_object(in_results_wrapper_ptr);
+
             // Post the Full Results Object
             svt_post_full_object(out_results_wrapper_ptr);
         } else {
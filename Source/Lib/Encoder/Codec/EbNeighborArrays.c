@@ -9,6 +9,7 @@
 * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
 */
 
+#include <assert.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -949,3 +950,82 @@ void copy_neigh_arr_32(NeighborArrayUnit32 *na_src, NeighborArrayUnit32 *na_dst,
     }
     return;
 }
+
+static INLINE void cache_copy_segment(uint8_t *na_ptr, uint8_t *cache_ptr, uint32_t size,
+                                      EbBool restore) {
+    if (restore)
+        svt_memcpy(na_ptr, cache_ptr, size);
+    else
+        svt_memcpy(cache_ptr, na_ptr, size);
+}
+
+/*
+ * Saves (restore == 0) or restores (restore == 1) the segments of the neighbor array covering
+ * the block, with the same extent as copy_neigh_arr(). The top segment is kept at the start of
+ * the cache, then the left one, then the top-left one which can be twice as long.
+ */
+void neighbor_array_unit_cache_copy(NeighborArrayUnit *na_unit_ptr, uint8_t *cache,
+                                    EbBool restore, uint32_t origin_x, uint32_t origin_y,
+                                    uint32_t bw, uint32_t bh, uint32_t neighbor_array_type_mask) {
+    const uint32_t na_unit_size = na_unit_ptr->unit_size;
+    uint32_t       na_offset, size;
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
+        na_offset = get_neighbor_array_unit_top_index(na_unit_ptr, origin_x);
+        size      = na_unit_size * (bw >> na_unit_ptr->granularity_normal_log2);
+        assert(size <= NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE);
+        cache_copy_segment(na_unit_ptr->top_array + na_offset * na_unit_size, cache, size, restore);
+    }
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK) {
+        na_offset = get_neighbor_array_unit_left_index(na_unit_ptr, origin_y);
+        size      = na_unit_size * (bh >> na_unit_ptr->granularity_normal_log2);
+        assert(size <= NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE);
+        cache_copy_segment(na_unit_ptr->left_array + na_offset * na_unit_size,
+                           cache + NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE,
+                           size,
+                           restore);
+    }
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK) {
+        na_offset = get_neighbor_array_unit_top_left_index(na_unit_ptr, origin_x, origin_y + (bh - 1));
+        size      = na_unit_size * (((bw + bh) >> na_unit_ptr->granularity_top_left_log2) - 1);
+        assert(size <= 2 * NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE);
+        cache_copy_segment(na_unit_ptr->top_left_array + na_offset * na_unit_size,
+                           cache + 2 * NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE,
+                           size,
+                           restore);
+    }
+}
+
+void neighbor_array_unit_cache_copy32(NeighborArrayUnit32 *na_unit_ptr, uint8_t *cache,
+                                      EbBool restore, uint32_t origin_x, uint32_t origin_y,
+                                      uint32_t bw, uint32_t bh, uint32_t neighbor_array_type_mask) {
+    const uint32_t na_unit_size = na_unit_ptr->unit_size;
+    uint32_t       na_offset, size;
+
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOP_MASK) {
+        na_offset = get_neighbor_array_unit_top_index32(na_unit_ptr, origin_x);
+        size      = na_unit_size * (bw >> na_unit_ptr->granularity_normal_log2);
+        assert(size <= NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE);
+        cache_copy_segment(
+            (uint8_t *)(na_unit_ptr->top_array + na_offset), cache, size, restore);
+    }
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_LEFT_MASK) {
+        na_offset = get_neighbor_array_unit_left_index32(na_unit_ptr, origin_y);
+        size      = na_unit_size * (bh >> na_unit_ptr->granularity_normal_log2);
+        assert(size <= NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE);
+        cache_copy_segment((uint8_t *)(na_unit_ptr->left_array + na_offset),
+                           cache + NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE,
+                           size,
+                           restore);
+    }
+    if (neighbor_array_type_mask & NEIGHBOR_ARRAY_UNIT_TOPLEFT_MASK) {
+        na_offset =
+            get_neighbor_array_unit_top_left_index_32(na_unit_ptr, origin_x, origin_y + (bh - 1));
+        size = na_unit_size * (((bw + bh) >> na_unit_ptr->granularity_top_left_log2) - 1);
+        assert(size <= 2 * NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE);
+        cache_copy_segment((uint8_t *)(na_unit_ptr->top_left_array + na_offset),
+                           cache + 2 * NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE,
+                           size,
+                           restore);
+    }
+}
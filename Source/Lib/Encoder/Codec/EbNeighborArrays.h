@@ -142,6 +142,20 @@ void copy_neigh_arr_32(NeighborArrayUnit32 *na_src, NeighborArrayUnit32 *na_dst,
                        uint32_t origin_y, uint32_t bw, uint32_t bh,
                        uint32_t neighbor_array_type_mask);
 
+// SB-local cache of one neighbor array: the top, left and top-left segments over a block of up
+// to MAX_SB_SIZE x MAX_SB_SIZE, so a block's neighbor context can be saved and restored without
+// a picture-sized copy of the array.
+#define NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE (MAX_SB_SIZE * sizeof(uint32_t))
+#define NEIGHBOR_ARRAY_CACHE_SIZE (4 * NEIGHBOR_ARRAY_CACHE_SEGMENT_SIZE)
+
+void neighbor_array_unit_cache_copy(NeighborArrayUnit *na_unit_ptr, uint8_t *cache,
+                                    EbBool restore, uint32_t origin_x, uint32_t origin_y,
+                                    uint32_t bw, uint32_t bh, uint32_t neighbor_array_type_mask);
+
+void neighbor_array_unit_cache_copy32(NeighborArrayUnit32 *na_unit_ptr, uint8_t *cache,
+                                      EbBool restore, uint32_t origin_x, uint32_t origin_y,
+                                      uint32_t bw, uint32_t bh, uint32_t neighbor_array_type_mask);
+
 extern void neighbor_array_unit16bit_sample_write(NeighborArrayUnit *na_unit_ptr, uint16_t *src_ptr,
                                                   uint32_t stride, uint32_t src_origin_x,
                                                   uint32_t src_origin_y, uint32_t pic_origin_x,
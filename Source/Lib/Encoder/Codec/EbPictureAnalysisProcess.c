@@ -190,7 +190,7 @@ void down_sample_chroma(EbPictureBufferDesc *input_picture_ptr,
     * decimation_2d
     *      decimates the input
     ********************************************/
-void decimation_2d(uint8_t *input_samples, // input parameter, input samples Ptr
+void decimation_2d_c(uint8_t *input_samples, // input parameter, input samples Ptr
                    uint32_t input_stride, // input parameter, input stride
                    uint32_t input_area_width, // input parameter, input area width
                    uint32_t input_area_height, // input parameter, input area height
@@ -220,7 +220,7 @@ void decimation_2d(uint8_t *input_samples, // input parameter, input samples Ptr
  *      downsamples the input
  * Alternative implementation to decimation_2d that performs filtering (2x2, 0-phase)
  ********************************************/
-void downsample_2d(uint8_t *input_samples, // input parameter, input samples Ptr
+void downsample_2d_c(uint8_t *input_samples, // input parameter, input samples Ptr
                    uint32_t input_stride, // input parameter, input stride
                    uint32_t input_area_width, // input parameter, input area width
                    uint32_t input_area_height, // input parameter, input area height
@@ -258,13 +258,13 @@ void downsample_2d(uint8_t *input_samples, // input parameter, input samples Ptr
 * calculate_histogram
 *      creates n-bins histogram for the input
 ********************************************/
-void calculate_histogram(uint8_t * input_samples, // input parameter, input samples Ptr
-                         uint32_t  input_area_width, // input parameter, input area width
-                         uint32_t  input_area_height, // input parameter, input area height
-                         uint32_t  stride, // input parameter, input stride
-                         uint8_t   decim_step, // input parameter, area height
-                         uint32_t *histogram, // output parameter, output histogram
-                         uint64_t *sum) {
+void calculate_histogram_c(uint8_t * input_samples, // input parameter, input samples Ptr
+                           uint32_t  input_area_width, // input parameter, input area width
+                           uint32_t  input_area_height, // input parameter, input area height
+                           uint32_t  stride, // input parameter, input stride
+                           uint8_t   decim_step, // input parameter, area height
+                           uint32_t *histogram, // output parameter, output histogram
+                           uint64_t *sum) {
     uint32_t horizontal_index;
     uint32_t vertical_index;
     *sum = 0;
@@ -3153,50 +3153,67 @@ void pad_picture_to_multiple_of_sb_dimensions(EbPictureBufferDesc *input_padded_
 
 /************************************************
 * 1/4 & 1/16 input picture decimation
+* The 1/16 level is decimated from the 1/4 level when the latter is built
 ************************************************/
-void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
-                                         EbPictureBufferDesc *    input_padded_picture_ptr,
-                                         EbPictureBufferDesc *    quarter_decimated_picture_ptr,
-                                         EbPictureBufferDesc *    sixteenth_decimated_picture_ptr) {
+static void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
+                                                EbBool                   build_quarter,
+                                                EbPictureBufferDesc *    input_padded_picture_ptr,
+                                                EbPictureBufferDesc *    quarter_decimated_picture_ptr,
+                                                EbPictureBufferDesc *    sixteenth_decimated_picture_ptr) {
+    build_quarter = build_quarter && (pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag) &&
+        (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag);
     // Decimate input picture for HME L0 and L1
-    if (pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag) {
-        if (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag) {
-            decimation_2d(
-                &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x +
-                                                    input_padded_picture_ptr->origin_y *
-                                                        input_padded_picture_ptr->stride_y],
-                input_padded_picture_ptr->stride_y,
-                input_padded_picture_ptr->width,
-                input_padded_picture_ptr->height,
-                &quarter_decimated_picture_ptr
-                     ->buffer_y[quarter_decimated_picture_ptr->origin_x +
-                                quarter_decimated_picture_ptr->origin_x *
-                                    quarter_decimated_picture_ptr->stride_y],
-                quarter_decimated_picture_ptr->stride_y,
-                2);
-            generate_padding(&quarter_decimated_picture_ptr->buffer_y[0],
-                             quarter_decimated_picture_ptr->stride_y,
-                             quarter_decimated_picture_ptr->width,
-                             quarter_decimated_picture_ptr->height,
-                             quarter_decimated_picture_ptr->origin_x,
-                             quarter_decimated_picture_ptr->origin_y);
-        }
+    if (build_quarter) {
+        decimation_2d(
+            &input_padded_picture_ptr->buffer_y[input_padded_picture_ptr->origin_x +
+                                                input_padded_picture_ptr->origin_y *
+                                                    input_padded_picture_ptr->stride_y],
+            input_padded_picture_ptr->stride_y,
+            input_padded_picture_ptr->width,
+            input_padded_picture_ptr->height,
+            &quarter_decimated_picture_ptr
+                 ->buffer_y[quarter_decimated_picture_ptr->origin_x +
+                            quarter_decimated_picture_ptr->origin_x *
+                                quarter_decimated_picture_ptr->stride_y],
+            quarter_decimated_picture_ptr->stride_y,
+            2);
+        generate_padding(&quarter_decimated_picture_ptr->buffer_y[0],
+                         quarter_decimated_picture_ptr->stride_y,
+                         quarter_decimated_picture_ptr->width,
+                         quarter_decimated_picture_ptr->height,
+                         quarter_decimated_picture_ptr->origin_x,
+                         quarter_decimated_picture_ptr->origin_y);
     }
 
     // Always perform 1/16th decimation as
     // Sixteenth Input Picture Decimation
-    decimation_2d(
-        &input_padded_picture_ptr
-             ->buffer_y[input_padded_picture_ptr->origin_x +
-                        input_padded_picture_ptr->origin_y * input_padded_picture_ptr->stride_y],
-        input_padded_picture_ptr->stride_y,
-        input_padded_picture_ptr->width,
-        input_padded_picture_ptr->height,
-        &sixteenth_decimated_picture_ptr->buffer_y[sixteenth_decimated_picture_ptr->origin_x +
-                                                   sixteenth_decimated_picture_ptr->origin_x *
-                                                       sixteenth_decimated_picture_ptr->stride_y],
-        sixteenth_decimated_picture_ptr->stride_y,
-        4);
+    if (build_quarter)
+        decimation_2d(
+            &quarter_decimated_picture_ptr
+                 ->buffer_y[quarter_decimated_picture_ptr->origin_x +
+                            quarter_decimated_picture_ptr->origin_y *
+                                quarter_decimated_picture_ptr->stride_y],
+            quarter_decimated_picture_ptr->stride_y,
+            quarter_decimated_picture_ptr->width,
+            quarter_decimated_picture_ptr->height,
+            &sixteenth_decimated_picture_ptr->buffer_y[sixteenth_decimated_picture_ptr->origin_x +
+                                                       sixteenth_decimated_picture_ptr->origin_x *
+                                                           sixteenth_decimated_picture_ptr->stride_y],
+            sixteenth_decimated_picture_ptr->stride_y,
+            2);
+    else
+        decimation_2d(
+            &input_padded_picture_ptr
+                 ->buffer_y[input_padded_picture_ptr->origin_x +
+                            input_padded_picture_ptr->origin_y * input_padded_picture_ptr->stride_y],
+            input_padded_picture_ptr->stride_y,
+            input_padded_picture_ptr->width,
+            input_padded_picture_ptr->height,
+            &sixteenth_decimated_picture_ptr->buffer_y[sixteenth_decimated_picture_ptr->origin_x +
+                                                       sixteenth_decimated_picture_ptr->origin_x *
+                                                           sixteenth_decimated_picture_ptr->stride_y],
+            sixteenth_decimated_picture_ptr->stride_y,
+            4);
 
     generate_padding(&sixteenth_decimated_picture_ptr->buffer_y[0],
                      sixteenth_decimated_picture_ptr->stride_y,
@@ -3206,8 +3223,8 @@ void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
                      sixteenth_decimated_picture_ptr->origin_y);
 }
 
-int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows, int cols, int bit_depth,
-                                int *val_count) {
+int svt_av1_count_colors_highbd_c(uint16_t *src, int stride, int rows, int cols, int bit_depth,
+                                  int *val_count) {
     assert(bit_depth <= 12);
     const int max_pix_val = 1 << bit_depth;
     // const uint16_t *src = CONVERT_TO_SHORTPTR(src8);
@@ -3227,7 +3244,7 @@ int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows, int cols, i
     return n;
 }
 
-int svt_av1_count_colors(const uint8_t *src, int stride, int rows, int cols, int *val_count) {
+int svt_av1_count_colors_c(const uint8_t *src, int stride, int rows, int cols, int *val_count) {
     const int max_pix_val = 1 << 8;
     memset(val_count, 0, max_pix_val * sizeof(val_count[0]));
     for (int r = 0; r < rows; ++r) {
@@ -3448,10 +3465,10 @@ static void is_screen_content(PictureParentControlSet *pcs_ptr, int bit_depth) {
 /************************************************
  * 1/4 & 1/16 input picture downsampling (filtering)
  ************************************************/
-void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
-                                        EbPictureBufferDesc *    input_padded_picture_ptr,
-                                        EbPictureBufferDesc *    quarter_picture_ptr,
-                                        EbPictureBufferDesc *    sixteenth_picture_ptr) {
+static void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
+                                               EbPictureBufferDesc *    input_padded_picture_ptr,
+                                               EbPictureBufferDesc *    quarter_picture_ptr,
+                                               EbPictureBufferDesc *    sixteenth_picture_ptr) {
     // Downsample input picture for HME L0 and L1
     if (pcs_ptr->enable_hme_flag || pcs_ptr->tf_enable_hme_flag) {
         if (pcs_ptr->enable_hme_level1_flag || pcs_ptr->tf_enable_hme_level1_flag) {
@@ -3514,6 +3531,38 @@ void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
     }
 }
 
+/************************************************
+* 1/4 & 1/16 input picture pyramid
+* Builds the downsampled levels of a padded picture that are shared, through its
+* PA reference object, by ME, TF, GM and the picture statistics. Only the levels
+* that are read are built: the ME/GM/TF searches use either the filtered or the
+* decimated 1/4 & 1/16 levels, while the statistics and the ZZ SADs always use
+* the decimated 1/16 level.
+************************************************/
+void downsample_input_picture_pyramid(PictureParentControlSet *pcs_ptr,
+                                      EbPictureBufferDesc *    input_padded_picture_ptr,
+                                      EbPictureBufferDesc *    quarter_decimated_picture_ptr,
+                                      EbPictureBufferDesc *    sixteenth_decimated_picture_ptr,
+                                      EbPictureBufferDesc *    quarter_filtered_picture_ptr,
+                                      EbPictureBufferDesc *    sixteenth_filtered_picture_ptr) {
+    const EbBool filtered = pcs_ptr->scs_ptr->down_sampling_method_me_search ==
+        ME_FILTERED_DOWNSAMPLED;
+
+    // 1/4 & 1/16 input picture decimation
+    downsample_decimation_input_picture(pcs_ptr,
+                                        !filtered,
+                                        input_padded_picture_ptr,
+                                        quarter_decimated_picture_ptr,
+                                        sixteenth_decimated_picture_ptr);
+
+    // 1/4 & 1/16 input picture downsampling through filtering
+    if (filtered)
+        downsample_filtering_input_picture(pcs_ptr,
+                                           input_padded_picture_ptr,
+                                           quarter_filtered_picture_ptr,
+                                           sixteenth_filtered_picture_ptr);
+}
+
 /* Picture Analysis Kernel */
 
 /*********************************************************************************
@@ -3651,21 +3700,14 @@ void *picture_analysis_kernel(void *input_ptr) {
                 pcs_ptr->chroma_downsampled_picture_ptr = input_picture_ptr;
             // Pad input picture to complete border SBs
             pad_picture_to_multiple_of_sb_dimensions(input_padded_picture_ptr);
-            // 1/4 & 1/16 input picture decimation
-            downsample_decimation_input_picture(
-                pcs_ptr,
-                input_padded_picture_ptr,
-                (EbPictureBufferDesc *)pa_ref_obj_->quarter_decimated_picture_ptr,
-                (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_decimated_picture_ptr);
-
-            // 1/4 & 1/16 input picture downsampling through filtering
-            if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-                downsample_filtering_input_picture(
-                    pcs_ptr,
-                    input_padded_picture_ptr,
-                    (EbPictureBufferDesc *)pa_ref_obj_->quarter_filtered_picture_ptr,
-                    (EbPictureBufferDesc *)pa_ref_obj_->sixteenth_filtered_picture_ptr);
-            }
+            // 1/4 & 1/16 input picture pyramid
+            downsample_input_picture_pyramid(pcs_ptr,
+                                             input_padded_picture_ptr,
+                                             pa_ref_obj_->quarter_decimated_picture_ptr,
+                                             pa_ref_obj_->sixteenth_decimated_picture_ptr,
+                                             pa_ref_obj_->quarter_filtered_picture_ptr,
+                                             pa_ref_obj_->sixteenth_filtered_picture_ptr);
+            pa_ref_obj_->gm_corners_valid = EB_FALSE;
 
             // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
             gathering_picture_statistics(
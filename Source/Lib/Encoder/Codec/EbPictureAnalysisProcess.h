@@ -25,9 +25,11 @@ EbErrorType picture_analysis_context_ctor(EbThreadContext *  thread_context_ptr,
 extern void *picture_analysis_kernel(void *input_ptr);
 
 
-void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
-                                        EbPictureBufferDesc *    input_padded_picture_ptr,
-                                        EbPictureBufferDesc *    quarter_picture_ptr,
-                                        EbPictureBufferDesc *    sixteenth_picture_ptr);
+void downsample_input_picture_pyramid(PictureParentControlSet *pcs_ptr,
+                                      EbPictureBufferDesc *    input_padded_picture_ptr,
+                                      EbPictureBufferDesc *    quarter_decimated_picture_ptr,
+                                      EbPictureBufferDesc *    sixteenth_decimated_picture_ptr,
+                                      EbPictureBufferDesc *    quarter_filtered_picture_ptr,
+                                      EbPictureBufferDesc *    sixteenth_filtered_picture_ptr);
 
 #endif // EbPictureAnalysis_h
@@ -98,7 +98,7 @@ void picture_control_set_dctor(EbPtr p) {
     PictureControlSet *obj = (PictureControlSet *)p;
     uint16_t tile_cnt = obj->tile_row_count * obj->tile_column_count;
     uint8_t            depth;
-    svt_av1_hash_table_destroy(&obj->hash_table);
+    svt_av1_hash_table_record_destroy(&obj->hash_table);
     EB_FREE_ALIGNED_ARRAY(obj->tpl_mvs);
     EB_FREE_ALIGNED(obj->rst_tmpbuf);
     EB_DELETE_PTR_ARRAY(obj->enc_dec_segment_ctrl, tile_cnt);
@@ -184,6 +184,8 @@ void picture_control_set_dctor(EbPtr p) {
     EB_FREE_ARRAY(obj->ec_ctx_array);
     EB_DESTROY_MUTEX(obj->entropy_coding_pic_mutex);
     EB_DESTROY_MUTEX(obj->intra_mutex);
+    EB_DESTROY_MUTEX(obj->hash_segments_mutex);
+    EB_DESTROY_SEMAPHORE(obj->hash_segments_done_semaphore);
     EB_DESTROY_MUTEX(obj->cdef_search_mutex);
     EB_DESTROY_MUTEX(obj->rest_search_mutex);
 }
@@ -1036,6 +1038,9 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
 
     EB_CREATE_MUTEX(object_ptr->intra_mutex);
 
+    EB_CREATE_MUTEX(object_ptr->hash_segments_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->hash_segments_done_semaphore, 0, 1);
+
     EB_CREATE_MUTEX(object_ptr->cdef_search_mutex);
 
     //object_ptr->mse_seg[0] = (uint64_t(*)[64])svt_aom_malloc(sizeof(**object_ptr->mse_seg) *  picture_sb_width * picture_sb_height);
@@ -1073,8 +1078,8 @@ EbErrorType picture_control_set_ctor(PictureControlSet *object_ptr, EbPtr object
 
         EB_CALLOC_ALIGNED_ARRAY(object_ptr->tpl_mvs, mem_size);
     }
-    object_ptr->hash_table.p_lookup_table = NULL;
-    svt_av1_hash_table_create(&object_ptr->hash_table);
+    object_ptr->hash_table.table.p_lookup_table = NULL;
+    svt_av1_hash_table_create(&object_ptr->hash_table.table);
     EB_MALLOC_ALIGNED(object_ptr->rst_tmpbuf, RESTORATION_TMPBUF_SIZE);
     return EB_ErrorNone;
 }
@@ -1129,6 +1134,8 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
         EB_FREE_2D(obj->ois_mb_results);
     if (obj->tpl_stats)
         EB_FREE_2D(obj->tpl_stats);
+    if (obj->tpl_src_stats_buffer)
+        EB_FREE_ARRAY(obj->tpl_src_stats_buffer);
     if (obj->tpl_beta)
         EB_FREE_ARRAY(obj->tpl_beta);
     if (obj->tpl_rdmult_scaling_factors)
@@ -1168,9 +1175,12 @@ static void picture_parent_control_set_dctor(EbPtr ptr) {
 
     EB_FREE_ARRAY(obj->av1x);
     EB_DESTROY_MUTEX(obj->me_processed_sb_mutex);
+    EB_DESTROY_MUTEX(obj->gm_segments_mutex);
+    EB_DESTROY_SEMAPHORE(obj->gm_me_done_semaphore);
     EB_DESTROY_MUTEX(obj->rc_distortion_histogram_mutex);
     EB_DESTROY_SEMAPHORE(obj->temp_filt_done_semaphore);
     EB_DESTROY_MUTEX(obj->temp_filt_mutex);
+    EB_DESTROY_SEMAPHORE(obj->temp_filt_prep_done_semaphore);
     EB_DESTROY_MUTEX(obj->debug_mutex);
     EB_FREE_ARRAY(obj->tile_group_info);
     if(obj->frame_superres_enabled){
@@ -1266,6 +1276,7 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
         object_ptr->is_720p_or_larger = AOMMIN(init_data_ptr->picture_width, init_data_ptr->picture_height) >= 720;
         EB_MALLOC_2D(object_ptr->ois_mb_results, (uint32_t)(picture_width_in_mb * picture_height_in_mb), 1);
         EB_MALLOC_2D(object_ptr->tpl_stats, (uint32_t)((picture_width_in_mb << (1 - object_ptr->is_720p_or_larger)) * (picture_height_in_mb << (1 - object_ptr->is_720p_or_larger))), 1);
+        EB_MALLOC_ARRAY(object_ptr->tpl_src_stats_buffer, picture_width_in_mb * picture_height_in_mb);
         EB_MALLOC_ARRAY(object_ptr->tpl_beta, object_ptr->sb_total_count);
         EB_MALLOC_ARRAY(object_ptr->tpl_rdmult_scaling_factors, picture_width_in_mb * picture_height_in_mb);
         EB_MALLOC_ARRAY(object_ptr->tpl_sb_rdmult_scaling_factors, picture_width_in_mb * picture_height_in_mb);
@@ -1274,6 +1285,7 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
         object_ptr->is_720p_or_larger = 0;
         object_ptr->ois_mb_results = NULL;
         object_ptr->tpl_stats = NULL;
+        object_ptr->tpl_src_stats_buffer = NULL;
         object_ptr->tpl_beta = NULL;
         object_ptr->tpl_rdmult_scaling_factors = NULL;
         object_ptr->tpl_sb_rdmult_scaling_factors = NULL;
@@ -1290,10 +1302,13 @@ EbErrorType picture_parent_control_set_ctor(PictureParentControlSet *object_ptr,
     // SB noise variance array
     EB_MALLOC_ARRAY(object_ptr->sb_flat_noise_array, object_ptr->sb_total_count);
     EB_CREATE_MUTEX(object_ptr->me_processed_sb_mutex);
+    EB_CREATE_MUTEX(object_ptr->gm_segments_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->gm_me_done_semaphore, 0, SEGMENT_MAX_COUNT);
     EB_CREATE_MUTEX(object_ptr->rc_distortion_histogram_mutex);
     EB_MALLOC_ARRAY(object_ptr->sb_depth_mode_array, object_ptr->sb_total_count);
     EB_CREATE_SEMAPHORE(object_ptr->temp_filt_done_semaphore, 0, 1);
     EB_CREATE_MUTEX(object_ptr->temp_filt_mutex);
+    EB_CREATE_SEMAPHORE(object_ptr->temp_filt_prep_done_semaphore, 0, SEGMENT_MAX_COUNT);
     EB_CREATE_MUTEX(object_ptr->debug_mutex);
     EB_MALLOC_ARRAY(object_ptr->av1_cm, 1);
 
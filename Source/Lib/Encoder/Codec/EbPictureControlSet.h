@@ -47,8 +47,9 @@ extern "C" {
 #define QPS_SW_THRESH 8 // 100 to shut QPS/QPM (i.e. CORE only)
 // BDP OFF
 #define MD_NEIGHBOR_ARRAY_INDEX 0
-#define MULTI_STAGE_PD_NEIGHBOR_ARRAY_INDEX 4
-#define NEIGHBOR_ARRAY_TOTAL_COUNT 5
+// The PD passes and the NSQ shapes save and restore the MD neighbor arrays through SB-local
+// caches in the MD context, so only the MD set is picture-sized
+#define NEIGHBOR_ARRAY_TOTAL_COUNT 1
 #define AOM_QM_BITS 5
 
 typedef struct DepCntPicInfo {
@@ -244,6 +245,13 @@ typedef struct PictureControlSet {
     uint8_t           tile_size_bytes_minus_1;
     EbHandle intra_mutex;
     uint32_t intra_coded_area;
+    // MD time budget: start time of the first EncDec segment, SBs coded since, and MD effort
+    // reduction level (all under intra_mutex)
+    EbBool   enc_dec_started;
+    uint64_t enc_dec_start_seconds;
+    uint64_t enc_dec_start_useconds;
+    uint32_t enc_dec_timed_sb_count;
+    uint8_t  md_budget_level;
     uint32_t tot_seg_searched_cdef;
     EbHandle cdef_search_mutex;
 
@@ -357,9 +365,24 @@ typedef struct PictureControlSet {
     SgrprojInfo sgrproj_info[MAX_TILE_CNTS][MAX_MB_PLANE];
     SpeedFeatures    sf;
     SearchSiteConfig ss_cfg; //CHKN this might be a seq based
-    HashTable        hash_table;
+    HashTableRecord  hash_table;
     CRC_CALCULATOR   crc_calculator1;
-    CRC_CALCULATOR   crc_calculator2;
+    CRC32C           crc_calculator2;
+    // Block hashes and same-color flags of the hash table build, split in stages of
+    // hash_segments_total_count segments run on the EncDec threads
+    uint32_t *hash_block_values[2][2];
+    int8_t *  hash_is_block_same[2][3];
+    uint8_t   hash_stage;
+    uint8_t   hash_segments_total_count;
+    uint8_t   hash_segments_done_count;
+    EbHandle  hash_segments_mutex;
+    EbHandle  hash_segments_done_semaphore;
+    // Prefix sum of the 8x8 cells of the current picture that differ from the picture
+    // the hash table holds. Only the blocks over changed cells are updated in the table.
+    uint32_t *hash_dirty_sum;
+    EbBool    hash_table_incremental;
+    uint16_t  hash_dirty_top;
+    uint16_t  hash_dirty_bottom;
 
     FRAME_CONTEXT *                 ec_ctx_array;
     FRAME_CONTEXT                   md_frame_context;
@@ -572,6 +595,11 @@ typedef struct PictureParentControlSet {
     uint8_t  me_segments_column_count;
     uint8_t  me_segments_row_count;
     uint64_t me_segments_completion_mask;
+    // Global motion segments, run on the ME threads after the ME segments
+    uint8_t  gm_segments_total_count;
+    uint8_t  gm_segments_done_count;
+    EbHandle gm_segments_mutex;
+    EbHandle gm_me_done_semaphore;
 
     // Motion Estimation Results
     uint8_t       max_number_of_pus_per_sb;
@@ -580,6 +608,10 @@ typedef struct PictureParentControlSet {
     // Global motion estimation results
     EbBool               is_global_motion[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
     EbWarpedMotionParams global_motion_estimation[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
+    // Number of references searched per list, derived once the ME of all the SBs is done
+    uint8_t              gm_ref_count_search[MAX_NUM_OF_REF_PIC_LIST];
+    // Parameters found by the GM segments, before the identity exit is applied
+    EbWarpedMotionParams gm_segment_params[MAX_NUM_OF_REF_PIC_LIST][REF_LIST_MAX_DEPTH];
 
     // Motion Estimation Distortion and OIS Historgram
     uint16_t *me_distortion_histogram;
@@ -595,6 +627,7 @@ typedef struct PictureParentControlSet {
     int64_t ts_duration;
     OisMbResults **ois_mb_results;
     TplStats     **tpl_stats;
+    TplSrcStats  *tpl_src_stats_buffer;
     int32_t      is_720p_or_larger;
     int32_t      base_rdmult;
     double       r0;
@@ -751,9 +784,12 @@ typedef struct PictureParentControlSet {
     EbByte                          save_enhanced_picture_bit_inc_ptr[3];
     EbHandle                        temp_filt_done_semaphore;
     EbHandle                        temp_filt_mutex;
+    EbHandle                        temp_filt_prep_done_semaphore;
     EbHandle                        debug_mutex;
 
     uint8_t  temp_filt_prep_done;
+    uint16_t temp_filt_prep_job_next; // next reference plane to prepare
+    uint16_t temp_filt_prep_job_done; // number of reference planes prepared
     uint16_t temp_filt_seg_acc;
 
     int16_t tf_segments_total_count;
@@ -269,6 +269,15 @@ EbErrorType picture_decision_context_ctor(
     return EB_ErrorNone;
 }
 
+/* Accumulated absolute difference between two histograms. The bins are
+ * contiguous, so the loop vectorizes. */
+static INLINE uint32_t histogram_abs_diff(const uint32_t *cur, const uint32_t *prev) {
+    uint32_t ahd = 0;
+    for (int bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin)
+        ahd += ABS((int32_t)cur[bin] - (int32_t)prev[bin]);
+    return ahd;
+}
+
 static EbBool scene_transition_detector(
     PictureDecisionContext *context_ptr,
     SequenceControlSet                 *scs_ptr,
@@ -306,6 +315,11 @@ static EbBool scene_transition_detector(
         (uint32_t)(((float)((scs_ptr->picture_analysis_number_of_regions_per_width * scs_ptr->picture_analysis_number_of_regions_per_height) * 75) / 100) + 0.5) :
         (uint32_t)(((float)((scs_ptr->picture_analysis_number_of_regions_per_width * scs_ptr->picture_analysis_number_of_regions_per_height) * 50) / 100) + 0.5);
 
+    // Noise insertion/removal detection is a picture-level decision
+    const EbBool noisy_transition =
+        ((ABS((int64_t)current_pcs_ptr->pic_avg_variance - (int64_t)prev_pcs_ptr->pic_avg_variance)) > NOISE_VARIANCE_TH) &&
+        (current_pcs_ptr->pic_avg_variance > HIGH_PICTURE_VARIANCE_TH || prev_pcs_ptr->pic_avg_variance > HIGH_PICTURE_VARIANCE_TH);
+
     region_width = parent_pcs_window[1]->enhanced_picture_ptr->width / scs_ptr->picture_analysis_number_of_regions_per_width;
     region_height = parent_pcs_window[1]->enhanced_picture_ptr->height / scs_ptr->picture_analysis_number_of_regions_per_height;
 
@@ -332,20 +346,17 @@ static EbBool scene_transition_detector(
             region_width += region_width_offset;
             region_height += region_height_offset;
 
-            region_threshhold = (
-                // Noise insertion/removal detection
-                ((ABS((int64_t)current_pcs_ptr->pic_avg_variance - (int64_t)prev_pcs_ptr->pic_avg_variance)) > NOISE_VARIANCE_TH) &&
-                (current_pcs_ptr->pic_avg_variance > HIGH_PICTURE_VARIANCE_TH || prev_pcs_ptr->pic_avg_variance > HIGH_PICTURE_VARIANCE_TH)) ?
+            region_threshhold = noisy_transition ?
                 NOISY_SCENE_TH * NUM64x64INPIC(region_width, region_height) : // SCD TH function of noise insertion/removal.
                 SCENE_TH * NUM64x64INPIC(region_width, region_height);
 
             region_threshhold_chroma = region_threshhold / 4;
 
-            for (int bin = 0; bin < HISTOGRAM_NUMBER_OF_BINS; ++bin) {
-                ahd += ABS((int32_t)current_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][0][bin] - (int32_t)prev_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][0][bin]);
-                ahd_cb += ABS((int32_t)current_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][1][bin] - (int32_t)prev_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][1][bin]);
-                ahd_cr += ABS((int32_t)current_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][2][bin] - (int32_t)prev_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index][2][bin]);
-            }
+            uint32_t **cur_hist  = current_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index];
+            uint32_t **prev_hist = prev_pcs_ptr->picture_histogram[region_in_picture_width_index][region_in_picture_height_index];
+            ahd    = histogram_abs_diff(cur_hist[0], prev_hist[0]);
+            ahd_cb = histogram_abs_diff(cur_hist[1], prev_hist[1]);
+            ahd_cr = histogram_abs_diff(cur_hist[2], prev_hist[2]);
 
             if (context_ptr->reset_running_avg) {
                 ahd_running_avg[region_in_picture_width_index][region_in_picture_height_index] = ahd;
@@ -1091,6 +1102,27 @@ EbErrorType first_pass_signal_derivation_multi_processes(
     PictureParentControlSet *pcs_ptr,
     PictureDecisionContext *context_ptr) ;
 
+/******************************************************
+* Set the number of global motion segments of the picture: one per searched
+* list 0 reference, run on the ME threads once the ME segments are done. The
+* list 1 references are searched by the first segment, after the first list 0
+* reference, for the identity exit.
+******************************************************/
+static void set_gm_segments(SequenceControlSet *scs_ptr, PictureParentControlSet *pcs_ptr) {
+    const EbBool gm_enabled = !use_output_stat(scs_ptr) &&
+        scs_ptr->static_config.enable_global_motion == EB_TRUE &&
+        pcs_ptr->frame_superres_enabled == EB_FALSE && pcs_ptr->enc_mode <= ENC_M6 &&
+        pcs_ptr->slice_type != I_SLICE;
+    // The ME and GM segments share the completion mask of the picture
+    pcs_ptr->gm_segments_total_count = gm_enabled
+        ? (uint8_t)MAX(1,
+                       MIN(pcs_ptr->ref_list0_count_try,
+                           (uint32_t)(SEGMENT_MAX_COUNT - 1 - pcs_ptr->me_segments_total_count)))
+        : 0;
+    assert(pcs_ptr->me_segments_total_count + pcs_ptr->gm_segments_total_count < SEGMENT_MAX_COUNT);
+    pcs_ptr->gm_segments_done_count = 0;
+}
+
 int8_t av1_ref_frame_type(const MvReferenceFrame *const rf);
 //set the ref frame types used for this picture,
 static void set_all_ref_frame_type(PictureParentControlSet  *parent_pcs_ptr, MvReferenceFrame ref_frame_arr[], uint8_t* tot_ref_frames)
@@ -3671,21 +3703,14 @@ void perform_simple_picture_analysis_for_overlay(PictureParentControlSet     *pc
     pad_picture_to_multiple_of_sb_dimensions(
         input_padded_picture_ptr);
 
-    // 1/4 & 1/16 input picture decimation
-    downsample_decimation_input_picture(
-        pcs_ptr,
-        input_padded_picture_ptr,
-        (EbPictureBufferDesc*)pa_ref_obj_->quarter_decimated_picture_ptr,
-        (EbPictureBufferDesc*)pa_ref_obj_->sixteenth_decimated_picture_ptr);
-
-    // 1/4 & 1/16 input picture downsampling through filtering
-    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-        downsample_filtering_input_picture(
-            pcs_ptr,
-            input_padded_picture_ptr,
-            (EbPictureBufferDesc*)pa_ref_obj_->quarter_filtered_picture_ptr,
-            (EbPictureBufferDesc*)pa_ref_obj_->sixteenth_filtered_picture_ptr);
-    }
+    // 1/4 & 1/16 input picture pyramid
+    downsample_input_picture_pyramid(pcs_ptr,
+                                     input_padded_picture_ptr,
+                                     pa_ref_obj_->quarter_decimated_picture_ptr,
+                                     pa_ref_obj_->sixteenth_decimated_picture_ptr,
+                                     pa_ref_obj_->quarter_filtered_picture_ptr,
+                                     pa_ref_obj_->sixteenth_filtered_picture_ptr);
+    pa_ref_obj_->gm_corners_valid = EB_FALSE;
     // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
     gathering_picture_statistics(
         scs_ptr,
@@ -4869,6 +4894,8 @@ void* picture_decision_kernel(void *input_ptr)
                                     context_ptr,
                                     out_stride_diff64);
                                 pcs_ptr->temp_filt_prep_done = 0;
+                                pcs_ptr->temp_filt_prep_job_next = 0;
+                                pcs_ptr->temp_filt_prep_job_done = 0;
 
                                 // Start Filtering in ME processes
                                 {
@@ -5055,6 +5082,7 @@ void* picture_decision_kernel(void *input_ptr)
                                 init_resize_picture(pcs_ptr->scs_ptr,
                                                     pcs_ptr);
                             }
+                            set_gm_segments(scs_ptr, pcs_ptr);
                             uint32_t pic_it = out_stride_diff64 - context_ptr->mini_gop_start_index[mini_gop_index];
                             context_ptr->mg_pictures_array[pic_it] = pcs_ptr;
                             if (out_stride_diff64 == context_ptr->mini_gop_end_index[mini_gop_index] + has_overlay) {
@@ -5128,6 +5156,19 @@ void* picture_decision_kernel(void *input_ptr)
                                 // Post the Full Results Object
                                 svt_post_full_object(out_results_wrapper_ptr);
                             }
+                            for (uint32_t segment_index = 0; segment_index < pcs_ptr->gm_segments_total_count; ++segment_index) {
+                                // Get Empty Results Object
+                                svt_get_empty_object(
+                                    context_ptr->picture_decision_results_output_fifo_ptr,
+                                    &out_results_wrapper_ptr);
+
+                                out_results_ptr = (PictureDecisionResults*)out_results_wrapper_ptr->object_ptr;
+                                out_results_ptr->pcs_wrapper_ptr = pcs_ptr->p_pcs_wrapper_ptr;
+                                out_results_ptr->segment_index = segment_index;
+                                out_results_ptr->task_type = 2;
+                                // Post the Full Results Object
+                                svt_post_full_object(out_results_wrapper_ptr);
+                            }
 
 
                         }
@@ -25,11 +25,6 @@ EbErrorType picture_decision_context_ctor(EbThreadContext *  thread_context_ptr,
 
 extern void *picture_decision_kernel(void *input_ptr);
 
-void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
-                                         EbPictureBufferDesc *    inputPaddedPicturePtr,
-                                         EbPictureBufferDesc *    quarterDecimatedPicturePtr,
-                                         EbPictureBufferDesc *    sixteenthDecimatedPicturePtr);
-
 void pad_picture_to_multiple_of_min_blk_size_dimensions(SequenceControlSet * scs_ptr,
                                                         EbPictureBufferDesc *input_picture_ptr);
 void pad_picture_to_multiple_of_min_blk_size_dimensions_16bit(
@@ -386,9 +386,25 @@ void mode_decision_update_neighbor_arrays(PictureControlSet *  pcs_ptr,
     return;
 }
 
-void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
-                           uint32_t src_idx, uint32_t dst_idx, uint32_t blk_mds, uint32_t sb_org_x,
-                           uint32_t sb_org_y) {
+static INLINE uint8_t *cache_neigh_arr(NeighborArrayUnit *na_unit_ptr, uint8_t *cache,
+                                       EbBool copy, EbBool restore, uint32_t origin_x,
+                                       uint32_t origin_y, uint32_t bw, uint32_t bh,
+                                       uint32_t neighbor_array_type_mask) {
+    if (copy)
+        neighbor_array_unit_cache_copy(
+            na_unit_ptr, cache, restore, origin_x, origin_y, bw, bh, neighbor_array_type_mask);
+    return cache + NEIGHBOR_ARRAY_CACHE_SIZE;
+}
+
+/*
+ * Saves (restore == 0) or restores (restore == 1) the MD neighbor arrays over the block blk_mds
+ * to/from an SB-local cache of MD_NEIGHBOR_CACHE_SIZE bytes, each array having a fixed slot.
+ * The chroma and tx depth arrays are always saved, as the pass restoring them can use different
+ * chroma and tx size search levels than the one saving them.
+ */
+static void cache_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                                   uint8_t *cache, EbBool restore, uint32_t blk_mds,
+                                   uint32_t sb_org_x, uint32_t sb_org_y) {
     uint16_t tile_idx = context_ptr->tile_index;
 
     const BlockGeom *blk_geom = get_blk_geom_mds(blk_mds);
@@ -399,220 +415,113 @@ void copy_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *cont
     uint32_t blk_org_y_uv = (blk_org_y >> 3 << 3) >> 1;
     uint32_t bwidth_uv    = blk_geom->bwidth_uv;
     uint32_t bheight_uv   = blk_geom->bheight_uv;
-
-    copy_neigh_arr(pcs_ptr->md_intra_luma_mode_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_intra_luma_mode_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    //neighbor_array_unit_reset(pcs_ptr->md_intra_chroma_mode_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_intra_chroma_mode_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_intra_chroma_mode_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x_uv,
-                   blk_org_y_uv,
-                   bwidth_uv,
-                   bheight_uv,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    //neighbor_array_unit_reset(pcs_ptr->md_skip_flag_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_skip_flag_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_skip_flag_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    //neighbor_array_unit_reset(pcs_ptr->md_mode_type_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_mode_type_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_mode_type_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-
-    //neighbor_array_unit_reset(pcs_ptr->md_leaf_depth_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_leaf_depth_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_leaf_depth_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    copy_neigh_arr(pcs_ptr->mdleaf_partition_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->mdleaf_partition_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
+    uint32_t bwidth       = blk_geom->bwidth;
+    uint32_t bheight      = blk_geom->bheight;
+
+    const EbBool copy_tx_depth = !restore || context_ptr->md_tx_size_search_mode;
+    const EbBool copy_uv       = blk_geom->has_uv &&
+        (!restore || context_ptr->chroma_level <= CHROMA_MODE_1);
+    const uint32_t top_left_mask = NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK;
+
+    cache = cache_neigh_arr(pcs_ptr->md_intra_luma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_intra_chroma_mode_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                            bheight_uv, top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_skip_flag_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_mode_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+    cache = cache_neigh_arr(pcs_ptr->md_leaf_depth_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->mdleaf_partition_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+
+    // The 8 bit and 16 bit recon arrays share their slots as only one set is used per picture
     if (!context_ptr->hbd_mode_decision) {
-        copy_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array[src_idx][tile_idx],
-                       pcs_ptr->md_luma_recon_neighbor_array[dst_idx][tile_idx],
-                       blk_org_x,
-                       blk_org_y,
-                       blk_geom->bwidth,
-                       blk_geom->bheight,
-                       NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-        if (context_ptr->md_tx_size_search_mode) {
-            copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[src_idx][tile_idx],
-                           pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[dst_idx][tile_idx],
-                           blk_org_x,
-                           blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-            copy_neigh_arr(pcs_ptr->md_tx_depth_2_luma_recon_neighbor_array[src_idx][tile_idx],
-                           pcs_ptr->md_tx_depth_2_luma_recon_neighbor_array[dst_idx][tile_idx],
-                           blk_org_x,
-                           blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-        }
-        if (blk_geom->has_uv && context_ptr->chroma_level <= CHROMA_MODE_1) {
-            copy_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array[src_idx][tile_idx],
-                           pcs_ptr->md_cb_recon_neighbor_array[dst_idx][tile_idx],
-                           blk_org_x_uv,
-                           blk_org_y_uv,
-                           bwidth_uv,
-                           bheight_uv,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-
-            copy_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array[src_idx][tile_idx],
-                           pcs_ptr->md_cr_recon_neighbor_array[dst_idx][tile_idx],
-                           blk_org_x_uv,
-                           blk_org_y_uv,
-                           bwidth_uv,
-                           bheight_uv,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-        }
+        cache = cache_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                                NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_tx_depth, restore, blk_org_x, blk_org_y, bwidth,
+                                bheight, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_tx_depth_2_luma_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_tx_depth, restore, blk_org_x, blk_org_y, bwidth,
+                                bheight, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_uv, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                                bheight_uv, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_uv, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                                bheight_uv, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
     } else {
-        copy_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array16bit[src_idx][tile_idx],
-                       pcs_ptr->md_luma_recon_neighbor_array16bit[dst_idx][tile_idx],
-                       blk_org_x,
-                       blk_org_y,
-                       blk_geom->bwidth,
-                       blk_geom->bheight,
-                       NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-        if (context_ptr->md_tx_size_search_mode) {
-            copy_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[src_idx][tile_idx],
-                           pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[dst_idx][tile_idx],
-                           blk_org_x,
-                           blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-            copy_neigh_arr(pcs_ptr->md_tx_depth_2_luma_recon_neighbor_array16bit[src_idx][tile_idx],
-                           pcs_ptr->md_tx_depth_2_luma_recon_neighbor_array16bit[dst_idx][tile_idx],
-                           blk_org_x,
-                           blk_org_y,
-                           blk_geom->bwidth,
-                           blk_geom->bheight,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-        }
-
-        if (blk_geom->has_uv && context_ptr->chroma_level <= CHROMA_MODE_1) {
-            copy_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array16bit[src_idx][tile_idx],
-                           pcs_ptr->md_cb_recon_neighbor_array16bit[dst_idx][tile_idx],
-                           blk_org_x_uv,
-                           blk_org_y_uv,
-                           bwidth_uv,
-                           bheight_uv,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-
-            copy_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array16bit[src_idx][tile_idx],
-                           pcs_ptr->md_cr_recon_neighbor_array16bit[dst_idx][tile_idx],
-                           blk_org_x_uv,
-                           blk_org_y_uv,
-                           bwidth_uv,
-                           bheight_uv,
-                           NEIGHBOR_ARRAY_UNIT_FULL_MASK);
-        }
-    }
-
-    //neighbor_array_unit_reset(pcs_ptr->md_skip_coeff_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_skip_coeff_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_skip_coeff_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    //neighbor_array_unit_reset(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    copy_neigh_arr(
-        pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
-        pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
+        cache = cache_neigh_arr(pcs_ptr->md_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                                NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_tx_depth_1_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_tx_depth, restore, blk_org_x, blk_org_y, bwidth,
+                                bheight, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_tx_depth_2_luma_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_tx_depth, restore, blk_org_x, blk_org_y, bwidth,
+                                bheight, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_cb_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_uv, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                                bheight_uv, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+        cache = cache_neigh_arr(pcs_ptr->md_cr_recon_neighbor_array16bit[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                                cache, copy_uv, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                                bheight_uv, NEIGHBOR_ARRAY_UNIT_FULL_MASK);
+    }
+
+    cache = cache_neigh_arr(pcs_ptr->md_skip_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_tx_depth_1_luma_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, copy_uv, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                            bheight_uv, top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, copy_uv, restore, blk_org_x_uv, blk_org_y_uv, bwidth_uv,
+                            bheight_uv, top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_txfm_context_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_inter_pred_dir_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    cache = cache_neigh_arr(pcs_ptr->md_ref_frame_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+                            cache, EB_TRUE, restore, blk_org_x, blk_org_y, bwidth, bheight,
+                            top_left_mask);
+    neighbor_array_unit_cache_copy32(
+        pcs_ptr->md_interpolation_type_neighbor_array[MD_NEIGHBOR_ARRAY_INDEX][tile_idx],
+        cache,
+        restore,
         blk_org_x,
         blk_org_y,
-        blk_geom->bwidth,
-        blk_geom->bheight,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (blk_geom->has_uv && context_ptr->chroma_level <= CHROMA_MODE_1) {
-        copy_neigh_arr(pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
-                       pcs_ptr->md_cb_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
-                       blk_org_x_uv,
-                       blk_org_y_uv,
-                       bwidth_uv,
-                       bheight_uv,
-                       NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-        //neighbor_array_unit_reset(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[depth]);
-
-        copy_neigh_arr(pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[src_idx][tile_idx],
-                       pcs_ptr->md_cr_dc_sign_level_coeff_neighbor_array[dst_idx][tile_idx],
-                       blk_org_x_uv,
-                       blk_org_y_uv,
-                       bwidth_uv,
-                       bheight_uv,
-                       NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    }
-
-    //neighbor_array_unit_reset(pcs_ptr->md_txfm_context_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_txfm_context_array[src_idx][tile_idx],
-                   pcs_ptr->md_txfm_context_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    //neighbor_array_unit_reset(pcs_ptr->md_inter_pred_dir_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_inter_pred_dir_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_inter_pred_dir_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    //neighbor_array_unit_reset(pcs_ptr->md_ref_frame_type_neighbor_array[depth]);
-    copy_neigh_arr(pcs_ptr->md_ref_frame_type_neighbor_array[src_idx][tile_idx],
-                   pcs_ptr->md_ref_frame_type_neighbor_array[dst_idx][tile_idx],
-                   blk_org_x,
-                   blk_org_y,
-                   blk_geom->bwidth,
-                   blk_geom->bheight,
-                   NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    copy_neigh_arr_32(pcs_ptr->md_interpolation_type_neighbor_array[src_idx][tile_idx],
-                      pcs_ptr->md_interpolation_type_neighbor_array[dst_idx][tile_idx],
-                      blk_org_x,
-                      blk_org_y,
-                      blk_geom->bwidth,
-                      blk_geom->bheight,
-                      NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+        bwidth,
+        bheight,
+        top_left_mask);
+}
+
+void save_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                           uint8_t *cache, uint32_t blk_mds, uint32_t sb_org_x,
+                           uint32_t sb_org_y) {
+    cache_neighbour_arrays(pcs_ptr, context_ptr, cache, EB_FALSE, blk_mds, sb_org_x, sb_org_y);
+}
+
+void restore_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                              uint8_t *cache, uint32_t blk_mds, uint32_t sb_org_x,
+                              uint32_t sb_org_y) {
+    cache_neighbour_arrays(pcs_ptr, context_ptr, cache, EB_TRUE, blk_mds, sb_org_x, sb_org_y);
 }
 
 void md_update_all_neighbour_arrays(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
@@ -2320,6 +2229,26 @@ void md_sq_motion_search(PictureControlSet *pcs, ModeDecisionContext *ctx,
         check_mv_validity(*me_mv_x, *me_mv_y, 0);
     }
 }
+/*
+ * Returns the subpel plane cache of the reference, allocating the caches of the context the
+ * first time they are used. NULL when the allocation fails: the search then interpolates
+ * every position as a block.
+ */
+static SubpelPlaneCache *get_subpel_plane_cache(ModeDecisionContext *context_ptr,
+                                                uint8_t list_idx, uint8_t ref_idx) {
+    if (!context_ptr->subpel_plane_cache) {
+        if (!context_ptr->subpel_tile_pred)
+            EB_NO_THROW_MALLOC(context_ptr->subpel_tile_pred, SUBPEL_CACHE_TILE_PRED_SIZE);
+        if (!context_ptr->subpel_tile_pred) return NULL;
+        EB_NO_THROW_CALLOC(context_ptr->subpel_plane_cache,
+                           MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH,
+                           sizeof(*context_ptr->subpel_plane_cache));
+        if (!context_ptr->subpel_plane_cache) return NULL;
+        for (int i = 0; i < MAX_NUM_OF_REF_PIC_LIST * REF_LIST_MAX_DEPTH; i++)
+            context_ptr->subpel_plane_cache[i].tile_pred = context_ptr->subpel_tile_pred;
+    }
+    return &context_ptr->subpel_plane_cache[list_idx * REF_LIST_MAX_DEPTH + ref_idx];
+}
 /*
  * Perform 1/2-Pel, 1/4-Pel, and 1/8-Pel search around the best Full-Pel position
  */
@@ -2399,6 +2328,28 @@ int md_subpel_search(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
     ms_buffers->wsrc = NULL;
     ms_buffers->obmc_mask = NULL;
 
+    // Interpolated planes of the reference around the SB, shared by the blocks of the SB
+    SubpelPlaneCache *plane_cache = context_ptr->md_subpel_cache_level
+        ? get_subpel_plane_cache(context_ptr, list_idx, ref_idx)
+        : NULL;
+    if (plane_cache) {
+        const uint8_t *cache_ref = ref_pic->buffer_y +
+            (ref_pic->origin_y + context_ptr->sb_origin_y - SUBPEL_CACHE_MARGIN) *
+                ref_pic->stride_y +
+            ref_pic->origin_x + context_ptr->sb_origin_x - SUBPEL_CACHE_MARGIN;
+        if (plane_cache->ref != cache_ref) {
+            plane_cache->phase_used = 0;
+            plane_cache->ref        = cache_ref;
+            plane_cache->ref_stride = ref_pic->stride_y;
+            plane_cache->size       = context_ptr->sb_size + 2 * SUBPEL_CACHE_MARGIN;
+        }
+        ms_params->var_params.cache_blk_x =
+            context_ptr->blk_origin_x - context_ptr->sb_origin_x + SUBPEL_CACHE_MARGIN;
+        ms_params->var_params.cache_blk_y =
+            context_ptr->blk_origin_y - context_ptr->sb_origin_y + SUBPEL_CACHE_MARGIN;
+    }
+    ms_params->var_params.plane_cache = plane_cache;
+
     int_mv best_mv;
     best_mv.as_mv.col = *me_mv_x >> 3;
     best_mv.as_mv.row = *me_mv_y >> 3;
@@ -4570,6 +4521,12 @@ void tx_type_search(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr
     uint32_t y_count_non_zero_coeffs_txt[TX_TYPES]= { 0 };
     uint64_t y_txb_coeff_bits_txt[TX_TYPES]= { 0 };
     uint64_t txb_full_distortion_txt[TX_TYPES][DIST_CALC_TOTAL] = { { 0 } };
+    // The column pass of the 2D transform only depends on the vertical 1D type. At 8x8 and
+    // 16x16, where all the tx types can be searched, it is run once per vertical type and
+    // shared by the tx types using it; only the row pass is done per tx type.
+    const EbBool share_col_txfm = !tx_search_skip_flag && (tx_size == TX_8X8 || tx_size == TX_16X16);
+    DECLARE_ALIGNED(32, int32_t, col_txfm_buf[TX_TYPES_1D][16 * 16]);
+    uint8_t col_txfm_done = 0;
     for (tx_type = txk_start; tx_type < txk_end; ++tx_type) {
         if (context_ptr->tx_search_level == TX_SEARCH_DCT_TX_TYPES)
             if (tx_type != DCT_DCT && tx_type != V_DCT && tx_type != H_DCT)
@@ -4639,18 +4596,38 @@ void tx_type_search(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr
                 : candidate_buffer->candidate_ptr->transform_type_uv;
 
         // Y: T Q i_q
-        av1_estimate_transform(
-            &(((int16_t *)candidate_buffer->residual_ptr->buffer_y)[txb_origin_index]),
-            candidate_buffer->residual_ptr->stride_y,
-            &(((int32_t *)context_ptr->trans_quant_buffers_ptr->txb_trans_coeff2_nx2_n_ptr
-                   ->buffer_y)[context_ptr->txb_1d_offset]),
-            NOT_USED_VALUE,
-            context_ptr->blk_geom->txsize[context_ptr->tx_depth][context_ptr->txb_itr],
-            &context_ptr->three_quad_energy,
-            context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT,
-            tx_type,
-            PLANE_TYPE_Y,
-            DEFAULT_SHAPE);
+        if (share_col_txfm) {
+            const TxType1D vtx = vtx_tab[tx_type];
+            if (!(col_txfm_done & (1 << vtx))) {
+                svt_av1_fwd_txfm2d_col(
+                    &(((int16_t *)candidate_buffer->residual_ptr->buffer_y)[txb_origin_index]),
+                    col_txfm_buf[vtx],
+                    candidate_buffer->residual_ptr->stride_y,
+                    tx_size,
+                    tx_type,
+                    context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT);
+                col_txfm_done |= 1 << vtx;
+            }
+            svt_av1_fwd_txfm2d_row(
+                col_txfm_buf[vtx],
+                &(((int32_t *)context_ptr->trans_quant_buffers_ptr->txb_trans_coeff2_nx2_n_ptr
+                       ->buffer_y)[context_ptr->txb_1d_offset]),
+                tx_size,
+                tx_type,
+                context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT);
+        } else
+            av1_estimate_transform(
+                &(((int16_t *)candidate_buffer->residual_ptr->buffer_y)[txb_origin_index]),
+                candidate_buffer->residual_ptr->stride_y,
+                &(((int32_t *)context_ptr->trans_quant_buffers_ptr->txb_trans_coeff2_nx2_n_ptr
+                       ->buffer_y)[context_ptr->txb_1d_offset]),
+                NOT_USED_VALUE,
+                context_ptr->blk_geom->txsize[context_ptr->tx_depth][context_ptr->txb_itr],
+                &context_ptr->three_quad_energy,
+                context_ptr->hbd_mode_decision ? EB_10BIT : EB_8BIT,
+                tx_type,
+                PLANE_TYPE_Y,
+                DEFAULT_SHAPE);
 
         quantized_dc_txt[tx_type] = av1_quantize_inv_quantize(
             pcs_ptr,
@@ -6870,12 +6847,12 @@ void init_chroma_mode(ModeDecisionContext *context_ptr) {
         }
     }
 }
-static void search_best_independent_uv_mode(PictureControlSet *  pcs_ptr,
-                                            EbPictureBufferDesc *input_picture_ptr,
-                                            uint32_t             input_cb_origin_in_index,
-                                            uint32_t             input_cr_origin_in_index,
-                                            uint32_t             cu_chroma_origin_index,
-                                            ModeDecisionContext *context_ptr) {
+static EbErrorType search_best_independent_uv_mode(PictureControlSet *  pcs_ptr,
+                                                   EbPictureBufferDesc *input_picture_ptr,
+                                                   uint32_t             input_cb_origin_in_index,
+                                                   uint32_t             input_cr_origin_in_index,
+                                                   uint32_t             cu_chroma_origin_index,
+                                                   ModeDecisionContext *context_ptr) {
     FrameHeader *frm_hdr = &pcs_ptr->parent_pcs_ptr->frm_hdr;
     uint32_t     full_lambda =
         context_ptr->full_lambda_md[context_ptr->hbd_mode_decision ? EB_10_BIT_MD : EB_8_BIT_MD];
@@ -6957,6 +6934,11 @@ static void search_best_independent_uv_mode(PictureControlSet *  pcs_ptr,
         }
     }
     uv_mode_total_count = uv_mode_total_count - start_fast_buffer_index;
+    if (uv_mode_total_count > context_ptr->cand_buff_count_uv) {
+        EbErrorType return_error =
+            mode_decision_alloc_candidate_buffers(context_ptr, 0, uv_mode_total_count);
+        if (return_error != EB_ErrorNone) return return_error;
+    }
     // Fast-loop search uv_mode
     for (uint8_t uv_mode_count = 0; uv_mode_count < uv_mode_total_count; uv_mode_count++) {
         ModeDecisionCandidateBuffer *candidate_buffer =
@@ -7194,6 +7176,7 @@ static void search_best_independent_uv_mode(PictureControlSet *  pcs_ptr,
 
     if (context_ptr->chroma_at_last_md_stage)
         context_ptr->md_staging_skip_rdoq = tem_md_staging_skip_rdoq;
+    return EB_ErrorNone;
 }
 void interintra_class_pruning_1(ModeDecisionContext *context_ptr, uint64_t best_md_stage_cost) {
     for (CandClass cand_class_it = CAND_CLASS_0; cand_class_it < CAND_CLASS_TOTAL;
@@ -7574,9 +7557,10 @@ void distortion_based_modulator(ModeDecisionContext *context_ptr,
         }
     }
 }
-void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
-                     EbPictureBufferDesc *        input_picture_ptr,
-                     ModeDecisionCandidateBuffer *bestcandidate_buffers[5]) {
+EbErrorType md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                            EbPictureBufferDesc *        input_picture_ptr,
+                            ModeDecisionCandidateBuffer *bestcandidate_buffers[5]) {
+    EbErrorType                   return_error = EB_ErrorNone;
     ModeDecisionCandidateBuffer **candidate_buffer_ptr_array_base =
         context_ptr->candidate_buffer_ptr_array;
     ModeDecisionCandidateBuffer **candidate_buffer_ptr_array;
@@ -7632,12 +7616,13 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
         if (context_ptr->chroma_level == CHROMA_MODE_0) {
             if (context_ptr->blk_geom->sq_size < 128) {
                 if (context_ptr->blk_geom->has_uv) {
-                    search_best_independent_uv_mode(pcs_ptr,
-                                                    input_picture_ptr,
-                                                    input_cb_origin_in_index,
-                                                    input_cb_origin_in_index,
-                                                    blk_chroma_origin_index,
-                                                    context_ptr);
+                    return_error = search_best_independent_uv_mode(pcs_ptr,
+                                                                   input_picture_ptr,
+                                                                   input_cb_origin_in_index,
+                                                                   input_cb_origin_in_index,
+                                                                   blk_chroma_origin_index,
+                                                                   context_ptr);
+                    if (return_error != EB_ErrorNone) return return_error;
                 }
             }
         }
@@ -7728,6 +7713,16 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
 
             buffer_total_count += buffer_count_for_curr_class;
             assert(buffer_total_count <= MAX_NFL_BUFF && "not enough cand buffers");
+            // Create the buffers of the class if not done yet; beyond MAX_NFL_BUFF_Y, the
+            // chroma buffers are used
+            const uint32_t count_y  = MIN(buffer_total_count, MAX_NFL_BUFF_Y);
+            const uint32_t count_uv = buffer_total_count - count_y;
+            if (count_y > context_ptr->cand_buff_count_y ||
+                count_uv > context_ptr->cand_buff_count_uv) {
+                return_error =
+                    mode_decision_alloc_candidate_buffers(context_ptr, count_y, count_uv);
+                if (return_error != EB_ErrorNone) return return_error;
+            }
 
             //Input: md_stage_0_count[cand_class_it]  Output:  md_stage_1_count[cand_class_it]
             context_ptr->target_class = cand_class_it;
@@ -7864,13 +7859,15 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
         // Initialize uv_search_path
         if (context_ptr->blk_geom->sq_size < 128) {
             if (context_ptr->blk_geom->has_uv) {
-                if (context_ptr->md_stage_3_total_intra_count)
-                    search_best_independent_uv_mode(pcs_ptr,
-                                                    input_picture_ptr,
-                                                    input_cb_origin_in_index,
-                                                    input_cb_origin_in_index,
-                                                    blk_chroma_origin_index,
-                                                    context_ptr);
+                if (context_ptr->md_stage_3_total_intra_count) {
+                    return_error = search_best_independent_uv_mode(pcs_ptr,
+                                                                   input_picture_ptr,
+                                                                   input_cb_origin_in_index,
+                                                                   input_cb_origin_in_index,
+                                                                   blk_chroma_origin_index,
+                                                                   context_ptr);
+                    if (return_error != EB_ErrorNone) return return_error;
+                }
             }
         }
     }
@@ -8104,9 +8101,10 @@ void md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_pt
 #endif
 
     context_ptr->md_local_blk_unit[blk_ptr->mds_idx].avail_blk_flag = EB_TRUE;
+    return return_error;
 }
 
- void first_pass_md_encode_block(PictureControlSet *pcs_ptr,
+ EbErrorType first_pass_md_encode_block(PictureControlSet *pcs_ptr,
     ModeDecisionContext *context_ptr, EbPictureBufferDesc *input_picture_ptr,
     ModeDecisionCandidateBuffer *bestcandidate_buffers[5]);
 /*
@@ -8550,11 +8548,10 @@ EB_EXTERN EbErrorType mode_decision_sb(SequenceControlSet *scs_ptr, PictureContr
         if (leaf_data_ptr->tot_d1_blocks != 1) {
             // We need to get the index of the sq_block for each NSQ branch
             if (d1_first_block) {
-                copy_neighbour_arrays( //save a clean neigh in [1], encode uses [0], reload the clean in [0] after done last ns block in a partition
+                save_neighbour_arrays( //save a clean neigh, encode uses [0], reload the clean one after done last ns block in a partition
                     pcs_ptr,
                     context_ptr,
-                    0,
-                    1,
+                    context_ptr->nsq_neighbor_cache,
                     blk_geom->sqi_mds,
                     sb_origin_x,
                     sb_origin_y);
@@ -8732,12 +8729,12 @@ EB_EXTERN EbErrorType mode_decision_sb(SequenceControlSet *scs_ptr, PictureContr
                 !skip_next_depth &&
                 !skip_nsq) {
                 if (use_output_stat(scs_ptr))
-                    first_pass_md_encode_block(pcs_ptr,
-                        context_ptr,
-                        input_picture_ptr,
-                        bestcandidate_buffers);
+                    return_error = first_pass_md_encode_block(
+                        pcs_ptr, context_ptr, input_picture_ptr, bestcandidate_buffers);
                 else
-                md_encode_block(pcs_ptr, context_ptr, input_picture_ptr, bestcandidate_buffers);
+                    return_error = md_encode_block(
+                        pcs_ptr, context_ptr, input_picture_ptr, bestcandidate_buffers);
+                if (return_error != EB_ErrorNone) return return_error;
             } else if (sq_weight_based_nsq_skip || skip_next_depth || zero_sq_coeff_skip_action) {
                 if (context_ptr->blk_geom->shape != PART_N)
                     context_ptr->md_local_blk_unit[context_ptr->blk_ptr->mds_idx].cost =
@@ -8789,11 +8786,10 @@ EB_EXTERN EbErrorType mode_decision_sb(SequenceControlSet *scs_ptr, PictureContr
                 md_update_all_neighbour_arrays(
                     pcs_ptr, context_ptr, blk_idx_mds, sb_origin_x, sb_origin_y);
             else
-                copy_neighbour_arrays( //restore [1] in [0] after done last ns block
+                restore_neighbour_arrays( //restore the clean neigh in [0] after done last ns block
                     pcs_ptr,
                     context_ptr,
-                    1,
-                    0,
+                    context_ptr->nsq_neighbor_cache,
                     blk_geom->sqi_mds,
                     sb_origin_x,
                     sb_origin_y);
@@ -332,7 +332,7 @@ static INLINE int32_t av1_cost_coeffs_txb_loop_cost_eob(uint16_t eob, const int1
                                                         int8_t *const         coeff_contexts,
                                                         const LvMapCoeffCost *coeff_costs,
                                                         int16_t dc_sign_ctx, uint8_t *const levels,
-                                                        const int32_t bwl, TxType transform_type) {
+                                                        const int32_t bwl, TxClass tx_class) {
     const uint32_t cost_literal = av1_cost_literal(1);
     int32_t        cost         = 0;
     int32_t        c;
@@ -366,7 +366,7 @@ static INLINE int32_t av1_cost_coeffs_txb_loop_cost_eob(uint16_t eob, const int1
 
             if (level > NUM_BASE_LEVELS) {
                 int32_t ctx;
-                ctx = get_br_ctx(levels, pos, bwl, tx_type_to_class[transform_type]);
+                ctx = get_br_ctx(levels, pos, bwl, tx_class);
                 const int32_t base_range = level - 1 - NUM_BASE_LEVELS;
 
                 if (base_range < COEFF_BASE_RANGE)
@@ -379,28 +379,19 @@ static INLINE int32_t av1_cost_coeffs_txb_loop_cost_eob(uint16_t eob, const int1
         }
     }
 
-    /* Optimized Loop, omitted first (eob - 1) and last (0) index */
-    for (c = eob - 2; c >= 1; --c) {
-        const int32_t pos   = scan[c];
-        const int32_t level = abs(qcoeff[pos]);
-        if (level > NUM_BASE_LEVELS) {
-            const int32_t ctx = get_br_ctx(levels, pos, bwl, tx_type_to_class[transform_type]);
-            const int32_t base_range = level - 1 - NUM_BASE_LEVELS;
-
-            if (base_range < COEFF_BASE_RANGE) {
-                cost += cost_literal + coeff_costs->lps_cost[ctx][base_range] +
-                        coeff_costs->base_cost[coeff_contexts[pos]][3];
-            } else {
-                cost += get_golomb_cost(level) + cost_literal +
-                        coeff_costs->lps_cost[ctx][COEFF_BASE_RANGE] +
-                        coeff_costs->base_cost[coeff_contexts[pos]][3];
-            }
-        } else if (level) {
-            cost += cost_literal + coeff_costs->base_cost[coeff_contexts[pos]][level];
-        } else {
-            cost += coeff_costs->base_cost[coeff_contexts[pos]][0];
-        }
-    }
+    /* Optimized Loop, omitted first (eob - 1) and last (0) index. The per transform class
+     * specialization lives in the RTCD kernel (one loop per class in the C version), so the
+     * two coefficients above do not need their own copy per class. */
+    if (eob > 2)
+        cost += svt_av1_cost_coeffs_txb_inner(levels,
+                                              scan,
+                                              qcoeff,
+                                              coeff_contexts,
+                                              coeff_costs->base_cost,
+                                              coeff_costs->lps_cost,
+                                              eob,
+                                              bwl,
+                                              tx_class);
     return cost;
 }
 
@@ -427,7 +418,8 @@ uint64_t svt_av1_cost_coeffs_txb(uint8_t allow_update_cdf, FRAME_CONTEXT *ec_ctx
     const int16_t *const scan = scan_order->scan;
     uint8_t              levels_buf[TX_PAD_2D];
     uint8_t *const       levels = set_levels(levels_buf, width);
-    DECLARE_ALIGNED(16, int8_t, coeff_contexts[MAX_TX_SQUARE]);
+    // 3 bytes of padding: svt_av1_cost_coeffs_txb_inner_avx2() gathers 4 bytes per context
+    DECLARE_ALIGNED(16, int8_t, coeff_contexts[MAX_TX_SQUARE + 3]);
     assert(txs_ctx < TX_SIZES);
     const LvMapCoeffCost *const coeff_costs =
         &candidate_buffer_ptr->candidate_ptr->md_rate_estimation_ptr
@@ -538,7 +530,7 @@ uint64_t svt_av1_cost_coeffs_txb(uint8_t allow_update_cdf, FRAME_CONTEXT *ec_ctx
     }
 
     cost += av1_cost_coeffs_txb_loop_cost_eob(
-        eob, scan, qcoeff, coeff_contexts, coeff_costs, dc_sign_ctx, levels, bwl, transform_type);
+        eob, scan, qcoeff, coeff_contexts, coeff_costs, dc_sign_ctx, levels, bwl, tx_class);
 
     return cost;
 }
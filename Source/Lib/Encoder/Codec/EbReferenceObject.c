@@ -15,6 +15,7 @@
 #include "EbThreads.h"
 #include "EbReferenceObject.h"
 #include "EbPictureBufferDesc.h"
+#include "global_motion.h"
 
 // TODO: is this just padding with zeros? Is this needed?
 void initialize_samples_neighboring_reference_picture16_bit(EbByte   recon_samples_buffer_ptr,
@@ -251,6 +252,8 @@ static void svt_pa_reference_object_dctor(EbPtr p) {
     EB_DELETE(obj->sixteenth_decimated_picture_ptr);
     EB_DELETE(obj->quarter_filtered_picture_ptr);
     EB_DELETE(obj->sixteenth_filtered_picture_ptr);
+    EB_FREE_ARRAY(obj->gm_corners);
+    EB_DESTROY_MUTEX(obj->gm_corners_mutex);
 
     for(uint8_t denom_idx = 0; denom_idx < NUM_SCALES; denom_idx++){
         if(obj->downscaled_input_padded_picture_ptr[denom_idx] != NULL){
@@ -299,6 +302,9 @@ EbErrorType svt_pa_reference_object_ctor(EbPaReferenceObject *pa_ref_obj_,
                svt_picture_buffer_desc_ctor,
                (EbPtr)(picture_buffer_desc_init_data_ptr + 2));
     }
+    EB_MALLOC_ARRAY(pa_ref_obj_->gm_corners, 2 * MAX_CORNERS);
+    pa_ref_obj_->gm_corners_valid = EB_FALSE;
+    EB_CREATE_MUTEX(pa_ref_obj_->gm_corners_mutex);
 
     // set all supplemental downscaled reference picture pointers to NULL
     for(uint8_t down_idx = 0; down_idx < NUM_SCALES; down_idx++){
@@ -77,6 +77,15 @@ typedef struct EbPaReferenceObject {
     uint8_t              y_mean[MAX_NUMBER_OF_TREEBLOCKS_PER_PICTURE];
     EB_SLICE             slice_type;
     uint32_t             dependent_pictures_count; //number of pic using this reference frame
+    // Corners detected by the global motion search, on the picture of gm_corners_level, within
+    // gm_corners_width x gm_corners_height. Shared by all the pictures searching this picture.
+    int *                gm_corners;
+    int                  gm_num_corners;
+    EbBool               gm_corners_valid;
+    uint8_t              gm_corners_level;
+    uint16_t             gm_corners_width;
+    uint16_t             gm_corners_height;
+    EbHandle             gm_corners_mutex;
 } EbPaReferenceObject;
 
 typedef struct EbPaReferenceObjectDescInitData {
@@ -17,6 +17,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "EbResize.h"
+#include "aom_dsp_rtcd.h"
 
 #define DEBUG_SCALING 0
 #define DIVIDE_AND_ROUND(x, y) (((x) + ((y) >> 1)) / (y))
@@ -24,6 +25,9 @@
 // Filters for factor of 2 downsampling.
 static const int16_t av1_down2_symeven_half_filter[] = {56, 12, -3, -1};
 static const int16_t av1_down2_symodd_half_filter[]  = {64, 35, 0, -3};
+// Same filters as 8-tap kernels, centered on (i, i + 1) for even and on i for odd lengths.
+static const int16_t av1_down2_symeven_filter[SUBPEL_TAPS] = {-1, -3, 12, 56, 56, 12, -3, -1};
+static const int16_t av1_down2_symodd_filter[SUBPEL_TAPS]  = {0, -3, 0, 35, 64, 35, 0, -3};
 
 // Filters for interpolation (0.5-band) - note this also filters integer pels.
 static const InterpKernel filteredinterp_filters500[(1 << RS_SUBPEL_BITS)] = {
@@ -169,15 +173,12 @@ static const InterpKernel filteredinterp_filters875[(1 << RS_SUBPEL_BITS)] = {
         {-1, 3, -9, 17, 112, 10, -7, 3},  {-1, 3, -8, 15, 112, 12, -7, 2},
 };
 
-void downsample_decimation_input_picture(PictureParentControlSet *pcs_ptr,
-                                         EbPictureBufferDesc *input_padded_picture_ptr,
-                                         EbPictureBufferDesc *quarter_decimated_picture_ptr,
-                                         EbPictureBufferDesc *sixteenth_decimated_picture_ptr);
-
-void downsample_filtering_input_picture(PictureParentControlSet *pcs_ptr,
-                                        EbPictureBufferDesc *input_padded_picture_ptr,
-                                        EbPictureBufferDesc *quarter_picture_ptr,
-                                        EbPictureBufferDesc *sixteenth_picture_ptr);
+void downsample_input_picture_pyramid(PictureParentControlSet *pcs_ptr,
+                                      EbPictureBufferDesc *    input_padded_picture_ptr,
+                                      EbPictureBufferDesc *    quarter_decimated_picture_ptr,
+                                      EbPictureBufferDesc *    sixteenth_decimated_picture_ptr,
+                                      EbPictureBufferDesc *    quarter_filtered_picture_ptr,
+                                      EbPictureBufferDesc *    sixteenth_filtered_picture_ptr);
 
 void calculate_scaled_size_helper(uint16_t *dim, uint8_t denom);
 
@@ -205,7 +206,7 @@ static int get_down2_steps(int in_length, int out_length) {
     return steps;
 }
 
-static void down2_symeven(const uint8_t *const input, int length, uint8_t *output) {
+void svt_av1_down2_symeven_c(const uint8_t *const input, int length, uint8_t *output) {
     // Actual filter len = 2 * filter_len_half.
     const int16_t *filter          = av1_down2_symeven_half_filter;
     const int      filter_len_half = sizeof(av1_down2_symeven_half_filter) / 2;
@@ -256,7 +257,7 @@ static void down2_symeven(const uint8_t *const input, int length, uint8_t *outpu
     }
 }
 
-static void down2_symodd(const uint8_t *const input, int length, uint8_t *output) {
+void svt_av1_down2_symodd_c(const uint8_t *const input, int length, uint8_t *output) {
     // Actual filter len = 2 * filter_len_half - 1.
     const int16_t *filter          = av1_down2_symodd_half_filter;
     const int      filter_len_half = sizeof(av1_down2_symodd_half_filter) / 2;
@@ -325,8 +326,8 @@ static const InterpKernel *choose_interp_filter(int in_length, int out_length) {
         return filteredinterp_filters500;
 }
 
-static void interpolate_core(const uint8_t *const input, int in_length, uint8_t *output,
-                             int out_length, const int16_t *interp_filters, int interp_taps) {
+void svt_av1_interpolate_core_c(const uint8_t *const input, int in_length, uint8_t *output,
+                                int out_length, const int16_t *interp_filters, int interp_taps) {
     const int32_t delta =
         (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) / out_length;
     const int32_t offset =
@@ -404,7 +405,8 @@ static void interpolate(const uint8_t *const input, int in_length, uint8_t *outp
                         int out_length) {
     const InterpKernel *interp_filters = choose_interp_filter(in_length, out_length);
 
-    interpolate_core(input, in_length, output, out_length, &interp_filters[0][0], SUBPEL_TAPS);
+    svt_av1_interpolate_core(
+        input, in_length, output, out_length, &interp_filters[0][0], SUBPEL_TAPS);
 }
 
 static void resize_multistep(const uint8_t *const input, int length, uint8_t *output, int olength,
@@ -429,9 +431,9 @@ static void resize_multistep(const uint8_t *const input, int length, uint8_t *ou
             else
                 out = (s & 1) ? otmp2 : otmp;
             if (filteredlength & 1)
-                down2_symodd(in, filteredlength, out);
+                svt_av1_down2_symodd(in, filteredlength, out);
             else
-                down2_symeven(in, filteredlength, out);
+                svt_av1_down2_symeven(in, filteredlength, out);
             filteredlength = proj_filteredlength;
         }
         if (filteredlength != olength) { interpolate(out, filteredlength, output, olength); }
@@ -440,24 +442,103 @@ static void resize_multistep(const uint8_t *const input, int length, uint8_t *ou
     }
 }
 
-static void fill_arr_to_col(uint8_t *img, int stride, int len, uint8_t *arr) {
-    int      i;
-    uint8_t *iptr = img;
-    uint8_t *aptr = arr;
-    for (i = 0; i < len; ++i, iptr += stride) { *iptr = *aptr++; }
+/*
+ * Filter the rows [first_row, first_row + SUBPEL_TAPS) of a strided plane of in_length rows
+ * into one output row of width samples. Rows outside the plane are clamped to its edges.
+ */
+void svt_av1_resize_vert_row_c(const uint8_t *const input, int in_stride, int in_length,
+                               int first_row, const int16_t *filter, uint8_t *output, int width) {
+    const uint8_t *rows[SUBPEL_TAPS];
+    for (int k = 0; k < SUBPEL_TAPS; ++k)
+        rows[k] = input + AOMMAX(AOMMIN(first_row + k, in_length - 1), 0) * in_stride;
+    for (int x = 0; x < width; ++x) {
+        int sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel(ROUND_POWER_OF_TWO(sum, FILTER_BITS));
+    }
 }
 
-static void fill_col_to_arr(uint8_t *img, int stride, int len, uint8_t *arr) {
-    int      i;
-    uint8_t *iptr = img;
-    uint8_t *aptr = arr;
-    for (i = 0; i < len; ++i, iptr += stride) { *aptr++ = *iptr; }
+static void down2_vert(const uint8_t *const input, int in_stride, int length, uint8_t *output,
+                       int out_stride, int width) {
+    // Odd lengths use a 7-tap filter centered on i, even ones an 8-tap filter centered on i + 0.5
+    const int16_t *filter = (length & 1) ? av1_down2_symodd_filter : av1_down2_symeven_filter;
+    const int      first  = (length & 1) ? -(SUBPEL_TAPS / 2) : -(SUBPEL_TAPS / 2 - 1);
+    for (int i = 0; i < length; i += 2, output += out_stride)
+        svt_av1_resize_vert_row(input, in_stride, length, i + first, filter, output, width);
+}
+
+static void interpolate_vert(const uint8_t *const input, int in_stride, int in_length,
+                             uint8_t *output, int out_stride, int out_length, int width) {
+    const InterpKernel *interp_filters = choose_interp_filter(in_length, out_length);
+    const int32_t       delta =
+        (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) / out_length;
+    const int32_t offset =
+        in_length > out_length
+            ? (((int32_t)(in_length - out_length) << (RS_SCALE_SUBPEL_BITS - 1)) + out_length / 2) /
+                  out_length
+            : -(((int32_t)(out_length - in_length) << (RS_SCALE_SUBPEL_BITS - 1)) +
+                out_length / 2) /
+                  out_length;
+    int32_t y = offset + RS_SCALE_EXTRA_OFF;
+    for (int x = 0; x < out_length; ++x, y += delta, output += out_stride) {
+        const int int_pel = y >> RS_SCALE_SUBPEL_BITS;
+        const int sub_pel = (y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK;
+        svt_av1_resize_vert_row(input,
+                                in_stride,
+                                in_length,
+                                int_pel - SUBPEL_TAPS / 2 + 1,
+                                interp_filters[sub_pel],
+                                output,
+                                width);
+    }
+}
+
+/*
+ * Vertical counterpart of resize_multistep(): all the columns of the strided plane are
+ * resized at once, one output row at a time. otmp must hold width * length samples.
+ */
+static void resize_multistep_vert(const uint8_t *const input, int in_stride, int length,
+                                  uint8_t *output, int out_stride, int olength, int width,
+                                  uint8_t *otmp) {
+    if (length == olength) {
+        for (int i = 0; i < length; ++i)
+            svt_memcpy(output + i * out_stride, input + i * in_stride, sizeof(output[0]) * width);
+        return;
+    }
+    const int steps = get_down2_steps(length, olength);
+
+    if (steps > 0) {
+        uint8_t *out            = NULL;
+        int      out_stride_s   = width;
+        int      filteredlength = length;
+
+        assert(otmp != NULL);
+        uint8_t *otmp2 = otmp + get_down2_length(length, 1) * width;
+        for (int s = 0; s < steps; ++s) {
+            const int            proj_filteredlength = get_down2_length(filteredlength, 1);
+            const uint8_t *const in                  = (s == 0 ? input : out);
+            const int            in_stride_s         = (s == 0 ? in_stride : out_stride_s);
+            if (s == steps - 1 && proj_filteredlength == olength) {
+                out          = output;
+                out_stride_s = out_stride;
+            } else {
+                out          = (s & 1) ? otmp2 : otmp;
+                out_stride_s = width;
+            }
+            down2_vert(in, in_stride_s, filteredlength, out, out_stride_s, width);
+            filteredlength = proj_filteredlength;
+        }
+        if (filteredlength != olength)
+            interpolate_vert(out, out_stride_s, filteredlength, output, out_stride, olength, width);
+    } else {
+        interpolate_vert(input, in_stride, length, output, out_stride, olength, width);
+    }
 }
 
 static EbErrorType av1_resize_plane(const uint8_t *const input, int height, int width, int in_stride,
                                     uint8_t *output, int height2, int width2, int out_stride) {
     int      i;
-    uint8_t *intbuf, *tmpbuf, *arrbuf, *arrbuf2;
+    uint8_t *intbuf, *tmpbuf, *vtmpbuf;
 
     assert(width > 0);
     assert(height > 0);
@@ -465,36 +546,29 @@ static EbErrorType av1_resize_plane(const uint8_t *const input, int height, int
     assert(height2 > 0);
 
     EB_MALLOC_ARRAY(intbuf, width2 * height);
-    EB_MALLOC_ARRAY(tmpbuf, AOMMAX(width, height));
-    EB_MALLOC_ARRAY(arrbuf, height);
-    EB_MALLOC_ARRAY(arrbuf2, height2);
-    if (intbuf == NULL || tmpbuf == NULL || arrbuf == NULL || arrbuf2 == NULL) {
+    EB_MALLOC_ARRAY(tmpbuf, width);
+    EB_MALLOC_ARRAY(vtmpbuf, width2 * height);
+    if (intbuf == NULL || tmpbuf == NULL || vtmpbuf == NULL) {
         EB_FREE_ARRAY(intbuf);
         EB_FREE_ARRAY(tmpbuf);
-        EB_FREE_ARRAY(arrbuf);
-        EB_FREE_ARRAY(arrbuf2);
+        EB_FREE_ARRAY(vtmpbuf);
         return EB_ErrorInsufficientResources;
     }
     for (i = 0; i < height; ++i)
         resize_multistep(input + in_stride * i, width, intbuf + width2 * i, width2, tmpbuf);
 
-    for (i = 0; i < width2; ++i) {
-        fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-        resize_multistep(arrbuf, height, arrbuf2, height2, tmpbuf);
-        fill_arr_to_col(output + i, out_stride, height2, arrbuf2);
-    }
+    resize_multistep_vert(intbuf, width2, height, output, out_stride, height2, width2, vtmpbuf);
 
     EB_FREE_ARRAY(intbuf);
     EB_FREE_ARRAY(tmpbuf);
-    EB_FREE_ARRAY(arrbuf);
-    EB_FREE_ARRAY(arrbuf2);
+    EB_FREE_ARRAY(vtmpbuf);
 
     return EB_ErrorNone;
 }
 
-static void highbd_interpolate_core(const uint16_t *const input, int in_length, uint16_t *output,
-                                    int out_length, int bd, const int16_t *interp_filters,
-                                    int interp_taps) {
+void svt_av1_highbd_interpolate_core_c(const uint16_t *const input, int in_length,
+                                       uint16_t *output, int out_length, int bd,
+                                       const int16_t *interp_filters, int interp_taps) {
     const int32_t delta =
         (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) / out_length;
     const int32_t offset =
@@ -572,12 +646,12 @@ static void highbd_interpolate(const uint16_t *const input, int in_length, uint1
                                int out_length, int bd) {
     const InterpKernel *interp_filters = choose_interp_filter(in_length, out_length);
 
-    highbd_interpolate_core(
+    svt_av1_highbd_interpolate_core(
         input, in_length, output, out_length, bd, &interp_filters[0][0], SUBPEL_TAPS);
 }
 
-static void highbd_down2_symeven(const uint16_t *const input, int length, uint16_t *output,
-                                 int bd) {
+void svt_av1_highbd_down2_symeven_c(const uint16_t *const input, int length, uint16_t *output,
+                                    int bd) {
     // Actual filter len = 2 * filter_len_half.
     static const int16_t *filter          = av1_down2_symeven_half_filter;
     const int             filter_len_half = sizeof(av1_down2_symeven_half_filter) / 2;
@@ -628,7 +702,8 @@ static void highbd_down2_symeven(const uint16_t *const input, int length, uint16
     }
 }
 
-static void highbd_down2_symodd(const uint16_t *const input, int length, uint16_t *output, int bd) {
+void svt_av1_highbd_down2_symodd_c(const uint16_t *const input, int length, uint16_t *output,
+                                   int bd) {
     // Actual filter len = 2 * filter_len_half - 1.
     static const int16_t *filter          = av1_down2_symodd_half_filter;
     const int             filter_len_half = sizeof(av1_down2_symodd_half_filter) / 2;
@@ -701,9 +776,9 @@ static void highbd_resize_multistep(const uint16_t *const input, int length, uin
             else
                 out = (s & 1) ? otmp2 : otmp;
             if (filteredlength & 1)
-                highbd_down2_symodd(in, filteredlength, out, bd);
+                svt_av1_highbd_down2_symodd(in, filteredlength, out, bd);
             else
-                highbd_down2_symeven(in, filteredlength, out, bd);
+                svt_av1_highbd_down2_symeven(in, filteredlength, out, bd);
             filteredlength = proj_filteredlength;
         }
         if (filteredlength != olength) {
@@ -714,18 +789,93 @@ static void highbd_resize_multistep(const uint16_t *const input, int length, uin
     }
 }
 
-static void highbd_fill_col_to_arr(uint16_t *img, int stride, int len, uint16_t *arr) {
-    int       i;
-    uint16_t *iptr = img;
-    uint16_t *aptr = arr;
-    for (i = 0; i < len; ++i, iptr += stride) { *aptr++ = *iptr; }
+void svt_av1_highbd_resize_vert_row_c(const uint16_t *const input, int in_stride, int in_length,
+                                      int first_row, const int16_t *filter, uint16_t *output,
+                                      int width, int bd) {
+    const uint16_t *rows[SUBPEL_TAPS];
+    for (int k = 0; k < SUBPEL_TAPS; ++k)
+        rows[k] = input + AOMMAX(AOMMIN(first_row + k, in_length - 1), 0) * in_stride;
+    for (int x = 0; x < width; ++x) {
+        int sum = 0;
+        for (int k = 0; k < SUBPEL_TAPS; ++k) sum += filter[k] * rows[k][x];
+        output[x] = clip_pixel_highbd(ROUND_POWER_OF_TWO(sum, FILTER_BITS), bd);
+    }
 }
 
-static void highbd_fill_arr_to_col(uint16_t *img, int stride, int len, uint16_t *arr) {
-    int       i;
-    uint16_t *iptr = img;
-    uint16_t *aptr = arr;
-    for (i = 0; i < len; ++i, iptr += stride) { *iptr = *aptr++; }
+static void highbd_down2_vert(const uint16_t *const input, int in_stride, int length,
+                              uint16_t *output, int out_stride, int width, int bd) {
+    const int16_t *filter = (length & 1) ? av1_down2_symodd_filter : av1_down2_symeven_filter;
+    const int      first  = (length & 1) ? -(SUBPEL_TAPS / 2) : -(SUBPEL_TAPS / 2 - 1);
+    for (int i = 0; i < length; i += 2, output += out_stride)
+        svt_av1_highbd_resize_vert_row(
+            input, in_stride, length, i + first, filter, output, width, bd);
+}
+
+static void highbd_interpolate_vert(const uint16_t *const input, int in_stride, int in_length,
+                                    uint16_t *output, int out_stride, int out_length, int width,
+                                    int bd) {
+    const InterpKernel *interp_filters = choose_interp_filter(in_length, out_length);
+    const int32_t       delta =
+        (((uint32_t)in_length << RS_SCALE_SUBPEL_BITS) + out_length / 2) / out_length;
+    const int32_t offset =
+        in_length > out_length
+            ? (((int32_t)(in_length - out_length) << (RS_SCALE_SUBPEL_BITS - 1)) + out_length / 2) /
+                  out_length
+            : -(((int32_t)(out_length - in_length) << (RS_SCALE_SUBPEL_BITS - 1)) +
+                out_length / 2) /
+                  out_length;
+    int32_t y = offset + RS_SCALE_EXTRA_OFF;
+    for (int x = 0; x < out_length; ++x, y += delta, output += out_stride) {
+        const int int_pel = y >> RS_SCALE_SUBPEL_BITS;
+        const int sub_pel = (y >> RS_SCALE_EXTRA_BITS) & RS_SUBPEL_MASK;
+        svt_av1_highbd_resize_vert_row(input,
+                                       in_stride,
+                                       in_length,
+                                       int_pel - SUBPEL_TAPS / 2 + 1,
+                                       interp_filters[sub_pel],
+                                       output,
+                                       width,
+                                       bd);
+    }
+}
+
+static void highbd_resize_multistep_vert(const uint16_t *const input, int in_stride, int length,
+                                         uint16_t *output, int out_stride, int olength, int width,
+                                         uint16_t *otmp, int bd) {
+    if (length == olength) {
+        for (int i = 0; i < length; ++i)
+            svt_memcpy(output + i * out_stride, input + i * in_stride, sizeof(output[0]) * width);
+        return;
+    }
+    const int steps = get_down2_steps(length, olength);
+
+    if (steps > 0) {
+        uint16_t *out            = NULL;
+        int       out_stride_s   = width;
+        int       filteredlength = length;
+
+        assert(otmp != NULL);
+        uint16_t *otmp2 = otmp + get_down2_length(length, 1) * width;
+        for (int s = 0; s < steps; ++s) {
+            const int             proj_filteredlength = get_down2_length(filteredlength, 1);
+            const uint16_t *const in                  = (s == 0 ? input : out);
+            const int             in_stride_s         = (s == 0 ? in_stride : out_stride_s);
+            if (s == steps - 1 && proj_filteredlength == olength) {
+                out          = output;
+                out_stride_s = out_stride;
+            } else {
+                out          = (s & 1) ? otmp2 : otmp;
+                out_stride_s = width;
+            }
+            highbd_down2_vert(in, in_stride_s, filteredlength, out, out_stride_s, width, bd);
+            filteredlength = proj_filteredlength;
+        }
+        if (filteredlength != olength)
+            highbd_interpolate_vert(
+                out, out_stride_s, filteredlength, output, out_stride, olength, width, bd);
+    } else {
+        highbd_interpolate_vert(input, in_stride, length, output, out_stride, olength, width, bd);
+    }
 }
 
 static EbErrorType av1_highbd_resize_plane(const uint16_t *const input, int height, int width,
@@ -734,34 +884,27 @@ static EbErrorType av1_highbd_resize_plane(const uint16_t *const input, int heig
     int       i;
     uint16_t *intbuf;
     uint16_t *tmpbuf;
-    uint16_t *arrbuf;
-    uint16_t *arrbuf2;
+    uint16_t *vtmpbuf;
 
     EB_MALLOC_ARRAY(intbuf, sizeof(uint16_t) * width2 * height);
-    EB_MALLOC_ARRAY(tmpbuf, sizeof(uint16_t) * AOMMAX(width, height));
-    EB_MALLOC_ARRAY(arrbuf, sizeof(uint16_t) * height);
-    EB_MALLOC_ARRAY(arrbuf2, sizeof(uint16_t) * height2);
-    if (intbuf == NULL || tmpbuf == NULL || arrbuf == NULL || arrbuf2 == NULL) {
+    EB_MALLOC_ARRAY(tmpbuf, sizeof(uint16_t) * width);
+    EB_MALLOC_ARRAY(vtmpbuf, sizeof(uint16_t) * width2 * height);
+    if (intbuf == NULL || tmpbuf == NULL || vtmpbuf == NULL) {
         EB_FREE(intbuf);
         EB_FREE(tmpbuf);
-        EB_FREE(arrbuf);
-        EB_FREE(arrbuf2);
+        EB_FREE(vtmpbuf);
         return EB_ErrorInsufficientResources;
     }
     for (i = 0; i < height; ++i) {
         highbd_resize_multistep(
             input + in_stride * i, width, intbuf + width2 * i, width2, tmpbuf, bd);
     }
-    for (i = 0; i < width2; ++i) {
-        highbd_fill_col_to_arr(intbuf + i, width2, height, arrbuf);
-        highbd_resize_multistep(arrbuf, height, arrbuf2, height2, tmpbuf, bd);
-        highbd_fill_arr_to_col(output + i, out_stride, height2, arrbuf2);
-    }
+    highbd_resize_multistep_vert(
+        intbuf, width2, height, output, out_stride, height2, width2, vtmpbuf, bd);
 
     EB_FREE(intbuf);
     EB_FREE(tmpbuf);
-    EB_FREE(arrbuf);
-    EB_FREE(arrbuf2);
+    EB_FREE(vtmpbuf);
 
     return EB_ErrorNone;
 }
@@ -998,7 +1141,7 @@ static void calc_superres_params(superres_params_type *spr_params, SequenceContr
         !scs_ptr->seq_header.enable_restoration) { return; }
 
     // remove assertion when rest of the modes are implemented
-    assert(superres_mode <= SUPERRES_RANDOM);
+    assert(superres_mode <= SUPERRES_RANDOM || superres_mode == SUPERRES_DYNAMIC);
 
     switch (superres_mode) {
     case SUPERRES_NONE: spr_params->superres_denom = SCALE_NUMERATOR; break;
@@ -1009,6 +1152,14 @@ static void calc_superres_params(superres_params_type *spr_params, SequenceContr
             spr_params->superres_denom = cfg_denom;
         break;
     case SUPERRES_RANDOM: spr_params->superres_denom = (uint8_t)(lcg_rand16(&seed) % 9 + 8); break;
+    case SUPERRES_DYNAMIC: {
+        const uint8_t denom = pcs_ptr->input_ptr->superres_denom;
+        spr_params->superres_denom = (denom >= SCALE_NUMERATOR &&
+                                      denom < SUPERRES_SCALE_DENOMINATOR_MIN + (1 << SUPERRES_SCALE_BITS))
+            ? denom
+            : SCALE_NUMERATOR;
+        break;
+    }
     //SUPERRES_QTHRESH and SUPERRES_AUTO are not yet implemented
     case SUPERRES_QTHRESH: break;
     case SUPERRES_AUTO: break;
@@ -1317,20 +1468,13 @@ void scale_source_references(SequenceControlSet *scs_ptr,
                                      down_ref_pic_ptr->origin_x,
                                      down_ref_pic_ptr->origin_y);
 
-                    downsample_decimation_input_picture(
+                    downsample_input_picture_pyramid(
                             pcs_ptr,
                             down_ref_pic_ptr,
                             reference_object->downscaled_quarter_decimated_picture_ptr[denom_idx],
-                            reference_object->downscaled_sixteenth_decimated_picture_ptr[denom_idx]);
-
-                    // 1/4 & 1/16 input picture downsampling through filtering
-                    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED) {
-                        downsample_filtering_input_picture(
-                                pcs_ptr,
-                                down_ref_pic_ptr,
-                                reference_object->downscaled_quarter_filtered_picture_ptr[denom_idx],
-                                reference_object->downscaled_sixteenth_filtered_picture_ptr[denom_idx]);
-                    }
+                            reference_object->downscaled_sixteenth_decimated_picture_ptr[denom_idx],
+                            reference_object->downscaled_quarter_filtered_picture_ptr[denom_idx],
+                            reference_object->downscaled_sixteenth_filtered_picture_ptr[denom_idx]);
                 }
             }
         }
@@ -1379,18 +1523,13 @@ static void scale_input_references(PictureParentControlSet *pcs_ptr,
                   input_picture_ptr->buffer_y + row * input_picture_ptr->stride_y,
                   sizeof(uint8_t) * input_picture_ptr->stride_y);
 
-    // 1/4 & 1/16 input picture decimation
-    downsample_decimation_input_picture(pcs_ptr,
-                                        padded_pic_ptr,
-                                        src_object->downscaled_quarter_decimated_picture_ptr[denom_idx],
-                                        src_object->downscaled_sixteenth_decimated_picture_ptr[denom_idx]);
-
-    // 1/4 & 1/16 input filtered picture
-    if (pcs_ptr->scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-        downsample_filtering_input_picture(pcs_ptr,
-                                           padded_pic_ptr,
-                                           src_object->downscaled_quarter_filtered_picture_ptr[denom_idx],
-                                           src_object->downscaled_sixteenth_filtered_picture_ptr[denom_idx]);
+    // 1/4 & 1/16 input picture pyramid
+    downsample_input_picture_pyramid(pcs_ptr,
+                                     padded_pic_ptr,
+                                     src_object->downscaled_quarter_decimated_picture_ptr[denom_idx],
+                                     src_object->downscaled_sixteenth_decimated_picture_ptr[denom_idx],
+                                     src_object->downscaled_quarter_filtered_picture_ptr[denom_idx],
+                                     src_object->downscaled_sixteenth_filtered_picture_ptr[denom_idx]);
 }
 
 /*
@@ -800,7 +800,9 @@ void *resource_coordination_kernel(void *input_ptr) {
             scs_ptr->tf_level = scs_ptr->static_config.tf_level ? 1 : 0;
 
             // initialize sequence level enable_superres
-            scs_ptr->seq_header.enable_superres = 0;
+            // with dynamic super-res, any frame may be scaled after the sequence header is sent
+            scs_ptr->seq_header.enable_superres =
+                scs_ptr->static_config.superres_mode == SUPERRES_DYNAMIC;
 
             if (scs_ptr->static_config.inter_intra_compound == DEFAULT) {
                 // Set inter-intra mode      Settings
@@ -253,6 +253,7 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->picture_decision_fifo_init_count = src->picture_decision_fifo_init_count;
     dst->motion_estimation_fifo_init_count = src->motion_estimation_fifo_init_count;
     dst->initial_rate_control_fifo_init_count = src->initial_rate_control_fifo_init_count;
+    dst->tpl_disp_fifo_init_count = src->tpl_disp_fifo_init_count;
     dst->picture_demux_fifo_init_count = src->picture_demux_fifo_init_count;
     dst->rate_control_tasks_fifo_init_count = src->rate_control_tasks_fifo_init_count;
     dst->rate_control_fifo_init_count = src->rate_control_fifo_init_count;
@@ -262,6 +263,7 @@ EbErrorType copy_sequence_control_set(SequenceControlSet *dst, SequenceControlSe
     dst->entropy_coding_fifo_init_count = src->entropy_coding_fifo_init_count;
     dst->picture_analysis_process_init_count = src->picture_analysis_process_init_count;
     dst->motion_estimation_process_init_count = src->motion_estimation_process_init_count;
+    dst->tpl_disp_process_init_count = src->tpl_disp_process_init_count;
     dst->source_based_operations_process_init_count =
         src->source_based_operations_process_init_count;
     dst->mode_decision_configuration_process_init_count =
@@ -168,6 +168,7 @@ typedef struct SequenceControlSet {
     uint32_t picture_decision_fifo_init_count;
     uint32_t motion_estimation_fifo_init_count;
     uint32_t initial_rate_control_fifo_init_count;
+    uint32_t tpl_disp_fifo_init_count;
     uint32_t picture_demux_fifo_init_count;
     uint32_t rate_control_tasks_fifo_init_count;
     uint32_t rate_control_fifo_init_count;
@@ -181,6 +182,7 @@ typedef struct SequenceControlSet {
     /*!< Thread count for each process */
     uint32_t picture_analysis_process_init_count;
     uint32_t motion_estimation_process_init_count;
+    uint32_t tpl_disp_process_init_count;
     uint32_t source_based_operations_process_init_count;
     uint32_t mode_decision_configuration_process_init_count;
     uint32_t enc_dec_process_init_count;
@@ -332,18 +332,71 @@ static void derive_tf_32x32_block_split_flag(MeContext *context_ptr) {
         }
     }
 }
-// Create and initialize all necessary ME context structures
+// Prepare one plane of a reference picture for the filtering: pad the chroma planes and, for
+// 10bit, pack the plane to the 16 bit buffer used by the motion compensation. The planes are
+// independent, so the segments of a picture share these jobs instead of waiting on one of them.
+static EbErrorType tf_prepare_ref_plane(PictureParentControlSet *pcs_ref,
+                                        EbPictureBufferDesc *central_picture_ptr, int plane,
+                                        uint32_t ss_x, uint32_t ss_y, EbBool is_highbd) {
+    EbPictureBufferDesc *pic_ptr = pcs_ref->enhanced_picture_ptr;
+    uint16_t             width   = pic_ptr->stride_y;
+    uint16_t             height  = (uint16_t)(pic_ptr->origin_y * 2 + pic_ptr->height);
+
+    if (plane == C_Y) {
+        if (is_highbd) {
+            EB_MALLOC_ARRAY(pcs_ref->altref_buffer_highbd[C_Y], central_picture_ptr->luma_size);
+            pack2d_src(pic_ptr->buffer_y,
+                       pic_ptr->stride_y,
+                       pic_ptr->buffer_bit_inc_y,
+                       pic_ptr->stride_bit_inc_y,
+                       pcs_ref->altref_buffer_highbd[C_Y],
+                       pic_ptr->stride_y,
+                       width,
+                       height);
+        }
+        return EB_ErrorNone;
+    }
+
+    EbByte   buffer         = plane == C_U ? pic_ptr->buffer_cb : pic_ptr->buffer_cr;
+    EbByte   buffer_bit_inc = plane == C_U ? pic_ptr->buffer_bit_inc_cb : pic_ptr->buffer_bit_inc_cr;
+    uint16_t stride         = plane == C_U ? pic_ptr->stride_cb : pic_ptr->stride_cr;
+    uint16_t stride_bit_inc = plane == C_U ? pic_ptr->stride_bit_inc_cb : pic_ptr->stride_bit_inc_cr;
+
+    generate_padding(buffer,
+                     stride,
+                     pic_ptr->width >> ss_x,
+                     pic_ptr->height >> ss_y,
+                     pic_ptr->origin_x >> ss_x,
+                     pic_ptr->origin_y >> ss_y);
+    if (is_highbd) {
+        // same stride as generate_padding_pic()
+        generate_padding(buffer_bit_inc,
+                         pic_ptr->stride_cr,
+                         pic_ptr->width >> ss_x,
+                         pic_ptr->height >> ss_y,
+                         pic_ptr->origin_x >> ss_x,
+                         pic_ptr->origin_y >> ss_y);
+        EB_MALLOC_ARRAY(pcs_ref->altref_buffer_highbd[plane], central_picture_ptr->chroma_size);
+        pack2d_src(buffer,
+                   stride,
+                   buffer_bit_inc,
+                   stride_bit_inc,
+                   pcs_ref->altref_buffer_highbd[plane],
+                   stride,
+                   width >> ss_x,
+                   height >> ss_y);
+    }
+    return EB_ErrorNone;
+}
+
+// Initialize the ME context with the central picture block. The source block buffers do not
+// depend on the frame being filtered, so this is done once per block for all the frames.
 static void create_me_context_and_picture_control(
-    MotionEstimationContext_t *context_ptr, PictureParentControlSet *picture_control_set_ptr_frame,
-    PictureParentControlSet *picture_control_set_ptr_central,
+    MotionEstimationContext_t *context_ptr, PictureParentControlSet *picture_control_set_ptr_central,
     EbPictureBufferDesc *input_picture_ptr_central, int blk_row, int blk_col, uint32_t ss_x,
     uint32_t ss_y) {
     uint32_t sb_row;
 
-    // set reference picture for alt-refs
-    context_ptr->me_context_ptr->alt_ref_reference_ptr =
-        (EbPaReferenceObject *)
-            picture_control_set_ptr_frame->pa_reference_picture_wrapper_ptr->object_ptr;
     context_ptr->me_context_ptr->me_alt_ref = EB_TRUE;
 
     // set the buffers with the original, quarter and sixteenth pixels version of the source frame
@@ -1611,6 +1664,9 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
             // Perform 1/4 Pel MV Refinement
             for (signed short i = -2; i <= 2; i = i + 2) {
                 for (signed short j = -2; j <= 2; j = j + 2) {
+                    // Center is the best of the previous stage, its error is known
+                    if (i == 0 && j == 0)
+                        continue;
 
                     mv_unit.mv->x = mv_x + i;
                     mv_unit.mv->y = mv_y + j;
@@ -1684,6 +1740,9 @@ static void tf_16x16_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
             if (context_ptr->high_precision)
             for (signed short i = -1; i <= 1; i++) {
                 for (signed short j = -1; j <= 1; j++) {
+                    // Center is the best of the previous stage, its error is known
+                    if (i == 0 && j == 0)
+                        continue;
                     mv_unit.mv->x = mv_x + i;
                     mv_unit.mv->y = mv_y + j;
 
@@ -1918,6 +1977,9 @@ static void tf_32x32_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
         // Perform 1/4 Pel MV Refinement
         for (signed short i = -2; i <= 2; i = i + 2) {
             for (signed short j = -2; j <= 2; j = j + 2) {
+                // Center is the best of the previous stage, its error is known
+                if (i == 0 && j == 0)
+                    continue;
 
                 mv_unit.mv->x = mv_x + i;
                 mv_unit.mv->y = mv_y + j;
@@ -1989,6 +2051,9 @@ static void tf_32x32_sub_pel_search(PictureParentControlSet *pcs_ptr, MeContext
         if (context_ptr->high_precision)
         for (signed short i = -1; i <= 1; i++) {
             for (signed short j = -1; j <= 1; j++) {
+                // Center is the best of the previous stage, its error is known
+                if (i == 0 && j == 0)
+                    continue;
                 mv_unit.mv->x = mv_x + i;
                 mv_unit.mv->y = mv_y + j;
 
@@ -2433,6 +2498,15 @@ static EbErrorType produce_temporally_filtered_pic(
             memset(accumulator, 0, BLK_PELS * COLOR_CHANNELS * sizeof(accumulator[0]));
             memset(counter, 0, BLK_PELS * COLOR_CHANNELS * sizeof(counter[0]));
 
+            // Initialize ME context
+            create_me_context_and_picture_control(me_context_ptr,
+                                                  list_picture_control_set_ptr[index_center],
+                                                  input_picture_ptr_central,
+                                                  blk_row,
+                                                  blk_col,
+                                                  ss_x,
+                                                  ss_y);
+
             // for every frame to filter
             for (int frame_index = 0;
                  frame_index < (picture_control_set_ptr_central->past_altref_nframes +
@@ -2498,16 +2572,10 @@ static EbErrorType produce_temporally_filtered_pic(
                     }
 
                 } else {
-                    // Initialize ME context
-                    create_me_context_and_picture_control(
-                        me_context_ptr,
-                        list_picture_control_set_ptr[frame_index],
-                        list_picture_control_set_ptr[index_center],
-                        input_picture_ptr_central,
-                        blk_row,
-                        blk_col,
-                        ss_x,
-                        ss_y);
+                    // set reference picture for alt-refs
+                    me_context_ptr->me_context_ptr->alt_ref_reference_ptr =
+                        (EbPaReferenceObject *)list_picture_control_set_ptr[frame_index]
+                            ->pa_reference_picture_wrapper_ptr->object_ptr;
 
                     // Perform ME - context_ptr will store the outputs (MVs, buffers, etc)
                     // Block-based MC using open-loop HME + refinement
@@ -2803,18 +2871,14 @@ void pad_and_decimate_filtered_pic(
                      padded_pic_ptr->origin_x,
                      padded_pic_ptr->origin_y);
 
-    // 1/4 & 1/16 input picture decimation
-    downsample_decimation_input_picture(picture_control_set_ptr_central,
-                                        padded_pic_ptr,
-                                        src_object->quarter_decimated_picture_ptr,
-                                        src_object->sixteenth_decimated_picture_ptr);
-
-    // 1/4 & 1/16 input picture downsampling through filtering
-    if (scs_ptr->down_sampling_method_me_search == ME_FILTERED_DOWNSAMPLED)
-        downsample_filtering_input_picture(picture_control_set_ptr_central,
-                                           padded_pic_ptr,
-                                           src_object->quarter_filtered_picture_ptr,
-                                           src_object->sixteenth_filtered_picture_ptr);
+    // 1/4 & 1/16 input picture pyramid
+    downsample_input_picture_pyramid(picture_control_set_ptr_central,
+                                     padded_pic_ptr,
+                                     src_object->quarter_decimated_picture_ptr,
+                                     src_object->sixteenth_decimated_picture_ptr,
+                                     src_object->quarter_filtered_picture_ptr,
+                                     src_object->sixteenth_filtered_picture_ptr);
+    src_object->gm_corners_valid = EB_FALSE;
 }
 
 // save original enchanced_picture_ptr buffer in a separate buffer (to be replaced by the temporally filtered pic)
@@ -2946,22 +3010,8 @@ EbErrorType svt_av1_init_temporal_filtering(
                                is_highbd,
                                encoder_bit_depth);
 
-        // Pad chroma reference samples - once only per picture
-        for (int i = 0; i < (picture_control_set_ptr_central->past_altref_nframes +
-                             picture_control_set_ptr_central->future_altref_nframes + 1);
-             i++) {
-            EbPictureBufferDesc *pic_ptr_ref =
-                list_picture_control_set_ptr[i]->enhanced_picture_ptr;
-            generate_padding_pic(pic_ptr_ref, ss_x, ss_y, is_highbd);
-            //10bit: for all the reference pictures do the packing once at the beggining.
-            if (is_highbd && i != picture_control_set_ptr_central->past_altref_nframes) {
-                EB_MALLOC_ARRAY(list_picture_control_set_ptr[i]->altref_buffer_highbd[C_Y], central_picture_ptr->luma_size);
-                EB_MALLOC_ARRAY(list_picture_control_set_ptr[i]->altref_buffer_highbd[C_U], central_picture_ptr->chroma_size);
-                EB_MALLOC_ARRAY(list_picture_control_set_ptr[i]->altref_buffer_highbd[C_V], central_picture_ptr->chroma_size);
-                // pack byte buffers to 16 bit buffer
-                pack_highbd_pic(pic_ptr_ref, list_picture_control_set_ptr[i]->altref_buffer_highbd, ss_x, ss_y, EB_TRUE);
-            }
-        }
+        // Pad chroma samples of the central picture; the reference pictures are prepared below
+        generate_padding_pic(central_picture_ptr, ss_x, ss_y, is_highbd);
 
         picture_control_set_ptr_central->temporal_filtering_on =
             EB_TRUE; // set temporal filtering flag ON for current picture
@@ -2973,6 +3023,50 @@ EbErrorType svt_av1_init_temporal_filtering(
         }
     }
     svt_release_mutex(picture_control_set_ptr_central->temp_filt_mutex);
+
+    // Prepare the reference pictures plane by plane; every segment takes jobs until none is
+    // left, then waits for the jobs taken by the other segments.
+    EbErrorType return_error     = EB_ErrorNone;
+    const int   num_ref_frames   = picture_control_set_ptr_central->past_altref_nframes +
+        picture_control_set_ptr_central->future_altref_nframes;
+    const int   planes_per_frame = is_highbd ? 3 : 2;
+    const int   prep_job_count   = num_ref_frames * planes_per_frame;
+    for (;;) {
+        svt_block_on_mutex(picture_control_set_ptr_central->temp_filt_mutex);
+        const int job_idx = picture_control_set_ptr_central->temp_filt_prep_job_next;
+        if (job_idx < prep_job_count)
+            picture_control_set_ptr_central->temp_filt_prep_job_next++;
+        svt_release_mutex(picture_control_set_ptr_central->temp_filt_mutex);
+        if (job_idx >= prep_job_count)
+            break;
+
+        int       frame_index = job_idx / planes_per_frame;
+        const int plane       = (job_idx % planes_per_frame) + (is_highbd ? C_Y : C_U);
+        if (frame_index >= index_center)
+            frame_index++;
+        EbErrorType err = tf_prepare_ref_plane(list_picture_control_set_ptr[frame_index],
+                                               central_picture_ptr,
+                                               plane,
+                                               ss_x,
+                                               ss_y,
+                                               is_highbd);
+        if (err != EB_ErrorNone)
+            return_error = err;
+
+        svt_block_on_mutex(picture_control_set_ptr_central->temp_filt_mutex);
+        const EbBool all_done =
+            ++picture_control_set_ptr_central->temp_filt_prep_job_done == prep_job_count;
+        svt_release_mutex(picture_control_set_ptr_central->temp_filt_mutex);
+        if (all_done)
+            for (int seg_idx = 0; seg_idx < picture_control_set_ptr_central->tf_segments_total_count;
+                 seg_idx++)
+                svt_post_semaphore(picture_control_set_ptr_central->temp_filt_prep_done_semaphore);
+    }
+    if (prep_job_count)
+        svt_block_on_semaphore(picture_control_set_ptr_central->temp_filt_prep_done_semaphore);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+
     me_context_ptr->me_context_ptr->min_frame_size = MIN(picture_control_set_ptr_central->aligned_height, picture_control_set_ptr_central->aligned_width);
     // index of the central source frame
    // index_center = picture_control_set_ptr_central->past_altref_nframes;
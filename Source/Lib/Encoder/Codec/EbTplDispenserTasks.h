@@ -0,0 +1,44 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+#ifndef EbTplDispenserTasks_h
+#define EbTplDispenserTasks_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+#include "EbObject.h"
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**************************************
+     * Process Results
+     **************************************/
+typedef struct TplDispenserTasks {
+    EbDctor          dctor;
+    EbObjectWrapper *pcs_wrapper_ptr;
+    int32_t          frame_idx; // position of the picture in the TPL sliding window
+    uint16_t         sb_row_index; // 64x64 SB row to dispense
+} TplDispenserTasks;
+
+typedef struct TplDispenserTasksInitData {
+    int32_t junk;
+} TplDispenserTasksInitData;
+
+/**************************************
+     * Extern Function Declarations
+     **************************************/
+extern EbErrorType tpl_dispenser_tasks_creator(EbPtr *object_dbl_ptr, EbPtr object_init_data_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbTplDispenserTasks_h
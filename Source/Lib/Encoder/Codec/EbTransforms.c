@@ -2839,6 +2839,74 @@ void svt_av1_transform_two_d_4x4_c(int16_t *input, int32_t *output, uint32_t inp
         input, input_stride, output, &cfg, intermediate_transform_buffer, bit_depth);
 }
 
+/*********************************************************************
+* Split 2D forward transform
+*   The column pass only depends on the vertical 1D type, so a tx type
+*   search can run it once per vertical type and then finish every 2D
+*   type sharing it with the row pass. buf holds the column output in
+*   raster order, before the left/right flip which the row pass applies.
+*   Column pass followed by row pass is bit-exact with the 2D transform.
+*********************************************************************/
+void svt_av1_fwd_txfm2d_col_c(int16_t *input, int32_t *buf, uint32_t input_stride,
+                              TxSize transform_size, TxType transform_type, uint8_t bit_depth) {
+    int32_t       temp_in[64], temp_out[64];
+    int8_t        stage_range_col[MAX_TXFM_STAGE_NUM];
+    int8_t        stage_range_row[MAX_TXFM_STAGE_NUM];
+    Txfm2dFlipCfg cfg;
+
+    av1_transform_config(transform_type, transform_size, &cfg);
+    svt_av1_gen_fwd_stage_range(stage_range_col, stage_range_row, &cfg, bit_depth);
+
+    const int32_t  txfm_size_col = tx_size_wide[transform_size];
+    const int32_t  txfm_size_row = tx_size_high[transform_size];
+    const int8_t * shift         = cfg.shift;
+    const TxfmFunc txfm_func_col = fwd_txfm_type_to_func(cfg.txfm_type_col);
+
+    for (int32_t c = 0; c < txfm_size_col; ++c) {
+        if (cfg.ud_flip == 0)
+            for (int32_t r = 0; r < txfm_size_row; ++r) temp_in[r] = input[r * input_stride + c];
+        else
+            for (int32_t r = 0; r < txfm_size_row; ++r)
+                temp_in[r] = input[(txfm_size_row - r - 1) * input_stride + c];
+        svt_av1_round_shift_array_c(temp_in, txfm_size_row, -shift[0]);
+        txfm_func_col(temp_in, temp_out, cfg.cos_bit_col, stage_range_col);
+        svt_av1_round_shift_array_c(temp_out, txfm_size_row, -shift[1]);
+        for (int32_t r = 0; r < txfm_size_row; ++r) buf[r * txfm_size_col + c] = temp_out[r];
+    }
+}
+
+void svt_av1_fwd_txfm2d_row_c(const int32_t *buf, int32_t *output, TxSize transform_size,
+                              TxType transform_type, uint8_t bit_depth) {
+    int32_t       temp_in[64];
+    int8_t        stage_range_col[MAX_TXFM_STAGE_NUM];
+    int8_t        stage_range_row[MAX_TXFM_STAGE_NUM];
+    Txfm2dFlipCfg cfg;
+
+    av1_transform_config(transform_type, transform_size, &cfg);
+    svt_av1_gen_fwd_stage_range(stage_range_col, stage_range_row, &cfg, bit_depth);
+
+    const int32_t  txfm_size_col = tx_size_wide[transform_size];
+    const int32_t  txfm_size_row = tx_size_high[transform_size];
+    const int8_t * shift         = cfg.shift;
+    const int32_t  rect_type     = get_rect_tx_log_ratio(txfm_size_col, txfm_size_row);
+    const TxfmFunc txfm_func_row = fwd_txfm_type_to_func(cfg.txfm_type_row);
+
+    for (int32_t r = 0; r < txfm_size_row; ++r) {
+        const int32_t *buf_row = buf + r * txfm_size_col;
+        int32_t *      out_row = output + r * txfm_size_col;
+        if (cfg.lr_flip == 0)
+            for (int32_t c = 0; c < txfm_size_col; ++c) temp_in[c] = buf_row[c];
+        else
+            for (int32_t c = 0; c < txfm_size_col; ++c)
+                temp_in[c] = buf_row[txfm_size_col - c - 1];
+        txfm_func_row(temp_in, out_row, cfg.cos_bit_row, stage_range_row);
+        svt_av1_round_shift_array_c(out_row, txfm_size_col, -shift[2]);
+        if (abs(rect_type) == 1)
+            for (int32_t c = 0; c < txfm_size_col; ++c)
+                out_row[c] = round_shift((int64_t)out_row[c] * new_sqrt2, new_sqrt2_bits);
+    }
+}
+
 /*********************************************************************
 * Calculate CBF
 *********************************************************************/
@@ -289,6 +289,8 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
     svt_av1_fwd_txfm2d_16x16 = svt_av1_transform_two_d_16x16_c;
 
     svt_av1_fwd_txfm2d_8x8 = svt_av1_transform_two_d_8x8_c;
+    svt_av1_fwd_txfm2d_col = svt_av1_fwd_txfm2d_col_c;
+    svt_av1_fwd_txfm2d_row = svt_av1_fwd_txfm2d_row_c;
     svt_av1_fwd_txfm2d_4x4 = svt_av1_transform_two_d_4x4_c;
 
     svt_handle_transform16x64 = svt_handle_transform16x64_c;
@@ -328,15 +330,34 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
     svt_compute_interm_var_four8x8 = svt_compute_interm_var_four8x8_c;
     sad_16b_kernel = sad_16b_kernel_c;
     svt_av1_compute_cross_correlation = svt_av1_compute_cross_correlation_c;
+    svt_av1_ransac_find_inliers = svt_av1_ransac_find_inliers_c;
+    svt_av1_get_crc32c_value = svt_av1_get_crc32c_value_c;
+    svt_av1_get_block_2x2_hash_row = svt_av1_get_block_2x2_hash_row_c;
+    svt_av1_count_colors = svt_av1_count_colors_c;
+    svt_av1_count_colors_highbd = svt_av1_count_colors_highbd_c;
     svt_av1_k_means_dim1 = av1_k_means_dim1_c;
     svt_av1_k_means_dim2 = av1_k_means_dim2_c;
     svt_av1_calc_indices_dim1 = av1_calc_indices_dim1_c;
     svt_av1_calc_indices_dim2 = av1_calc_indices_dim2_c;
 
     svt_av1_get_nz_map_contexts = svt_av1_get_nz_map_contexts_c;
+    svt_av1_cost_coeffs_txb_inner = svt_av1_cost_coeffs_txb_inner_c;
+    svt_av1_update_coeff_eob_fast = svt_av1_update_coeff_eob_fast_c;
 
     variance_highbd = variance_highbd_c;
     svt_av1_haar_ac_sad_8x8_uint8_input = svt_av1_haar_ac_sad_8x8_uint8_input_c;
+    svt_av1_add_block_observations_internal = svt_av1_add_block_observations_internal_c;
+    svt_av1_down2_symeven = svt_av1_down2_symeven_c;
+    svt_av1_down2_symodd = svt_av1_down2_symodd_c;
+    svt_av1_interpolate_core = svt_av1_interpolate_core_c;
+    svt_av1_resize_vert_row = svt_av1_resize_vert_row_c;
+    svt_av1_highbd_down2_symeven = svt_av1_highbd_down2_symeven_c;
+    svt_av1_highbd_down2_symodd = svt_av1_highbd_down2_symodd_c;
+    svt_av1_highbd_interpolate_core = svt_av1_highbd_interpolate_core_c;
+    svt_av1_highbd_resize_vert_row = svt_av1_highbd_resize_vert_row_c;
+    decimation_2d = decimation_2d_c;
+    downsample_2d = downsample_2d_c;
+    calculate_histogram = calculate_histogram_c;
 
 #ifdef ARCH_X86_64
     flags &= get_cpu_flags_to_use();
@@ -641,6 +662,19 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
                     SET_AVX2(svt_av1_compute_cross_correlation,
                         svt_av1_compute_cross_correlation_c,
                         svt_av1_compute_cross_correlation_avx2);
+                    SET_AVX2(svt_av1_ransac_find_inliers,
+                        svt_av1_ransac_find_inliers_c,
+                        svt_av1_ransac_find_inliers_avx2);
+                    SET_AVX2(svt_av1_get_crc32c_value,
+                        svt_av1_get_crc32c_value_c,
+                        svt_av1_get_crc32c_value_avx2);
+                    SET_AVX2(svt_av1_get_block_2x2_hash_row,
+                        svt_av1_get_block_2x2_hash_row_c,
+                        svt_av1_get_block_2x2_hash_row_avx2);
+                    SET_AVX2(svt_av1_count_colors, svt_av1_count_colors_c, svt_av1_count_colors_avx2);
+                    SET_AVX2(svt_av1_count_colors_highbd,
+                        svt_av1_count_colors_highbd_c,
+                        svt_av1_count_colors_highbd_avx2);
                     SET_AVX2(svt_av1_k_means_dim1, av1_k_means_dim1_c, av1_k_means_dim1_avx2);
                     SET_AVX2(svt_av1_k_means_dim2, av1_k_means_dim2_c, av1_k_means_dim2_avx2);
                     SET_AVX2(svt_av1_calc_indices_dim1, av1_calc_indices_dim1_c, av1_calc_indices_dim1_avx2);
@@ -651,6 +685,44 @@ void setup_rtcd_internal(CPU_FLAGS flags) {
                     SET_AVX2(svt_av1_haar_ac_sad_8x8_uint8_input,
                              svt_av1_haar_ac_sad_8x8_uint8_input_c,
                              svt_av1_haar_ac_sad_8x8_uint8_input_avx2);
+                    SET_AVX2(svt_av1_add_block_observations_internal,
+                             svt_av1_add_block_observations_internal_c,
+                             svt_av1_add_block_observations_internal_avx2);
+                    SET_AVX2(svt_av1_down2_symeven, svt_av1_down2_symeven_c, svt_av1_down2_symeven_avx2);
+                    SET_AVX2(svt_av1_down2_symodd, svt_av1_down2_symodd_c, svt_av1_down2_symodd_avx2);
+                    SET_AVX2(svt_av1_interpolate_core,
+                             svt_av1_interpolate_core_c,
+                             svt_av1_interpolate_core_avx2);
+                    SET_AVX2(svt_av1_resize_vert_row,
+                             svt_av1_resize_vert_row_c,
+                             svt_av1_resize_vert_row_avx2);
+                    SET_AVX2(svt_av1_highbd_down2_symeven,
+                             svt_av1_highbd_down2_symeven_c,
+                             svt_av1_highbd_down2_symeven_avx2);
+                    SET_AVX2(svt_av1_highbd_down2_symodd,
+                             svt_av1_highbd_down2_symodd_c,
+                             svt_av1_highbd_down2_symodd_avx2);
+                    SET_AVX2(svt_av1_highbd_interpolate_core,
+                             svt_av1_highbd_interpolate_core_c,
+                             svt_av1_highbd_interpolate_core_avx2);
+                    SET_AVX2(svt_av1_highbd_resize_vert_row,
+                             svt_av1_highbd_resize_vert_row_c,
+                             svt_av1_highbd_resize_vert_row_avx2);
+                    SET_AVX2(decimation_2d, decimation_2d_c, decimation_2d_avx2);
+                    SET_AVX2(downsample_2d, downsample_2d_c, downsample_2d_avx2);
+                    SET_AVX2(calculate_histogram, calculate_histogram_c, calculate_histogram_avx2);
+                    SET_AVX2(svt_av1_cost_coeffs_txb_inner,
+                             svt_av1_cost_coeffs_txb_inner_c,
+                             svt_av1_cost_coeffs_txb_inner_avx2);
+                    SET_AVX2(svt_av1_update_coeff_eob_fast,
+                             svt_av1_update_coeff_eob_fast_c,
+                             svt_av1_update_coeff_eob_fast_avx2);
+                    SET_AVX2(svt_av1_fwd_txfm2d_col,
+                             svt_av1_fwd_txfm2d_col_c,
+                             svt_av1_fwd_txfm2d_col_avx2);
+                    SET_AVX2(svt_av1_fwd_txfm2d_row,
+                             svt_av1_fwd_txfm2d_row_c,
+                             svt_av1_fwd_txfm2d_row_avx2);
 #endif
 
 }
@@ -133,6 +133,10 @@ extern "C" {
     RTCD_EXTERN void(*svt_av1_fwd_txfm2d_16x16)(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     void svt_av1_transform_two_d_8x8_c(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     RTCD_EXTERN void(*svt_av1_fwd_txfm2d_8x8)(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
+    void svt_av1_fwd_txfm2d_col_c(int16_t *input, int32_t *buf, uint32_t input_stride, TxSize transform_size, TxType transform_type, uint8_t bit_depth);
+    RTCD_EXTERN void(*svt_av1_fwd_txfm2d_col)(int16_t *input, int32_t *buf, uint32_t input_stride, TxSize transform_size, TxType transform_type, uint8_t bit_depth);
+    void svt_av1_fwd_txfm2d_row_c(const int32_t *buf, int32_t *output, TxSize transform_size, TxType transform_type, uint8_t bit_depth);
+    RTCD_EXTERN void(*svt_av1_fwd_txfm2d_row)(const int32_t *buf, int32_t *output, TxSize transform_size, TxType transform_type, uint8_t bit_depth);
     void svt_av1_transform_two_d_4x4_c(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     RTCD_EXTERN void(*svt_av1_fwd_txfm2d_4x4)(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     int svt_aom_satd_c(const TranLow *coeff, int length);
@@ -503,6 +507,10 @@ extern "C" {
     RTCD_EXTERN void(*svt_aom_fft8x8_float)(const float *input, float *temp, float *output);
     void svt_av1_get_nz_map_contexts_c(const uint8_t *const levels, const int16_t *const scan, const uint16_t eob, const TxSize tx_size, const TxClass tx_class, int8_t *const coeff_contexts);
     RTCD_EXTERN void(*svt_av1_get_nz_map_contexts)(const uint8_t *const levels, const int16_t *const scan, const uint16_t eob, const TxSize tx_size, const TxClass tx_class, int8_t *const coeff_contexts);
+    int32_t svt_av1_cost_coeffs_txb_inner_c(const uint8_t *const levels, const int16_t *const scan, const TranLow *const qcoeff, const int8_t *const coeff_contexts, const int32_t (*base_cost)[8], const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob, const int32_t bwl, const TxClass tx_class);
+    RTCD_EXTERN int32_t(*svt_av1_cost_coeffs_txb_inner)(const uint8_t *const levels, const int16_t *const scan, const TranLow *const qcoeff, const int8_t *const coeff_contexts, const int32_t (*base_cost)[8], const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob, const int32_t bwl, const TxClass tx_class);
+    void svt_av1_update_coeff_eob_fast_c(uint16_t *eob, int shift, const int16_t *dequant_ptr, const int16_t *scan, const TranLow *coeff_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr);
+    RTCD_EXTERN void(*svt_av1_update_coeff_eob_fast)(uint16_t *eob, int shift, const int16_t *dequant_ptr, const int16_t *scan, const TranLow *coeff_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr);
     RTCD_EXTERN void(*svt_sad_loop_kernel)(uint8_t *src, uint32_t src_stride, uint8_t *ref, uint32_t ref_stride, uint32_t block_height, uint32_t block_width, uint64_t *best_sad, int16_t *x_search_center, int16_t *y_search_center, uint32_t src_stride_raw, int16_t search_area_width, int16_t search_area_height);
     void svt_av1_txb_init_levels_c(const TranLow *const coeff, const int32_t width, const int32_t height, uint8_t *const levels);
     RTCD_EXTERN void(*svt_av1_txb_init_levels)(const TranLow *const coeff, const int32_t width, const int32_t height, uint8_t *const levels);
@@ -510,6 +518,16 @@ extern "C" {
     RTCD_EXTERN void(*svt_av1_get_gradient_hist)(const uint8_t *src, int src_stride, int rows, int cols, uint64_t *hist);
     double svt_av1_compute_cross_correlation_c(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
     RTCD_EXTERN double(*svt_av1_compute_cross_correlation)(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+    int svt_av1_ransac_find_inliers_c(const double *mat, const double *corners1, const double *corners2, int npoints, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    RTCD_EXTERN int(*svt_av1_ransac_find_inliers)(const double *mat, const double *corners1, const double *corners2, int npoints, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    uint32_t svt_av1_get_crc32c_value_c(void *crc_calculator, uint8_t *p, size_t length);
+    RTCD_EXTERN uint32_t(*svt_av1_get_crc32c_value)(void *crc_calculator, uint8_t *p, size_t length);
+    void svt_av1_get_block_2x2_hash_row_c(const uint8_t *src, int stride, int width, void *crc_calculator1, void *crc_calculator2, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
+    RTCD_EXTERN void(*svt_av1_get_block_2x2_hash_row)(const uint8_t *src, int stride, int width, void *crc_calculator1, void *crc_calculator2, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
+    int svt_av1_count_colors_c(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    RTCD_EXTERN int(*svt_av1_count_colors)(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    int svt_av1_count_colors_highbd_c(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
+    RTCD_EXTERN int(*svt_av1_count_colors_highbd)(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
     void av1_k_means_dim1_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     RTCD_EXTERN void(*svt_av1_k_means_dim1)(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
     void av1_k_means_dim2_c(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
@@ -563,6 +581,30 @@ extern "C" {
     uint32_t variance_highbd_c(const uint16_t *a, int a_stride, const uint16_t *b, int b_stride, int w, int h, uint32_t *sse);
     RTCD_EXTERN int(*svt_av1_haar_ac_sad_8x8_uint8_input)(uint8_t *input, int stride, int hbd);
     int svt_av1_haar_ac_sad_8x8_uint8_input_c(uint8_t *input, int stride, int hbd);
+    void svt_av1_add_block_observations_internal_c(uint32_t n, const double *buffer, double val, double norm_sq, double *A, double *b);
+    RTCD_EXTERN void(*svt_av1_add_block_observations_internal)(uint32_t n, const double *buffer, double val, double norm_sq, double *A, double *b);
+    void svt_av1_down2_symeven_c(const uint8_t *const input, int length, uint8_t *output);
+    RTCD_EXTERN void(*svt_av1_down2_symeven)(const uint8_t *const input, int length, uint8_t *output);
+    void svt_av1_down2_symodd_c(const uint8_t *const input, int length, uint8_t *output);
+    RTCD_EXTERN void(*svt_av1_down2_symodd)(const uint8_t *const input, int length, uint8_t *output);
+    void svt_av1_interpolate_core_c(const uint8_t *const input, int in_length, uint8_t *output, int out_length, const int16_t *interp_filters, int interp_taps);
+    RTCD_EXTERN void(*svt_av1_interpolate_core)(const uint8_t *const input, int in_length, uint8_t *output, int out_length, const int16_t *interp_filters, int interp_taps);
+    void svt_av1_resize_vert_row_c(const uint8_t *const input, int in_stride, int in_length, int first_row, const int16_t *filter, uint8_t *output, int width);
+    RTCD_EXTERN void(*svt_av1_resize_vert_row)(const uint8_t *const input, int in_stride, int in_length, int first_row, const int16_t *filter, uint8_t *output, int width);
+    void svt_av1_highbd_down2_symeven_c(const uint16_t *const input, int length, uint16_t *output, int bd);
+    RTCD_EXTERN void(*svt_av1_highbd_down2_symeven)(const uint16_t *const input, int length, uint16_t *output, int bd);
+    void svt_av1_highbd_down2_symodd_c(const uint16_t *const input, int length, uint16_t *output, int bd);
+    RTCD_EXTERN void(*svt_av1_highbd_down2_symodd)(const uint16_t *const input, int length, uint16_t *output, int bd);
+    void svt_av1_highbd_interpolate_core_c(const uint16_t *const input, int in_length, uint16_t *output, int out_length, int bd, const int16_t *interp_filters, int interp_taps);
+    RTCD_EXTERN void(*svt_av1_highbd_interpolate_core)(const uint16_t *const input, int in_length, uint16_t *output, int out_length, int bd, const int16_t *interp_filters, int interp_taps);
+    void svt_av1_highbd_resize_vert_row_c(const uint16_t *const input, int in_stride, int in_length, int first_row, const int16_t *filter, uint16_t *output, int width, int bd);
+    RTCD_EXTERN void(*svt_av1_highbd_resize_vert_row)(const uint16_t *const input, int in_stride, int in_length, int first_row, const int16_t *filter, uint16_t *output, int width, int bd);
+    void decimation_2d_c(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    RTCD_EXTERN void(*decimation_2d)(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    void downsample_2d_c(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    RTCD_EXTERN void(*downsample_2d)(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    void calculate_histogram_c(uint8_t *input_samples, uint32_t input_area_width, uint32_t input_area_height, uint32_t stride, uint8_t decim_step, uint32_t *histogram, uint64_t *sum);
+    RTCD_EXTERN void(*calculate_histogram)(uint8_t *input_samples, uint32_t input_area_width, uint32_t input_area_height, uint32_t stride, uint8_t decim_step, uint32_t *histogram, uint64_t *sum);
 #ifdef ARCH_X86_64
     uint32_t combined_averaging_ssd_avx2(uint8_t *src, ptrdiff_t src_stride, uint8_t *ref1, ptrdiff_t ref1_stride, uint8_t *ref2, ptrdiff_t ref2_stride, uint32_t height, uint32_t width);
     uint32_t combined_averaging_ssd_avx512(uint8_t *src, ptrdiff_t src_stride, uint8_t *ref1, ptrdiff_t ref1_stride, uint8_t *ref2, ptrdiff_t ref2_stride, uint32_t height, uint32_t width);
@@ -1029,6 +1071,12 @@ extern "C" {
     void svt_av1_get_gradient_hist_avx2(const uint8_t *src, int src_stride, int rows, int cols, uint64_t *hist);
 
     double svt_av1_compute_cross_correlation_avx2(unsigned char *im1, int stride1, int x1, int y1, unsigned char *im2, int stride2, int x2, int y2);
+    int svt_av1_ransac_find_inliers_avx2(const double *mat, const double *corners1, const double *corners2, int npoints, int *inlier_indices, double *sum_distance, double *sum_distance_squared);
+    uint32_t svt_av1_get_crc32c_value_avx2(void *crc_calculator, uint8_t *p, size_t length);
+    void svt_av1_get_block_2x2_hash_row_avx2(const uint8_t *src, int stride, int width, void *crc_calculator1, void *crc_calculator2, uint32_t *hash1, uint32_t *hash2, int8_t *row_same, int8_t *col_same);
+
+    int svt_av1_count_colors_avx2(const uint8_t *src, int stride, int rows, int cols, int *val_count);
+    int svt_av1_count_colors_highbd_avx2(uint16_t *src, int stride, int rows, int cols, int bit_depth, int *val_count);
 
     void av1_k_means_dim1_avx2(const int* data, int* centroids, uint8_t* indices, int n, int k, int max_itr);
 
@@ -1125,6 +1173,22 @@ extern "C" {
     uint32_t variance_highbd_avx2(const uint16_t *a, int a_stride, const uint16_t *b, int b_stride,
                               int w, int h, uint32_t *sse);
     int svt_av1_haar_ac_sad_8x8_uint8_input_avx2(uint8_t *input, int stride, int hbd);
+    void svt_av1_add_block_observations_internal_avx2(uint32_t n, const double *buffer, double val, double norm_sq, double *A, double *b);
+    void svt_av1_down2_symeven_avx2(const uint8_t *const input, int length, uint8_t *output);
+    void svt_av1_down2_symodd_avx2(const uint8_t *const input, int length, uint8_t *output);
+    void svt_av1_interpolate_core_avx2(const uint8_t *const input, int in_length, uint8_t *output, int out_length, const int16_t *interp_filters, int interp_taps);
+    void svt_av1_resize_vert_row_avx2(const uint8_t *const input, int in_stride, int in_length, int first_row, const int16_t *filter, uint8_t *output, int width);
+    void svt_av1_highbd_down2_symeven_avx2(const uint16_t *const input, int length, uint16_t *output, int bd);
+    void svt_av1_highbd_down2_symodd_avx2(const uint16_t *const input, int length, uint16_t *output, int bd);
+    void svt_av1_highbd_interpolate_core_avx2(const uint16_t *const input, int in_length, uint16_t *output, int out_length, int bd, const int16_t *interp_filters, int interp_taps);
+    void svt_av1_highbd_resize_vert_row_avx2(const uint16_t *const input, int in_stride, int in_length, int first_row, const int16_t *filter, uint16_t *output, int width, int bd);
+    void decimation_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    void downsample_2d_avx2(uint8_t *input_samples, uint32_t input_stride, uint32_t input_area_width, uint32_t input_area_height, uint8_t *decim_samples, uint32_t decim_stride, uint32_t decim_step);
+    void calculate_histogram_avx2(uint8_t *input_samples, uint32_t input_area_width, uint32_t input_area_height, uint32_t stride, uint8_t decim_step, uint32_t *histogram, uint64_t *sum);
+    int32_t svt_av1_cost_coeffs_txb_inner_avx2(const uint8_t *const levels, const int16_t *const scan, const TranLow *const qcoeff, const int8_t *const coeff_contexts, const int32_t (*base_cost)[8], const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1], const uint16_t eob, const int32_t bwl, const TxClass tx_class);
+    void svt_av1_update_coeff_eob_fast_avx2(uint16_t *eob, int shift, const int16_t *dequant_ptr, const int16_t *scan, const TranLow *coeff_ptr, TranLow *qcoeff_ptr, TranLow *dqcoeff_ptr);
+    void svt_av1_fwd_txfm2d_col_avx2(int16_t *input, int32_t *buf, uint32_t input_stride, TxSize transform_size, TxType transform_type, uint8_t bit_depth);
+    void svt_av1_fwd_txfm2d_row_avx2(const int32_t *buf, int32_t *output, TxSize transform_size, TxType transform_type, uint8_t bit_depth);
 
 #endif
 
@@ -1298,9 +1298,9 @@ void distortion_based_modulator(ModeDecisionContext *context_ptr,
     EbPictureBufferDesc *input_picture_ptr, uint32_t input_origin_index,
     EbPictureBufferDesc *recon_ptr, uint32_t blk_origin_index);
 
-extern void first_pass_md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
-                                       EbPictureBufferDesc *        input_picture_ptr,
-                                       ModeDecisionCandidateBuffer *bestcandidate_buffers[5]) {
+extern EbErrorType first_pass_md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionContext *context_ptr,
+                                              EbPictureBufferDesc *        input_picture_ptr,
+                                              ModeDecisionCandidateBuffer *bestcandidate_buffers[5]) {
     ModeDecisionCandidateBuffer **candidate_buffer_ptr_array_base =
         context_ptr->candidate_buffer_ptr_array;
     ModeDecisionCandidateBuffer **candidate_buffer_ptr_array;
@@ -1317,6 +1317,10 @@ extern void first_pass_md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionC
     const uint32_t blk_origin_index =
         blk_geom->origin_x + blk_geom->origin_y * context_ptr->sb_size;
     BlkStruct *blk_ptr         = context_ptr->blk_ptr;
+    // The intra, LAST and GOLDEN candidates each use their own candidate buffer
+    EbErrorType return_error = mode_decision_alloc_candidate_buffers(context_ptr, 3, 0);
+    if (return_error != EB_ErrorNone)
+        return return_error;
     candidate_buffer_ptr_array = &(candidate_buffer_ptr_array_base[0]);
     first_pass_signal_derivation_block(context_ptr);
 
@@ -1633,6 +1637,7 @@ extern void first_pass_md_encode_block(PictureControlSet *pcs_ptr, ModeDecisionC
     }
 #endif
     context_ptr->md_local_blk_unit[blk_ptr->mds_idx].avail_blk_flag = EB_TRUE;
+    return return_error;
 }
 
 void set_tf_controls(PictureDecisionContext *context_ptr, uint8_t tf_level);
@@ -2029,6 +2034,7 @@ EbErrorType first_pass_signal_derivation_enc_dec_kernel(
 
     context_ptr->md_subpel_pme_level = 2;
     md_subpel_pme_controls(context_ptr, context_ptr->md_subpel_pme_level);
+    context_ptr->md_subpel_cache_level = 0;
 
     // Set max_ref_count @ MD
     context_ptr->md_max_ref_count = 4;
@@ -67,8 +67,10 @@ int64_t svt_av1_refine_integerized_param(EbWarpedMotionParams *wm, Transformatio
                                      int d_stride, int n_refinements, int64_t best_frame_error);
 
 /*
-  Computes "num_motions" candidate global motion parameters between two frames.
-  The array "params_by_motion" should be length 8 * "num_motions". The ordering
+  Computes "num_motions" candidate global motion parameters between two frames,
+  from the "num_correspondences" point correspondences found between their corners
+  (see svt_av1_determine_correspondence()). The array "params_by_motion" should be
+  length 8 * "num_motions". The ordering
   of each set of parameters is best described  by the homography:
 
         [x'     (m2 m3 m0   [x
@@ -81,12 +83,11 @@ int64_t svt_av1_refine_integerized_param(EbWarpedMotionParams *wm, Transformatio
   number of inlier feature points for each motion. Params for which the
   num_inliers entry is 0 should be ignored by the caller.
 */
-int svt_av1_compute_global_motion(TransformationType type, unsigned char *frm_buffer, int frm_width,
-                              int frm_height, int frm_stride, int *frm_corners, int num_frm_corners,
-                              uint8_t *ref, int ref_stride, int bit_depth,
-                              GlobalMotionEstimationType gm_estimation_type,
-                              int *num_inliers_by_motion, MotionModel *params_by_motion,
-                              int num_motions);
+int svt_av1_compute_global_motion(TransformationType type, int *correspondences,
+                                  int num_correspondences,
+                                  GlobalMotionEstimationType gm_estimation_type,
+                                  int *num_inliers_by_motion, MotionModel *params_by_motion,
+                                  int num_motions);
 #ifdef __cplusplus
 } // extern "C"
 #endif
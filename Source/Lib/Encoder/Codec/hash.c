@@ -9,25 +9,9 @@
  * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
  */
 
+#include <string.h>
 #include "hash.h"
-static void crc_calculator_process_data(CRC_CALCULATOR *p_crc_calculator,
-    uint8_t *pData, uint32_t dataLength) {
-    for (uint32_t i = 0; i < dataLength; i++) {
-        const uint8_t index = (uint8_t)(
-            (p_crc_calculator->remainder >> (p_crc_calculator->bits - 8)) ^
-            pData[i]);
-        p_crc_calculator->remainder <<= 8;
-        p_crc_calculator->remainder ^= p_crc_calculator->table[index];
-    }
-}
-static void crc_calculator_reset(CRC_CALCULATOR *p_crc_calculator) {
-    p_crc_calculator->remainder = 0;
-}
-
-static uint32_t crc_calculator_get_crc(CRC_CALCULATOR *p_crc_calculator) {
-    return p_crc_calculator->remainder & p_crc_calculator->final_result_mask;
-}
-
+#include "aom_dsp_rtcd.h"
 static void crc_calculator_init_table(CRC_CALCULATOR *p_crc_calculator) {
     const uint32_t high_bit      = 1 << (p_crc_calculator->bits - 1);
     const uint32_t byte_high_bit = 1 << (8 - 1);
@@ -54,9 +38,70 @@ void svt_av1_crc_calculator_init(CRC_CALCULATOR *p_crc_calculator, uint32_t bits
     crc_calculator_init_table(p_crc_calculator);
 }
 
+/* The remainder is kept local, so a calculator can be shared by threads. */
 uint32_t svt_av1_get_crc_value(void *crc_calculator, uint8_t *p, int length) {
-    CRC_CALCULATOR *p_crc_calculator = (CRC_CALCULATOR *)crc_calculator;
-    crc_calculator_reset(p_crc_calculator);
-    crc_calculator_process_data(p_crc_calculator, p, length);
-    return crc_calculator_get_crc(p_crc_calculator);
+    const CRC_CALCULATOR *p_crc_calculator = (const CRC_CALCULATOR *)crc_calculator;
+    uint32_t              remainder        = 0;
+    for (int i = 0; i < length; i++) {
+        const uint8_t index = (uint8_t)((remainder >> (p_crc_calculator->bits - 8)) ^ p[i]);
+        remainder <<= 8;
+        remainder ^= p_crc_calculator->table[index];
+    }
+    return remainder & p_crc_calculator->final_result_mask;
+}
+
+/* CRC-32C (iSCSI) polynomial, reversed. */
+#define POLY 0x82f63b78
+
+void svt_av1_crc32c_calculator_init(CRC32C *p_crc32c) {
+    uint32_t crc;
+
+    for (int n = 0; n < 256; n++) {
+        crc = n;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+        p_crc32c->table[0][n] = crc;
+    }
+    for (int n = 0; n < 256; n++) {
+        crc = p_crc32c->table[0][n];
+        for (int k = 1; k < 8; k++) {
+            crc                   = p_crc32c->table[0][crc & 0xff] ^ (crc >> 8);
+            p_crc32c->table[k][n] = crc;
+        }
+    }
+}
+
+/* Table-driven software version, slicing by 8 bytes. Returns the same values
+ * as the crc32 instructions. */
+uint32_t svt_av1_get_crc32c_value_c(void *c, uint8_t *buf, size_t len) {
+    const uint8_t *next = (const uint8_t *)buf;
+    uint64_t       crc;
+    CRC32C *       p = (CRC32C *)c;
+    crc              = 0 ^ 0xffffffff;
+    while (len && ((uintptr_t)next & 7) != 0) {
+        crc = p->table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+    while (len >= 8) {
+        uint64_t word;
+        memcpy(&word, next, sizeof(word));
+        crc ^= word;
+        crc = p->table[7][crc & 0xff] ^ p->table[6][(crc >> 8) & 0xff] ^
+            p->table[5][(crc >> 16) & 0xff] ^ p->table[4][(crc >> 24) & 0xff] ^
+            p->table[3][(crc >> 32) & 0xff] ^ p->table[2][(crc >> 40) & 0xff] ^
+            p->table[1][(crc >> 48) & 0xff] ^ p->table[0][crc >> 56];
+        next += 8;
+        len -= 8;
+    }
+    while (len) {
+        crc = p->table[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+    return (uint32_t)crc ^ 0xffffffff;
 }
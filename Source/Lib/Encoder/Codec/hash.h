@@ -30,6 +30,16 @@ typedef struct _crc_calculator {
 // calling svt_av1_get_crc_value().
 void svt_av1_crc_calculator_init(CRC_CALCULATOR *p_crc_calculator, uint32_t bits, uint32_t truncPoly);
 uint32_t svt_av1_get_crc_value(void *crc_calculator, uint8_t *p, int length);
+
+// CRC-32C (Castagnoli), the CRC of the SSE4.2 crc32 instructions. The table
+// is used by the C implementation of svt_av1_get_crc32c_value().
+typedef struct _crc32c {
+    uint32_t table[8][256];
+} CRC32C;
+
+// Initialize the crc32c calculator. It must be executed at least once before
+// calling svt_av1_get_crc32c_value().
+void svt_av1_crc32c_calculator_init(CRC32C *p_crc32c);
 #define AOM_BUFFER_SIZE_FOR_BLOCK_HASH (4096)
 
 #ifdef __cplusplus
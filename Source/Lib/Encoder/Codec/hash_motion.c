@@ -12,6 +12,7 @@
 #include "hash.h"
 #include "hash_motion.h"
 #include "EbPictureControlSet.h"
+#include "aom_dsp_rtcd.h"
 
 void             svt_aom_free(void *memblk);
 static const int crc_bits        = 16;
@@ -130,18 +131,33 @@ Iterator svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t hash_
     return svt_aom_vector_begin(p_hash_table->p_lookup_table[hash_value]);
 }
 
+void svt_av1_get_block_2x2_hash_row_c(const uint8_t *src, int stride, int width,
+                                      void *crc_calculator1, void *crc_calculator2,
+                                      uint32_t *hash1, uint32_t *hash2, int8_t *row_same,
+                                      int8_t *col_same) {
+    uint8_t p[4];
+    for (int x_pos = 0; x_pos < width; x_pos++) {
+        get_pixels_in_1d_char_array_by_block_2x2((uint8_t *)src + x_pos, stride, p);
+        row_same[x_pos] = is_block_2x2_row_same_value(p);
+        col_same[x_pos] = is_block_2x2_col_same_value(p);
+        hash1[x_pos]    = svt_av1_get_crc_value(crc_calculator1, p, sizeof(p));
+        hash2[x_pos]    = svt_av1_get_crc32c_value_c(crc_calculator2, p, sizeof(p));
+    }
+}
+
 void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint32_t *pic_block_hash[2],
-                                       int8_t *pic_block_same_info[3], PictureControlSet *pcs) {
+                                       int8_t *pic_block_same_info[3], int y_start, int y_stop,
+                                       PictureControlSet *pcs) {
     const int width  = 2;
     const int height = 2;
     const int x_end  = picture->y_crop_width - width + 1;
-    const int y_end  = picture->y_crop_height - height + 1;
+    const int y_end  = AOMMIN(y_stop, picture->y_crop_height - height + 1);
 
     const int length = width * 2;
     if (picture->flags & YV12_FLAG_HIGHBITDEPTH) {
         uint16_t p[4];
-        int      pos = 0;
-        for (int y_pos = 0; y_pos < y_end; y_pos++) {
+        for (int y_pos = y_start; y_pos < y_end; y_pos++) {
+            int pos = y_pos * picture->y_crop_width;
             for (int x_pos = 0; x_pos < x_end; x_pos++) {
                 get_pixels_in_1d_short_array_by_block_2x2(
                     CONVERT_TO_SHORTPTR(picture->y_buffer) + y_pos * picture->y_stride + x_pos,
@@ -152,29 +168,23 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
 
                 pic_block_hash[0][pos] =
                     svt_av1_get_crc_value(&pcs->crc_calculator1, (uint8_t *)p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] =
-                    svt_av1_get_crc_value(&pcs->crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
+                pic_block_hash[1][pos] = svt_av1_get_crc32c_value(
+                    &pcs->crc_calculator2, (uint8_t *)p, length * sizeof(p[0]));
                 pos++;
             }
-            pos += width - 1;
         }
     } else {
-        uint8_t p[4];
-        int     pos = 0;
-        for (int y_pos = 0; y_pos < y_end; y_pos++) {
-            for (int x_pos = 0; x_pos < x_end; x_pos++) {
-                get_pixels_in_1d_char_array_by_block_2x2(
-                    picture->y_buffer + y_pos * picture->y_stride + x_pos, picture->y_stride, p);
-                pic_block_same_info[0][pos] = is_block_2x2_row_same_value(p);
-                pic_block_same_info[1][pos] = is_block_2x2_col_same_value(p);
-
-                pic_block_hash[0][pos] =
-                    svt_av1_get_crc_value(&pcs->crc_calculator1, p, length * sizeof(p[0]));
-                pic_block_hash[1][pos] =
-                    svt_av1_get_crc_value(&pcs->crc_calculator2, p, length * sizeof(p[0]));
-                pos++;
-            }
-            pos += width - 1;
+        for (int y_pos = y_start; y_pos < y_end; y_pos++) {
+            const int pos = y_pos * picture->y_crop_width;
+            svt_av1_get_block_2x2_hash_row(picture->y_buffer + y_pos * picture->y_stride,
+                                           picture->y_stride,
+                                           x_end,
+                                           &pcs->crc_calculator1,
+                                           &pcs->crc_calculator2,
+                                           pic_block_hash[0] + pos,
+                                           pic_block_hash[1] + pos,
+                                           pic_block_same_info[0] + pos,
+                                           pic_block_same_info[1] + pos);
         }
     }
 }
@@ -182,10 +192,11 @@ void svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *picture, uint
 void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size,
                                    uint32_t *src_pic_block_hash[2], uint32_t *dst_pic_block_hash[2],
                                    int8_t *src_pic_block_same_info[3],
-                                   int8_t *dst_pic_block_same_info[3], PictureControlSet *pcs) {
+                                   int8_t *dst_pic_block_same_info[3], int y_start, int y_stop,
+                                   PictureControlSet *pcs) {
     const int pic_width = picture->y_crop_width;
     const int x_end     = picture->y_crop_width - block_size + 1;
-    const int y_end     = picture->y_crop_height - block_size + 1;
+    const int y_end     = AOMMIN(y_stop, picture->y_crop_height - block_size + 1);
 
     const int src_size  = block_size >> 1;
     const int quad_size = block_size >> 2;
@@ -193,8 +204,8 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
     uint32_t  p[4];
     const int length = sizeof(p);
 
-    int pos = 0;
-    for (int y_pos = 0; y_pos < y_end; y_pos++) {
+    for (int y_pos = y_start; y_pos < y_end; y_pos++) {
+        int pos = y_pos * pic_width;
         for (int x_pos = 0; x_pos < x_end; x_pos++) {
             p[0] = src_pic_block_hash[0][pos];
             p[1] = src_pic_block_hash[0][pos + src_size];
@@ -208,7 +219,7 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
             p[2] = src_pic_block_hash[1][pos + src_size * pic_width];
             p[3] = src_pic_block_hash[1][pos + src_size * pic_width + src_size];
             dst_pic_block_hash[1][pos] =
-                svt_av1_get_crc_value(&pcs->crc_calculator2, (uint8_t *)p, length);
+                svt_av1_get_crc32c_value(&pcs->crc_calculator2, (uint8_t *)p, length);
 
             dst_pic_block_same_info[0][pos] =
                 src_pic_block_same_info[0][pos] && src_pic_block_same_info[0][pos + quad_size] &&
@@ -225,27 +236,43 @@ void svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int bloc
                 src_pic_block_same_info[1][pos + src_size * pic_width + src_size];
             pos++;
         }
-        pos += block_size - 1;
     }
 
     if (block_size >= 4) {
         const int size_minus_1 = block_size - 1;
-        pos                    = 0;
-        for (int y_pos = 0; y_pos < y_end; y_pos++) {
+        for (int y_pos = y_start; y_pos < y_end; y_pos++) {
+            int pos = y_pos * pic_width;
             for (int x_pos = 0; x_pos < x_end; x_pos++) {
                 dst_pic_block_same_info[2][pos] =
                     (!dst_pic_block_same_info[0][pos] && !dst_pic_block_same_info[1][pos]) ||
                     (((x_pos & size_minus_1) == 0) && ((y_pos & size_minus_1) == 0));
                 pos++;
             }
-            pos += block_size - 1;
         }
     }
 }
 
+// Whether the block_size x block_size block at (x_pos, y_pos) covers a changed 8x8 cell.
+static INLINE int is_block_dirty(const uint32_t *dirty_sum, int dirty_stride, int x_pos,
+                                 int y_pos, int block_size) {
+    const int cx0 = x_pos >> 3, cx1 = ((x_pos + block_size - 1) >> 3) + 1;
+    const int cy0 = y_pos >> 3, cy1 = ((y_pos + block_size - 1) >> 3) + 1;
+    return dirty_sum[cy1 * dirty_stride + cx1] - dirty_sum[cy0 * dirty_stride + cx1] -
+        dirty_sum[cy1 * dirty_stride + cx0] + dirty_sum[cy0 * dirty_stride + cx0] != 0;
+}
+
+static int compare_block_hash_position(const void *a, const void *b) {
+    const BlockHash *ha = (const BlockHash *)a;
+    const BlockHash *hb = (const BlockHash *)b;
+    if (ha->x != hb->x) return ha->x - hb->x;
+    return ha->y - hb->y;
+}
+
 void svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
                                                  int8_t *pic_is_same, int pic_width, int pic_height,
-                                                 int block_size) {
+                                                 int block_size, uint32_t segment_index,
+                                                 uint32_t segment_count, const uint32_t *dirty_sum,
+                                                 int dirty_stride) {
     const int x_end = pic_width - block_size + 1;
     const int y_end = pic_height - block_size + 1;
 
@@ -257,28 +284,213 @@ void svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, ui
     add_value <<= crc_bits;
     const int crc_mask = (1 << crc_bits) - 1;
 
+    // Incremental update: drop the entries of the blocks over changed cells, the
+    // others are still valid.
+    Vector unsorted;
+    if (dirty_sum) {
+        for (int crc = 0; crc <= crc_mask; crc++) {
+            const uint32_t hash_value1 = crc + add_value;
+            if (hash_value1 % segment_count != segment_index) continue;
+            Vector *bucket = p_hash_table->p_lookup_table[hash_value1];
+            if (bucket == NULL) continue;
+            BlockHash *entries = (BlockHash *)bucket->data;
+            size_t     kept    = 0;
+            for (size_t i = 0; i < bucket->size; i++)
+                if (!is_block_dirty(dirty_sum, dirty_stride, entries[i].x, entries[i].y, block_size))
+                    entries[kept++] = entries[i];
+            bucket->size = kept;
+        }
+        svt_aom_vector_setup(&unsorted, 16, sizeof(uint32_t));
+    }
+
     for (int x_pos = 0; x_pos < x_end; x_pos++) {
         for (int y_pos = 0; y_pos < y_end; y_pos++) {
+            // on an update, only the hashes of the blocks over changed cells are computed
+            if (dirty_sum && !is_block_dirty(dirty_sum, dirty_stride, x_pos, y_pos, block_size))
+                continue;
             const int pos = y_pos * pic_width + x_pos;
             // valid data
             if (src_is_added[pos]) {
-                BlockHash curr_block_hash;
-                curr_block_hash.x = x_pos;
-                curr_block_hash.y = y_pos;
+                const uint32_t hash_value1 = (src_hash[0][pos] & crc_mask) + add_value;
+                // each segment owns the buckets of its index, a bucket is filled in raster order
+                if (hash_value1 % segment_count != segment_index) continue;
 
-                const uint32_t hash_value1  = (src_hash[0][pos] & crc_mask) + add_value;
+                BlockHash curr_block_hash;
+                curr_block_hash.x           = x_pos;
+                curr_block_hash.y           = y_pos;
                 curr_block_hash.hash_value2 = src_hash[1][pos];
 
+                Vector *bucket = p_hash_table->p_lookup_table[hash_value1];
+                // The kept entries may follow the new block, the bucket is sorted back
+                // to the order of a full build.
+                if (dirty_sum && bucket && bucket->size &&
+                    compare_block_hash_position(
+                        (BlockHash *)bucket->data + bucket->size - 1, &curr_block_hash) > 0)
+                    svt_aom_vector_push_back(&unsorted, (void *)&hash_value1);
                 hash_table_add_to_table(p_hash_table, hash_value1, &curr_block_hash);
             }
         }
     }
+
+    if (dirty_sum) {
+        for (size_t i = 0; i < unsorted.size; i++) {
+            Vector *bucket = p_hash_table->p_lookup_table[((uint32_t *)unsorted.data)[i]];
+            qsort(bucket->data, bucket->size, sizeof(BlockHash), compare_block_hash_position);
+        }
+        svt_aom_vector_destroy(&unsorted);
+    }
+}
+
+void svt_av1_hash_table_record_destroy(HashTableRecord *record) {
+    svt_av1_hash_table_destroy(&record->table);
+    free(record->source);
+    record->source       = NULL;
+    record->source_valid = EB_FALSE;
+}
+
+/* Swaps the records when src holds a later picture than dst. A picture takes the
+ * table of the latest picture done with it before its update, and gives its table
+ * back when its MD is done. */
+void svt_av1_hash_table_take_latest(HashTableRecord *dst, HashTableRecord *src) {
+    if (!src->source_valid || (dst->source_valid && dst->decode_order >= src->decode_order))
+        return;
+    HashTableRecord tmp = *dst;
+    *dst                = *src;
+    *src                = tmp;
+}
+
+/* Compares the source with the picture the hash table holds, by 8x8 cells. The
+ * table is cleared when it holds no picture of the same size. */
+void svt_av1_hash_table_prepare_update(PictureControlSet *pcs) {
+    HashTableRecord *record = &pcs->hash_table;
+    Yv12BufferConfig cpi_source;
+    link_eb_to_aom_buffer_desc_8bit(pcs->parent_pcs_ptr->enhanced_picture_ptr, &cpi_source);
+    const int width        = pcs->parent_pcs_ptr->aligned_width;
+    const int height       = pcs->parent_pcs_ptr->aligned_height;
+    const int dirty_stride = ((width + 7) >> 3) + 1;
+    const int dirty_rows   = ((height + 7) >> 3) + 1;
+    assert(cpi_source.y_crop_width == width && cpi_source.y_crop_height == height);
+
+    if (record->source == NULL || record->source_width != width ||
+        record->source_height != height) {
+        free(record->source);
+        record->source        = malloc(width * height);
+        record->source_width  = (uint16_t)width;
+        record->source_height = (uint16_t)height;
+        record->source_valid  = EB_FALSE;
+    }
+    record->decode_order = pcs->parent_pcs_ptr->decode_order;
+
+    pcs->hash_table_incremental = record->source_valid;
+    if (!pcs->hash_table_incremental) {
+        svt_av1_hash_table_create(&record->table);
+        pcs->hash_dirty_top    = 0;
+        pcs->hash_dirty_bottom = (uint16_t)height;
+        return;
+    }
+
+    uint32_t *sum    = pcs->hash_dirty_sum = malloc(sizeof(uint32_t) * dirty_stride * dirty_rows);
+    int       top    = height;
+    int       bottom = 0;
+    memset(sum, 0, sizeof(uint32_t) * dirty_stride);
+    for (int cy = 0; cy < dirty_rows - 1; cy++) {
+        const int y0       = cy << 3;
+        const int rows     = AOMMIN(8, height - y0);
+        uint32_t  row_sum  = 0;
+        sum[(cy + 1) * dirty_stride] = 0;
+        for (int cx = 0; cx < dirty_stride - 1; cx++) {
+            const int x0    = cx << 3;
+            const int cols  = AOMMIN(8, width - x0);
+            int       dirty = 0;
+            for (int y = y0; y < y0 + rows && !dirty; y++)
+                dirty = memcmp(cpi_source.y_buffer + y * cpi_source.y_stride + x0,
+                               record->source + y * width + x0,
+                               cols) != 0;
+            row_sum += dirty;
+            sum[(cy + 1) * dirty_stride + cx + 1] = sum[cy * dirty_stride + cx + 1] + row_sum;
+            if (dirty) {
+                top    = AOMMIN(top, y0);
+                bottom = y0 + rows;
+            }
+        }
+    }
+    pcs->hash_dirty_top    = (uint16_t)AOMMIN(top, bottom);
+    pcs->hash_dirty_bottom = (uint16_t)bottom;
+}
+
+// Keeps the changed rows of the source for the update of a later picture.
+void svt_av1_hash_table_save_source(PictureControlSet *pcs) {
+    HashTableRecord *record = &pcs->hash_table;
+    Yv12BufferConfig cpi_source;
+    link_eb_to_aom_buffer_desc_8bit(pcs->parent_pcs_ptr->enhanced_picture_ptr, &cpi_source);
+    const int width = record->source_width;
+    for (int y = pcs->hash_dirty_top; y < pcs->hash_dirty_bottom; y++)
+        svt_memcpy(record->source + y * width,
+                   cpi_source.y_buffer + y * cpi_source.y_stride,
+                   width);
+    record->source_valid = EB_TRUE;
+}
+
+/* Hash table build stages: stage 0 hashes the 2x2 blocks, stages 1 to 6 hash the
+ * 4x4 to 128x128 blocks from the previous stage, and each stage adds the blocks of
+ * the previous one to the table. Stage 7 adds the 128x128 blocks. The hash values
+ * of a stage are split by rows, the table by buckets. On an incremental update, the
+ * hashes are only computed in the rows the blocks over changed cells depend on. */
+void svt_av1_hash_table_build_segment(PictureControlSet *pcs, uint32_t stage,
+                                      uint32_t segment_index, uint32_t segment_count) {
+    Yv12BufferConfig cpi_source;
+    link_eb_to_aom_buffer_desc_8bit(pcs->parent_pcs_ptr->enhanced_picture_ptr, &cpi_source);
+
+    if (stage <= 6) {
+        const int block_size = 2 << stage;
+        // A block of size block_size at row y reads the blocks of half size up to
+        // row y + block_size / 2, 128 rows around the changed rows cover all the sizes.
+        const int y_first = AOMMAX(0, pcs->hash_dirty_top - 128);
+        const int y_last  = AOMMIN(cpi_source.y_crop_height - block_size + 1,
+                                  pcs->hash_dirty_bottom + 128 - block_size);
+        const int rows    = y_last - y_first;
+        if (rows > 0) {
+            const int y_start = y_first + (int)(segment_index * rows / segment_count);
+            const int y_stop  = y_first + (int)((segment_index + 1) * rows / segment_count);
+            if (stage == 0)
+                svt_av1_generate_block_2x2_hash_value(&cpi_source,
+                                                      pcs->hash_block_values[0],
+                                                      pcs->hash_is_block_same[0],
+                                                      y_start,
+                                                      y_stop,
+                                                      pcs);
+            else
+                svt_av1_generate_block_hash_value(&cpi_source,
+                                                  block_size,
+                                                  pcs->hash_block_values[(stage - 1) & 1],
+                                                  pcs->hash_block_values[stage & 1],
+                                                  pcs->hash_is_block_same[(stage - 1) & 1],
+                                                  pcs->hash_is_block_same[stage & 1],
+                                                  y_start,
+                                                  y_stop,
+                                                  pcs);
+        }
+    }
+    if (stage >= 2) {
+        const uint32_t src       = (stage - 1) & 1;
+        const int      pic_width = pcs->parent_pcs_ptr->aligned_width;
+        svt_av1_add_to_hash_map_by_row_with_precal_data(
+            &pcs->hash_table.table,
+            pcs->hash_block_values[src],
+            pcs->hash_is_block_same[src][2],
+            pic_width,
+            pcs->parent_pcs_ptr->aligned_height,
+            1 << stage,
+            segment_index,
+            segment_count,
+            pcs->hash_table_incremental ? pcs->hash_dirty_sum : NULL,
+            ((pic_width + 7) >> 3) + 1);
+    }
 }
 
 void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, uint32_t *hash_value1,
                               uint32_t *hash_value2, int use_highbitdepth,
                               struct PictureControlSet *pcs, IntraBcContext *x) {
-    UNUSED(pcs);
     uint32_t  to_hash[4];
     const int add_value = hash_block_size_to_index(block_size) << crc_bits;
     assert(add_value >= 0);
@@ -296,9 +508,9 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                     y16_src + y_pos * stride + x_pos, stride, pixel_to_hash);
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
                 x->hash_value_buffer[0][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator1, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
-                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc_value(
-                    &x->crc_calculator2, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
+                    &pcs->crc_calculator1, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
+                x->hash_value_buffer[1][0][pos] = svt_av1_get_crc32c_value(
+                    &pcs->crc_calculator2, (uint8_t *)pixel_to_hash, sizeof(pixel_to_hash));
             }
         }
     } else {
@@ -310,9 +522,9 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                     y_src + y_pos * stride + x_pos, stride, pixel_to_hash);
                 assert(pos < AOM_BUFFER_SIZE_FOR_BLOCK_HASH);
                 x->hash_value_buffer[0][0][pos] =
-                    svt_av1_get_crc_value(&x->crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
+                    svt_av1_get_crc_value(&pcs->crc_calculator1, pixel_to_hash, sizeof(pixel_to_hash));
                 x->hash_value_buffer[1][0][pos] =
-                    svt_av1_get_crc_value(&x->crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
+                    svt_av1_get_crc32c_value(&pcs->crc_calculator2, pixel_to_hash, sizeof(pixel_to_hash));
             }
         }
     }
@@ -341,14 +553,14 @@ void svt_av1_get_block_hash_value(uint8_t *y_src, int stride, int block_size, ui
                 to_hash[2] = x->hash_value_buffer[0][src_idx][src_pos + src_sub_block_in_width];
                 to_hash[3] = x->hash_value_buffer[0][src_idx][src_pos + src_sub_block_in_width + 1];
                 x->hash_value_buffer[0][dst_idx][dst_pos] =
-                    svt_av1_get_crc_value(&x->crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
+                    svt_av1_get_crc_value(&pcs->crc_calculator1, (uint8_t *)to_hash, sizeof(to_hash));
 
                 to_hash[0] = x->hash_value_buffer[1][src_idx][src_pos];
                 to_hash[1] = x->hash_value_buffer[1][src_idx][src_pos + 1];
                 to_hash[2] = x->hash_value_buffer[1][src_idx][src_pos + src_sub_block_in_width];
                 to_hash[3] = x->hash_value_buffer[1][src_idx][src_pos + src_sub_block_in_width + 1];
                 x->hash_value_buffer[1][dst_idx][dst_pos] =
-                    svt_av1_get_crc_value(&x->crc_calculator2, (uint8_t *)to_hash, sizeof(to_hash));
+                    svt_av1_get_crc32c_value(&pcs->crc_calculator2, (uint8_t *)to_hash, sizeof(to_hash));
                 dst_pos++;
             }
         }
@@ -33,6 +33,18 @@ typedef struct _block_hash {
 typedef struct HashTable {
     Vector **p_lookup_table;
 } HashTable;
+
+// A hash table with the luma of the picture it holds, the base of the
+// incremental update of a later picture
+typedef struct HashTableRecord {
+    HashTable table;
+    uint8_t * source;
+    uint16_t  source_width;
+    uint16_t  source_height;
+    EbBool    source_valid;
+    // decode order of the picture the table holds
+    uint64_t  decode_order;
+} HashTableRecord;
 void        svt_av1_hash_table_destroy(HashTable *p_hash_table);
 EbErrorType svt_av1_hash_table_create(HashTable *p_hash_table);
 int32_t     svt_av1_hash_table_count(const HashTable *p_hash_table, uint32_t hash_value);
@@ -40,16 +52,31 @@ Iterator    svt_av1_hash_get_first_iterator(HashTable *p_hash_table, uint32_t ha
 void        svt_av1_generate_block_2x2_hash_value(const Yv12BufferConfig *  picture,
                                                   uint32_t *                pic_block_hash[2],
                                                   int8_t *                  pic_block_same_info[3],
+                                                  int y_start, int y_stop,
                                                   struct PictureControlSet *pcs);
 void        svt_av1_generate_block_hash_value(const Yv12BufferConfig *picture, int block_size,
                                               uint32_t *                src_pic_block_hash[2],
                                               uint32_t *                dst_pic_block_hash[2],
                                               int8_t *                  src_pic_block_same_info[3],
                                               int8_t *                  dst_pic_block_same_info[3],
+                                              int y_start, int y_stop,
                                               struct PictureControlSet *pcs);
 void svt_av1_add_to_hash_map_by_row_with_precal_data(HashTable *p_hash_table, uint32_t *pic_hash[2],
                                                      int8_t *pic_is_same, int pic_width,
-                                                     int pic_height, int block_size);
+                                                     int pic_height, int block_size,
+                                                     uint32_t segment_index,
+                                                     uint32_t segment_count,
+                                                     const uint32_t *dirty_sum, int dirty_stride);
+void svt_av1_hash_table_record_destroy(HashTableRecord *record);
+void svt_av1_hash_table_take_latest(HashTableRecord *dst, HashTableRecord *src);
+void svt_av1_hash_table_prepare_update(struct PictureControlSet *pcs);
+void svt_av1_hash_table_save_source(struct PictureControlSet *pcs);
+// Number of stages of the hash table build, each stage depends on the previous one
+#define HASH_TABLE_BUILD_STAGES 8
+// Max number of segments of a hash table build stage
+#define HASH_SEGMENTS_MAX 16
+void svt_av1_hash_table_build_segment(struct PictureControlSet *pcs, uint32_t stage,
+                                      uint32_t segment_index, uint32_t segment_count);
 
 // check whether the block starts from (x_start, y_start) with the size of
 // BlockSize x BlockSize has the same color in all rows
@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <math.h>
 #include <stdio.h>
+#include <string.h>
 #include "mcomp.h"
 #include "mv.h"
 #include "Av1Common.h"
@@ -101,6 +102,86 @@ static INLINE const uint8_t *svt_get_buf_from_mv(const struct svt_buf_2d *buf,
   return &buf->buf[offset];
 }
 
+// Interpolates the tiles [tx0, tx1] x [ty0, ty1] of the plane of a phase. The
+// interpolation of a sample does not depend on the block it belongs to, so the
+// plane matches the prediction of any block inside the window.
+static void svt_fill_subpel_tiles(SubpelPlaneCache *cache, int phase,
+                                  SUBPEL_SEARCH_TYPE subpel_search_type,
+                                  int tx0, int tx1, int ty0, int ty1) {
+  uint8_t *pred = cache->tile_pred;
+  const int x = tx0 << SUBPEL_CACHE_TILE_LOG2;
+  const int y = ty0 << SUBPEL_CACHE_TILE_LOG2;
+  const int w = (tx1 - tx0 + 1) << SUBPEL_CACHE_TILE_LOG2;
+  const int h = (ty1 - ty0 + 1) << SUBPEL_CACHE_TILE_LOG2;
+  uint8_t *dst = cache->plane[phase] + y * cache->size + x;
+
+  assert(w <= MAX_SB_SIZE);
+  svt_aom_upsampled_pred(NULL, NULL, 0, 0, NULL, pred, w, h, (phase & 3) << 1,
+                         (phase >> 2) << 1, cache->ref + y * cache->ref_stride + x,
+                         cache->ref_stride, subpel_search_type);
+  for (int i = 0; i < h; i++) memcpy(dst + i * cache->size, pred + i * w, w);
+  const uint32_t tiles = ((1u << (tx1 - tx0 + 1)) - 1) << tx0;
+  for (int ty = ty0; ty <= ty1; ty++) cache->tile_valid[phase][ty] |= tiles;
+}
+
+// Returns the prediction of this_mv read from the cached planes, after
+// interpolating the tiles it covers that are not there yet, or NULL when it
+// has to be interpolated as a block.
+const uint8_t *svt_get_cached_subpel_pred(
+    const SUBPEL_SEARCH_VAR_PARAMS *var_params, const MV *this_mv) {
+  SubpelPlaneCache *cache = var_params->plane_cache;
+  const SUBPEL_SEARCH_TYPE subpel_search_type = var_params->subpel_search_type;
+  const int subpel_x_q3 = svt_get_subpel_part(this_mv->col);
+  const int subpel_y_q3 = svt_get_subpel_part(this_mv->row);
+  // Only the half and quarter-pel phases are kept
+  if ((subpel_x_q3 | subpel_y_q3) & 1) return NULL;
+  const int x = var_params->cache_blk_x + (this_mv->col >> 3);
+  const int y = var_params->cache_blk_y + (this_mv->row >> 3);
+  if (x < 0 || y < 0 || x + var_params->w > cache->size ||
+      y + var_params->h > cache->size)
+    return NULL;
+
+  const int phase = (subpel_y_q3 >> 1) * 4 + (subpel_x_q3 >> 1);
+  // A search with another filter (e.g. from another PD pass) starts the plane over
+  if (!(cache->phase_used & (1 << phase)) ||
+      cache->plane_filter[phase] != subpel_search_type) {
+    if (!cache->plane[phase]) {
+      EB_NO_THROW_MALLOC(cache->plane[phase], cache->size * cache->size);
+      if (!cache->plane[phase]) return NULL;
+    }
+    memset(cache->tile_valid[phase], 0, sizeof(cache->tile_valid[phase]));
+    cache->plane_filter[phase] = subpel_search_type;
+    cache->phase_used |= 1 << phase;
+  }
+
+  const int tx0 = x >> SUBPEL_CACHE_TILE_LOG2;
+  const int tx1 = (x + var_params->w - 1) >> SUBPEL_CACHE_TILE_LOG2;
+  const int ty1 = (y + var_params->h - 1) >> SUBPEL_CACHE_TILE_LOG2;
+  const uint32_t tiles = ((1u << (tx1 - tx0 + 1)) - 1) << tx0;
+  for (int ty = y >> SUBPEL_CACHE_TILE_LOG2; ty <= ty1;) {
+    const uint32_t missing = tiles & ~cache->tile_valid[phase][ty];
+    // Rows missing the same tiles are interpolated together
+    int ty_end = ty;
+    while (ty_end < ty1 &&
+           (tiles & ~cache->tile_valid[phase][ty_end + 1]) == missing)
+      ty_end++;
+    for (int tx = tx0; tx <= tx1;) {
+      if (!(missing & (1u << tx))) {
+        tx++;
+        continue;
+      }
+      int tx_end = tx;
+      while (tx_end < tx1 && (missing & (1u << (tx_end + 1))) &&
+             ((tx_end + 2 - tx) << SUBPEL_CACHE_TILE_LOG2) <= MAX_SB_SIZE)
+        tx_end++;
+      svt_fill_subpel_tiles(cache, phase, subpel_search_type, tx, tx_end, ty, ty_end);
+      tx = tx_end + 1;
+    }
+    ty = ty_end + 1;
+  }
+  return cache->plane[phase] + y * cache->size + x;
+}
+
 // Calculates the variance of prediction residue.
 static int svt_upsampled_pref_error(MacroBlockD *xd, const struct AV1Common *const cm,
                                 const MV *this_mv,
@@ -122,6 +203,14 @@ static int svt_upsampled_pref_error(MacroBlockD *xd, const struct AV1Common *con
   const int subpel_y_q3 = svt_get_subpel_part(this_mv->row);
 
   unsigned int besterr;
+  // Full-pel positions are measured on the reference itself
+  if (!subpel_x_q3 && !subpel_y_q3)
+    return vfp->vf(ref, ref_stride, src, src_stride, sse);
+  if (var_params->plane_cache) {
+    const uint8_t *cached_pred = svt_get_cached_subpel_pred(var_params, this_mv);
+    if (cached_pred)
+      return vfp->vf(cached_pred, var_params->plane_cache->size, src, src_stride, sse);
+  }
   {
     DECLARE_ALIGNED(16, uint8_t, pred[MAX_SB_SQUARE]);
 
@@ -103,6 +103,11 @@ typedef struct {
   MSBuffers ms_buffers;
 
   int w, h;
+
+  // Interpolated reference planes around the SB (NULL when not used), and the
+  // block position in their window
+  SubpelPlaneCache *plane_cache;
+  int cache_blk_x, cache_blk_y;
 } SUBPEL_SEARCH_VAR_PARAMS;
 
 // This struct holds subpixel motion search parameters that should be constant
@@ -133,6 +138,11 @@ typedef int(fractional_mv_step_fp)(MacroBlockD *xd, const struct AV1Common *cons
 
 extern fractional_mv_step_fp svt_av1_find_best_sub_pixel_tree;
 
+// Returns the prediction of this_mv read from var_params->plane_cache (with the
+// plane width as stride), or NULL when it has to be interpolated as a block
+const uint8_t *svt_get_cached_subpel_pred(const SUBPEL_SEARCH_VAR_PARAMS *var_params,
+                                          const MV *this_mv);
+
 static INLINE void svt_av1_set_subpel_mv_search_range(SubpelMvLimits *subpel_limits,
                                                   const FullMvLimits *mv_limits,
                                                   const MV *ref_mv) {
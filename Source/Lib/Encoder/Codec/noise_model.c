@@ -16,6 +16,7 @@
 #include "noise_util.h"
 #include "mathutils.h"
 #include "EbLog.h"
+#include "aom_dsp_rtcd.h"
 
 #define kLowPolyNumParams 3
 
@@ -34,23 +35,23 @@ void pack2d_src(uint8_t *in8_bit_buffer, uint32_t in8_stride, uint8_t *inn_bit_b
 
 // Defines a function that can be used to obtain the mean of a block for the
 // provided data type (uint8_t, or uint16_t)
-#define GET_BLOCK_MEAN(INT_TYPE, suffix)                          \
-    static double get_block_mean_##suffix(const INT_TYPE *data,   \
-                                          int32_t         w,      \
-                                          int32_t         h,      \
-                                          int32_t         stride, \
-                                          int32_t         x_o,    \
-                                          int32_t         y_o,    \
-                                          int32_t         block_size) {   \
-        const int32_t max_h      = AOMMIN(h - y_o, block_size);   \
-        const int32_t max_w      = AOMMIN(w - x_o, block_size);   \
-        double        block_mean = 0;                             \
-        for (int32_t y = 0; y < max_h; ++y) {                     \
-            for (int32_t x = 0; x < max_w; ++x) {                 \
-                block_mean += data[(y_o + y) * stride + x_o + x]; \
-            }                                                     \
-        }                                                         \
-        return block_mean / (max_w * max_h);                      \
+#define GET_BLOCK_MEAN(INT_TYPE, suffix)                                \
+    static double get_block_mean_##suffix(const INT_TYPE *data,         \
+                                          int32_t         w,            \
+                                          int32_t         h,            \
+                                          int32_t         stride,       \
+                                          int32_t         x_o,          \
+                                          int32_t         y_o,          \
+                                          int32_t         block_size) { \
+        const int32_t max_h      = AOMMIN(h - y_o, block_size);         \
+        const int32_t max_w      = AOMMIN(w - x_o, block_size);         \
+        uint64_t      block_sum  = 0;                                   \
+        for (int32_t y = 0; y < max_h; ++y) {                           \
+            const INT_TYPE *row = data + (y_o + y) * stride + x_o;      \
+            for (int32_t x = 0; x < max_w; ++x)                         \
+                block_sum += row[x];                                    \
+        }                                                               \
+        return (double)block_sum / (max_w * max_h);                     \
     }
 
 GET_BLOCK_MEAN(uint8_t, lowbd);
@@ -66,30 +67,31 @@ static INLINE double get_block_mean(const uint8_t *data, int32_t w, int32_t h, i
 
 // Defines a function that can be used to obtain the variance of a block
 // for the provided data type (uint8_t, or uint16_t)
-#define GET_NOISE_VAR(INT_TYPE, suffix)                                     \
-    static double get_noise_var_##suffix(const INT_TYPE *data,              \
-                                         const INT_TYPE *denoised,          \
-                                         int32_t         stride,            \
-                                         int32_t         w,                 \
-                                         int32_t         h,                 \
-                                         int32_t         x_o,               \
-                                         int32_t         y_o,               \
-                                         int32_t         block_size_x,      \
-                                         int32_t         block_size_y) {            \
-        const int32_t max_h      = AOMMIN(h - y_o, block_size_y);           \
-        const int32_t max_w      = AOMMIN(w - x_o, block_size_x);           \
-        double        noise_var  = 0;                                       \
-        double        noise_mean = 0;                                       \
-        for (int32_t y = 0; y < max_h; ++y) {                               \
-            for (int32_t x = 0; x < max_w; ++x) {                           \
-                double noise = (double)data[(y_o + y) * stride + x_o + x] - \
-                               denoised[(y_o + y) * stride + x_o + x];      \
-                noise_mean += noise;                                        \
-                noise_var += noise * noise;                                 \
-            }                                                               \
-        }                                                                   \
-        noise_mean /= (max_w * max_h);                                      \
-        return noise_var / (max_w * max_h) - noise_mean * noise_mean;       \
+#define GET_NOISE_VAR(INT_TYPE, suffix)                                       \
+    static double get_noise_var_##suffix(const INT_TYPE *data,                \
+                                         const INT_TYPE *denoised,            \
+                                         int32_t         stride,              \
+                                         int32_t         w,                   \
+                                         int32_t         h,                   \
+                                         int32_t         x_o,                 \
+                                         int32_t         y_o,                 \
+                                         int32_t         block_size_x,        \
+                                         int32_t         block_size_y) {      \
+        const int32_t max_h      = AOMMIN(h - y_o, block_size_y);             \
+        const int32_t max_w      = AOMMIN(w - x_o, block_size_x);             \
+        int64_t       noise_sum  = 0;                                         \
+        uint64_t      noise_sse  = 0;                                         \
+        for (int32_t y = 0; y < max_h; ++y) {                                 \
+            const INT_TYPE *d_row = data + (y_o + y) * stride + x_o;          \
+            const INT_TYPE *n_row = denoised + (y_o + y) * stride + x_o;      \
+            for (int32_t x = 0; x < max_w; ++x) {                             \
+                const int32_t noise = (int32_t)d_row[x] - n_row[x];           \
+                noise_sum += noise;                                           \
+                noise_sse += (uint64_t)((int64_t)noise * noise);              \
+            }                                                                 \
+        }                                                                     \
+        const double noise_mean = (double)noise_sum / (max_w * max_h);        \
+        return (double)noise_sse / (max_w * max_h) - noise_mean * noise_mean; \
     }
 
 GET_NOISE_VAR(uint8_t, lowbd);
@@ -500,8 +502,23 @@ void svt_aom_flat_block_finder_extract_block(const AomFlatBlockFinder *block_fin
     double        plane_coords[kLowPolyNumParams];
     double        at_a_inv__b[kLowPolyNumParams];
     int32_t       xi, yi, i;
-
-    if (block_finder->use_highbd) {
+    // Blocks fully inside the picture need no clamping
+    const int32_t inside = offsx >= 0 && offsy >= 0 && offsx + block_size <= w &&
+                           offsy + block_size <= h;
+
+    if (inside && block_finder->use_highbd) {
+        const uint16_t *const data16 = (const uint16_t *const)data + offsy * stride + offsx;
+        for (yi = 0; yi < block_size; ++yi)
+            for (xi = 0; xi < block_size; ++xi)
+                block[yi * block_size + xi] =
+                    ((double)data16[yi * stride + xi]) / block_finder->normalization;
+    } else if (inside) {
+        const uint8_t *const data8 = data + offsy * stride + offsx;
+        for (yi = 0; yi < block_size; ++yi)
+            for (xi = 0; xi < block_size; ++xi)
+                block[yi * block_size + xi] =
+                    ((double)data8[yi * stride + xi]) / block_finder->normalization;
+    } else if (block_finder->use_highbd) {
         const uint16_t *const data16 = (const uint16_t *const)data;
         for (yi = 0; yi < block_size; ++yi) {
             const int32_t y = clamp(offsy + yi, 0, h - 1);
@@ -521,11 +538,23 @@ void svt_aom_flat_block_finder_extract_block(const AomFlatBlockFinder *block_fin
             }
         }
     }
-    multiply_mat(block, A, at_a_inv__b, 1, n, kLowPolyNumParams);
+    // Same summation order as multiply_mat(block, A, at_a_inv__b, 1, n, 3),
+    // with the three columns accumulated in a single pass over A.
+    double sum0 = 0, sum1 = 0, sum2 = 0;
+    for (i = 0; i < n; ++i) {
+        sum0 += block[i] * A[kLowPolyNumParams * i + 0];
+        sum1 += block[i] * A[kLowPolyNumParams * i + 1];
+        sum2 += block[i] * A[kLowPolyNumParams * i + 2];
+    }
+    at_a_inv__b[0] = sum0;
+    at_a_inv__b[1] = sum1;
+    at_a_inv__b[2] = sum2;
     multiply_mat(at_a_inv, at_a_inv__b, plane_coords, kLowPolyNumParams, kLowPolyNumParams, 1);
-    multiply_mat(A, plane_coords, plane, n, kLowPolyNumParams, 1);
-
-    for (i = 0; i < n; ++i) block[i] -= plane[i];
+    for (i = 0; i < n; ++i) {
+        const double *a = A + kLowPolyNumParams * i;
+        plane[i]        = a[0] * plane_coords[0] + a[1] * plane_coords[1] + a[2] * plane_coords[2];
+        block[i] -= plane[i];
+    }
 }
 
 typedef struct {
@@ -781,6 +810,16 @@ void svt_aom_noise_model_free(AomNoiseModel *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+// Adds the observation (buffer, val) to the upper triangle of the n x n
+// system A and to b, both scaled by 1 / norm_sq.
+void svt_av1_add_block_observations_internal_c(uint32_t n, const double *buffer, double val,
+                                               double norm_sq, double *A, double *b) {
+    for (uint32_t i = 0; i < n; ++i) {
+        for (uint32_t j = i; j < n; ++j) A[i * n + j] += (buffer[i] * buffer[j]) / norm_sq;
+        b[i] += (buffer[i] * val) / norm_sq;
+    }
+}
+
 static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                       const uint8_t *const data, const uint8_t *const denoised,
                                       int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -842,18 +881,17 @@ static int32_t add_block_observations(AomNoiseModel *noise_model, int32_t c,
                                                    x + x_o,
                                                    y + y_o,
                                                    buffer);
-                    for (int32_t i = 0; i < n; ++i) {
-                        for (int32_t j = 0; j < n; ++j) {
-                            A[i * n + j] +=
-                                (buffer[i] * buffer[j]) / (normalization * normalization);
-                        }
-                        b[i] += (buffer[i] * val) / (normalization * normalization);
-                    }
+                    svt_av1_add_block_observations_internal(
+                        n, buffer, val, normalization * normalization, A, b);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
         }
     }
+    // Only the upper triangle of A is accumulated; the products are
+    // symmetric, so mirroring gives the same matrix as a full update.
+    for (int32_t i = 1; i < n; ++i)
+        for (int32_t j = 0; j < i; ++j) A[i * n + j] = A[j * n + i];
     free(buffer);
     return 1;
 }
@@ -1242,10 +1280,6 @@ int32_t svt_aom_noise_model_get_grain_parameters(AomNoiseModel *const noise_mode
     return 1;
 }
 
-static void pointwise_multiply(const float *a, float *b, int32_t n) {
-    for (int32_t i = 0; i < n; ++i) b[i] *= a[i];
-}
-
 static float *get_half_cos_window(int32_t block_size) {
     float *window_function = (float *)malloc(block_size * block_size * sizeof(*window_function));
     ASSERT(window_function);
@@ -1372,19 +1406,17 @@ int32_t svt_aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoise
                             by * (block_size >> chroma_sub_h) + offsy,
                             plane_d,
                             block_d);
+                        // Apply window function to the block and to the plane
+                        // approximation (we will apply it to the sum of plane + block
+                        // when composing the results).
                         for (int32_t j = 0; j < pixels_per_block; ++j) {
-                            block[j] = (float)block_d[j];
-                            plane[j] = (float)plane_d[j];
+                            block[j] = (float)block_d[j] * window_function[j];
+                            plane[j] = (float)plane_d[j] * window_function[j];
                         }
-                        pointwise_multiply(window_function, block, pixels_per_block);
                         svt_aom_noise_tx_forward(tx, block);
                         svt_aom_noise_tx_filter(tx, noise_psd[c]);
                         svt_aom_noise_tx_inverse(tx, block);
 
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-                        pointwise_multiply(window_function, plane, pixels_per_block);
-
                         for (int32_t y = 0; y < (block_size >> chroma_sub_h); ++y) {
                             const int32_t y_result =
                                 y + (by + 1) * (block_size >> chroma_sub_h) + offsy;
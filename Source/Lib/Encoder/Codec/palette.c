@@ -298,9 +298,6 @@ void palette_rd_y(PaletteInfo *palette_info, ModeDecisionContext *context_ptr, B
     extend_palette_color_map(color_map, cols, rows, block_width, block_height);
 }
 
-int svt_av1_count_colors(const uint8_t *src, int stride, int rows, int cols, int *val_count);
-int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows, int cols, int bit_depth,
-                                int *val_count);
 /****************************************
    determine all palette luma candidates
  ****************************************/
@@ -411,14 +408,19 @@ void search_palette_luma(PictureControlSet *pcs_ptr, ModeDecisionContext *contex
         uint16_t  color_cache[2 * PALETTE_MAX_SIZE];
         const int n_cache = svt_get_palette_cache(xd, 0, color_cache);
 
-        // Find the dominant colors, stored in top_colors[].
+        // Find the dominant colors, stored in top_colors[]. The histogram is scanned once for
+        // the (up to 64) colors of the block, in increasing order to keep the lowest color on ties.
+        int block_colors[64];
+        int n_block_colors = 0;
+        for (int j = 0; n_block_colors < colors; ++j)
+            if (count_buf[j]) block_colors[n_block_colors++] = j;
         int top_colors[PALETTE_MAX_SIZE] = {0};
         for (i = 0; i < AOMMIN(colors, PALETTE_MAX_SIZE); ++i) {
             int max_count = 0;
-            for (int j = 0; j < (1 << bit_depth); ++j) {
-                if (count_buf[j] > max_count) {
-                    max_count     = count_buf[j];
-                    top_colors[i] = j;
+            for (int j = 0; j < n_block_colors; ++j) {
+                if (count_buf[block_colors[j]] > max_count) {
+                    max_count     = count_buf[block_colors[j]];
+                    top_colors[i] = block_colors[j];
                 }
             }
             assert(max_count > 0);
@@ -17,11 +17,11 @@
 #include "mathutils.h"
 #include "random.h"
 #include "common_dsp_rtcd.h"
+#include "aom_dsp_rtcd.h"
 #define MAX_MINPTS 4
 #define MAX_DEGENERATE_ITER 10
 #define MINPTS_MULTIPLIER 5
 
-#define INLIER_THRESHOLD 1.25
 #define MIN_TRIALS 20
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -30,6 +30,28 @@ typedef int (*IsDegenerateFunc)(double *p);
 typedef int (*FindTransformationFunc)(int points, double *points1, double *points2, double *params);
 typedef void (*ProjectPointsDoubleFunc)(double *mat, double *points, double *proj, int n,
                                         int stride_points, int stride_proj);
+// Writes the 6 first parameters of the affine model equivalent to mat
+typedef void (*ToAffineFunc)(const double *mat, double *affine);
+
+static void translation_to_affine(const double *mat, double *affine) {
+    affine[0] = mat[0];
+    affine[1] = mat[1];
+    affine[2] = affine[5] = 1;
+    affine[3] = affine[4] = 0;
+}
+
+static void rotzoom_to_affine(const double *mat, double *affine) {
+    affine[0] = mat[0];
+    affine[1] = mat[1];
+    affine[2] = mat[2];
+    affine[3] = mat[3];
+    affine[4] = -mat[3];
+    affine[5] = mat[2];
+}
+
+static void affine_to_affine(const double *mat, double *affine) {
+    memcpy(affine, mat, 6 * sizeof(*affine));
+}
 
 static void project_points_double_translation(double *mat, double *points, double *proj, int n,
                                               int stride_points, int stride_proj) {
@@ -209,9 +231,11 @@ static int find_translation(int np, double *pts1, double *pts2, double *mat) {
 }
 
 static int find_rotzoom(int np, double *pts1, double *pts2, double *mat) {
-    const int np2  = np * 2;
-    double *  a    = (double *)malloc(sizeof(*a) * (np2 * 5 + 20));
-    double *  b    = a + np2 * 4;
+    const int np2 = np * 2;
+    // The hypotheses are fitted on MAX_MINPTS points at most, without allocation
+    double  a_local[MAX_MINPTS * 2 * 5 + 20];
+    double *a    = np <= MAX_MINPTS ? a_local : (double *)malloc(sizeof(*a) * (np2 * 5 + 20));
+    double *b    = a + np2 * 4;
     double *  temp = b + np2;
 
 
@@ -238,18 +262,19 @@ static int find_rotzoom(int np, double *pts1, double *pts2, double *mat) {
         b[2 * i + 1] = dy;
     }
     if (!least_squares(4, a, np2, 4, b, temp, mat)) {
-        free(a);
+        if (a != a_local) free(a);
         return 1;
     }
     denormalize_rotzoom_reorder(mat, t1, t2);
-    free(a);
+    if (a != a_local) free(a);
     return 0;
 }
 
 static int find_affine(int np, double *pts1, double *pts2, double *mat) {
     assert(np > 0);
     const int np2 = np * 2;
-    double *  a   = (double *)malloc(sizeof(*a) * (np2 * 7 + 42));
+    double    a_local[MAX_MINPTS * 2 * 7 + 42];
+    double *  a = np <= MAX_MINPTS ? a_local : (double *)malloc(sizeof(*a) * (np2 * 7 + 42));
     if (a == NULL) return 1;
     double *b    = a + np2 * 6;
     double *temp = b + np2;
@@ -281,11 +306,11 @@ static int find_affine(int np, double *pts1, double *pts2, double *mat) {
         b[2 * i + 1] = dy;
     }
     if (!least_squares(6, a, np2, 6, b, temp, mat)) {
-        free(a);
+        if (a != a_local) free(a);
         return 1;
     }
     denormalize_affine_reorder(mat, t1, t2);
-    free(a);
+    if (a != a_local) free(a);
     return 0;
 }
 
@@ -349,12 +374,34 @@ static void clear_motion(RANSAC_MOTION *motion, int num_points) {
     memset(motion->inlier_indices, 0, sizeof(*motion->inlier_indices) * num_points);
 }
 
+/* Projects the points of corners1 with the affine model mat and keeps, in point order, the
+ * indices of those landing within INLIER_THRESHOLD of their match in corners2. The inlier
+ * distances and squared distances are added to the sums. Returns the number of inliers. */
+int svt_av1_ransac_find_inliers_c(const double *mat, const double *corners1,
+                                  const double *corners2, int npoints, int *inlier_indices,
+                                  double *sum_distance, double *sum_distance_squared) {
+    int num_inliers = 0;
+    for (int i = 0; i < npoints; ++i) {
+        const double x        = corners1[i * 2];
+        const double y        = corners1[i * 2 + 1];
+        const double dx       = mat[2] * x + mat[3] * y + mat[0] - corners2[i * 2];
+        const double dy       = mat[4] * x + mat[5] * y + mat[1] - corners2[i * 2 + 1];
+        const double distance = sqrt(dx * dx + dy * dy);
+
+        if (distance < INLIER_THRESHOLD) {
+            inlier_indices[num_inliers++] = i;
+            *sum_distance += distance;
+            *sum_distance_squared += distance * distance;
+        }
+    }
+    return num_inliers;
+}
+
 static int ransac(const int *matched_points, int npoints, int *num_inliers_by_motion,
                   MotionModel *params_by_motion, int num_desired_motions, int minpts,
                   IsDegenerateFunc is_degenerate, FindTransformationFunc find_transformation,
-                  ProjectPointsDoubleFunc projectpoints) {
-    int trial_count = 0;
-    int ret_val     = 0;
+                  ToAffineFunc to_affine) {
+    int ret_val = 0;
 
     unsigned int seed = (unsigned int)npoints;
 
@@ -362,7 +409,6 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
 
     double *points1, *points2;
     double *corners1, *corners2;
-    double *image1_coord;
 
     // Store information for the num_desired_motions best transformations found
     // and the worst motion among them, as well as the motion currently under
@@ -370,9 +416,9 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     RANSAC_MOTION *motions, *worst_kept_motion = NULL;
     RANSAC_MOTION  current_motion;
 
-    // Store the parameters and the indices of the inlier points for the motion
-    // currently under consideration.
-    double params_this_motion[MAX_PARAMDIM];
+    // Parameters of the hypotheses, in the affine form scored by svt_av1_ransac_find_inliers().
+    double hypotheses[MIN_TRIALS][MAX_PARAMDIM];
+    int    num_hypotheses = 0;
 
     double *cnp1, *cnp2;
 
@@ -382,29 +428,28 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
     if (npoints < minpts * MINPTS_MULTIPLIER || npoints == 0)
         return 1;
 
-    points1      = (double *)malloc(sizeof(*points1) * npoints * 2);
-    points2      = (double *)malloc(sizeof(*points2) * npoints * 2);
-    corners1     = (double *)malloc(sizeof(*corners1) * npoints * 2);
-    corners2     = (double *)malloc(sizeof(*corners2) * npoints * 2);
-    image1_coord = (double *)malloc(sizeof(*image1_coord) * npoints * 2);
-
-    motions = (RANSAC_MOTION *)malloc(sizeof(RANSAC_MOTION) * num_desired_motions);
-    assert(motions != NULL);
+    // One scratch allocation for the points and the inlier indices of all the motions
+    double *scratch = (double *)malloc(sizeof(*scratch) * npoints * 2 * 4 +
+                                       sizeof(int) * npoints * (num_desired_motions + 1));
+    motions         = (RANSAC_MOTION *)malloc(sizeof(RANSAC_MOTION) * num_desired_motions);
+    if (!(scratch && motions)) {
+        free(scratch);
+        free(motions);
+        return 1;
+    }
+    points1  = scratch;
+    points2  = points1 + npoints * 2;
+    corners1 = points2 + npoints * 2;
+    corners2 = corners1 + npoints * 2;
+    current_motion.inlier_indices = (int *)(corners2 + npoints * 2);
+    current_motion.num_inliers    = 0;
     for (int i = 0; i < num_desired_motions; ++i) {
-        motions[i].inlier_indices = (int *)malloc(sizeof(*motions->inlier_indices) * npoints);
+        motions[i].inlier_indices = current_motion.inlier_indices + npoints * (i + 1);
         clear_motion(motions + i, npoints);
     }
-    current_motion.inlier_indices = (int *)malloc(sizeof(*current_motion.inlier_indices) * npoints);
-    clear_motion(&current_motion, npoints);
 
     worst_kept_motion = motions;
 
-    if (!(points1 && points2 && corners1 && corners2 && image1_coord && motions &&
-          current_motion.inlier_indices)) {
-        ret_val = 1;
-        goto finish_ransac;
-    }
-
     cnp1 = corners1;
     cnp2 = corners2;
     for (int i = 0; i < npoints; ++i) {
@@ -414,12 +459,9 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
         *(cnp2++) = *(matched_points++);
     }
 
-    while (MIN_TRIALS > trial_count) {
-        double sum_distance         = 0.0;
-        double sum_distance_squared = 0.0;
-
-        clear_motion(&current_motion, npoints);
-
+    // The sampling of the hypotheses does not depend on their score: draw them all first,
+    // then score them in a batch.
+    for (int trial_count = 0; trial_count < MIN_TRIALS; ++trial_count) {
         int degenerate          = 1;
         int num_degenerate_iter = 0;
 
@@ -440,24 +482,26 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
             }
         }
 
-        if (find_transformation(minpts, points1, points2, params_this_motion)) {
-            trial_count++;
-            continue;
-        }
-
-        projectpoints(params_this_motion, corners1, image1_coord, npoints, 2, 2);
+        double params_this_motion[MAX_PARAMDIM];
+        if (find_transformation(minpts, points1, points2, params_this_motion)) continue;
+        to_affine(params_this_motion, hypotheses[num_hypotheses++]);
+    }
 
-        for (int i = 0; i < npoints; ++i) {
-            double dx       = image1_coord[i * 2] - corners2[i * 2];
-            double dy       = image1_coord[i * 2 + 1] - corners2[i * 2 + 1];
-            double distance = sqrt(dx * dx + dy * dy);
+    int (*find_inliers)(const double *, const double *, const double *, int, int *, double *,
+                        double *) = svt_av1_ransac_find_inliers != NULL
+        ? svt_av1_ransac_find_inliers
+        : svt_av1_ransac_find_inliers_c;
+    for (int h = 0; h < num_hypotheses; ++h) {
+        double sum_distance         = 0.0;
+        double sum_distance_squared = 0.0;
 
-            if (distance < INLIER_THRESHOLD) {
-                current_motion.inlier_indices[current_motion.num_inliers++] = i;
-                sum_distance += distance;
-                sum_distance_squared += distance * distance;
-            }
-        }
+        current_motion.num_inliers = find_inliers(hypotheses[h],
+                                                  corners1,
+                                                  corners2,
+                                                  npoints,
+                                                  current_motion.inlier_indices,
+                                                  &sum_distance,
+                                                  &sum_distance_squared);
 
         if (current_motion.num_inliers >= worst_kept_motion->num_inliers &&
             current_motion.num_inliers > 1) {
@@ -475,12 +519,13 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
                 worst_kept_motion->variance    = current_motion.variance;
                 if (svt_memcpy != NULL)
                     svt_memcpy(worst_kept_motion->inlier_indices,
-                        current_motion.inlier_indices,
-                        sizeof(*current_motion.inlier_indices) * npoints);
+                               current_motion.inlier_indices,
+                               sizeof(*current_motion.inlier_indices) * current_motion.num_inliers);
                 else
                     svt_memcpy_c(worst_kept_motion->inlier_indices,
-                        current_motion.inlier_indices,
-                        sizeof(*current_motion.inlier_indices) * npoints);
+                                 current_motion.inlier_indices,
+                                 sizeof(*current_motion.inlier_indices) *
+                                     current_motion.num_inliers);
                 assert(npoints > 0);
                 // Determine the new worst kept motion and its num_inliers and variance.
                 for (int i = 0; i < num_desired_motions; ++i) {
@@ -490,7 +535,6 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
                 }
             }
         }
-        trial_count++;
     }
 
     // Sort the motions, best first.
@@ -510,28 +554,19 @@ static int ransac(const int *matched_points, int npoints, int *num_inliers_by_mo
             params_by_motion[i].num_inliers = motions[i].num_inliers;
             if (svt_memcpy != NULL)
                 svt_memcpy(params_by_motion[i].inliers,
-                    motions[i].inlier_indices,
-                    sizeof(*motions[i].inlier_indices) * npoints);
+                           motions[i].inlier_indices,
+                           sizeof(*motions[i].inlier_indices) * motions[i].num_inliers);
             else
                 svt_memcpy_c(params_by_motion[i].inliers,
-                    motions[i].inlier_indices,
-                    sizeof(*motions[i].inlier_indices) * npoints);
+                             motions[i].inlier_indices,
+                             sizeof(*motions[i].inlier_indices) * motions[i].num_inliers);
         }
         num_inliers_by_motion[i] = motions[i].num_inliers;
     }
 
 finish_ransac:
-    free(points1);
-    free(points2);
-    free(corners1);
-    free(corners2);
-    free(image1_coord);
-    free(current_motion.inlier_indices);
-    if (motions) {
-        for (int i = 0; i < num_desired_motions; ++i)
-            free(motions[i].inlier_indices);
-        free(motions);
-    }
+    free(scratch);
+    free(motions);
 
     return ret_val;
 }
@@ -744,7 +779,7 @@ static int ransac_translation(int *matched_points, int npoints, int *num_inliers
                   3,
                   is_degenerate_translation,
                   find_translation,
-                  project_points_double_translation);
+                  translation_to_affine);
 }
 
 static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_motion,
@@ -757,7 +792,7 @@ static int ransac_rotzoom(int *matched_points, int npoints, int *num_inliers_by_
                   3,
                   is_degenerate_affine,
                   find_rotzoom,
-                  project_points_double_rotzoom);
+                  rotzoom_to_affine);
 }
 
 static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_motion,
@@ -770,7 +805,7 @@ static int ransac_affine(int *matched_points, int npoints, int *num_inliers_by_m
                   3,
                   is_degenerate_affine,
                   find_affine,
-                  project_points_double_affine);
+                  affine_to_affine);
 }
 
 RansacFunc svt_av1_get_ransac_type(TransformationType type) {
@@ -19,6 +19,10 @@
 
 #include "global_motion.h"
 
+// Maximum distance, in pixels, between a projected point and its match for the point to be an
+// inlier of the model
+#define INLIER_THRESHOLD 1.25
+
 typedef int (*RansacFunc)(int *matched_points, int npoints, int *num_inliers_by_motion,
                           MotionModel *params_by_motion, int num_motions);
 typedef int (*RansacFuncDouble)(double *matched_points, int npoints, int *num_inliers_by_motion,
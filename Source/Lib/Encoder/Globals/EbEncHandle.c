@@ -43,6 +43,7 @@
 #include "EbPictureDecisionResults.h"
 #include "EbMotionEstimationResults.h"
 #include "EbInitialRateControlResults.h"
+#include "EbTplDispenserTasks.h"
 #include "EbPictureDemuxResults.h"
 #include "EbRateControlTasks.h"
 #include "EbEncDecTasks.h"
@@ -599,6 +600,7 @@ EbErrorType load_default_buffer_configuration_settings(
     scs_ptr->picture_analysis_fifo_init_count            = 300;
     scs_ptr->picture_decision_fifo_init_count            = 300;
     scs_ptr->initial_rate_control_fifo_init_count        = 300;
+    scs_ptr->tpl_disp_fifo_init_count                    = 300;
     scs_ptr->picture_demux_fifo_init_count               = 300;
     scs_ptr->rate_control_tasks_fifo_init_count          = 300;
     scs_ptr->rate_control_fifo_init_count                = 301;
@@ -615,6 +617,7 @@ EbErrorType load_default_buffer_configuration_settings(
     if (core_count > 1){
         scs_ptr->total_process_init_count += (scs_ptr->picture_analysis_process_init_count            = MAX(MIN(15, core_count >> 1), core_count / 6));
         scs_ptr->total_process_init_count += (scs_ptr->motion_estimation_process_init_count =  MAX(MIN(20, core_count >> 1), core_count / 3));//1);//
+        scs_ptr->total_process_init_count += (scs_ptr->tpl_disp_process_init_count                    = scs_ptr->static_config.enable_tpl_la ? MAX(MIN(20, core_count >> 1), core_count / 3) : 0);
         scs_ptr->total_process_init_count += (scs_ptr->source_based_operations_process_init_count     = MAX(MIN(3, core_count >> 1), core_count / 12));
         scs_ptr->total_process_init_count += (scs_ptr->mode_decision_configuration_process_init_count = MAX(MIN(3, core_count >> 1), core_count / 12));
         scs_ptr->total_process_init_count += (scs_ptr->enc_dec_process_init_count                     = MAX(MIN(40, core_count >> 1), core_count));
@@ -629,6 +632,7 @@ EbErrorType load_default_buffer_configuration_settings(
     }else{
         scs_ptr->total_process_init_count += (scs_ptr->picture_analysis_process_init_count            = 1);
         scs_ptr->total_process_init_count += (scs_ptr->motion_estimation_process_init_count           = 1);
+        scs_ptr->total_process_init_count += (scs_ptr->tpl_disp_process_init_count                    = scs_ptr->static_config.enable_tpl_la ? 1 : 0);
         scs_ptr->total_process_init_count += (scs_ptr->source_based_operations_process_init_count     = 1);
         scs_ptr->total_process_init_count += (scs_ptr->mode_decision_configuration_process_init_count = 1);
         scs_ptr->total_process_init_count += (scs_ptr->enc_dec_process_init_count                     = 1);
@@ -744,6 +748,9 @@ static void svt_enc_handle_stop_threads(EbEncHandle *enc_handle_ptr)
     // Initial Rate Control
     EB_DESTROY_THREAD(enc_handle_ptr->initial_rate_control_thread_handle);
 
+    // TPL Dispenser
+    EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count);
+
     // Source Based Oprations
     EB_DESTROY_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count);
 
@@ -797,6 +804,7 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->picture_decision_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->motion_estimation_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->initial_rate_control_results_resource_ptr);
+    EB_DELETE(enc_handle_ptr->tpl_disp_tasks_resource_ptr);
     EB_DELETE(enc_handle_ptr->picture_demux_results_resource_ptr);
     EB_DELETE(enc_handle_ptr->rate_control_tasks_resource_ptr);
     EB_DELETE(enc_handle_ptr->rate_control_results_resource_ptr);
@@ -810,6 +818,7 @@ static void svt_enc_handle_dctor(EbPtr p)
     EB_DELETE(enc_handle_ptr->resource_coordination_context_ptr);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->picture_analysis_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->picture_analysis_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->motion_estimation_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->motion_estimation_process_init_count);
+    EB_DELETE_PTR_ARRAY(enc_handle_ptr->tpl_disp_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->source_based_operations_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->mode_decision_configuration_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->mode_decision_configuration_process_init_count);
     EB_DELETE_PTR_ARRAY(enc_handle_ptr->enc_dec_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->enc_dec_process_init_count);
@@ -1351,6 +1360,21 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
             NULL);
     }
 
+    // TPL Dispenser Tasks, only when TPL is used
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count) {
+        TplDispenserTasksInitData tpl_disp_tasks_init_data;
+
+        EB_NEW(
+            enc_handle_ptr->tpl_disp_tasks_resource_ptr,
+            svt_system_resource_ctor,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_fifo_init_count,
+            EB_InitialRateControlProcessInitCount,
+            enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count,
+            tpl_dispenser_tasks_creator,
+            &tpl_disp_tasks_init_data,
+            NULL);
+    }
+
     // Picture Demux Results
     {
         PictureResultInitData picture_result_init_data;
@@ -1553,6 +1577,19 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
         enc_handle_ptr->initial_rate_control_context_ptr,
         initial_rate_control_context_ctor,
         enc_handle_ptr);
+
+    // TPL Dispenser Context
+    if (enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count) {
+        EB_ALLOC_PTR_ARRAY(enc_handle_ptr->tpl_disp_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count);
+
+        for (process_index = 0; process_index < enc_handle_ptr->scs_instance_array[0]->scs_ptr->tpl_disp_process_init_count; ++process_index) {
+            EB_NEW(
+                enc_handle_ptr->tpl_disp_context_ptr_array[process_index],
+                tpl_disp_context_ctor,
+                enc_handle_ptr,
+                process_index);
+        }
+    }
     // Source Based Operations Context
     EB_ALLOC_PTR_ARRAY(enc_handle_ptr->source_based_operations_context_ptr_array, enc_handle_ptr->scs_instance_array[0]->scs_ptr->source_based_operations_process_init_count);
 
@@ -1690,6 +1727,12 @@ EB_API EbErrorType svt_av1_enc_init(EbComponentType *svt_enc_component)
     // Initial Rate Control
     EB_CREATE_THREAD(enc_handle_ptr->initial_rate_control_thread_handle, initial_rate_control_kernel, enc_handle_ptr->initial_rate_control_context_ptr);
 
+    // TPL Dispenser
+    if (control_set_ptr->tpl_disp_process_init_count)
+        EB_CREATE_THREAD_ARRAY(enc_handle_ptr->tpl_disp_thread_handle_array, control_set_ptr->tpl_disp_process_init_count,
+            tpl_disp_kernel,
+            enc_handle_ptr->tpl_disp_context_ptr_array);
+
     // Source Based Oprations
     EB_CREATE_THREAD_ARRAY(enc_handle_ptr->source_based_operations_thread_handle_array, control_set_ptr->source_based_operations_process_init_count,
         source_based_operations_kernel,
@@ -1758,6 +1801,7 @@ EB_API EbErrorType svt_av1_enc_deinit(EbComponentType *svt_enc_component){
         svt_shutdown_process(handle->picture_decision_results_resource_ptr);
         svt_shutdown_process(handle->motion_estimation_results_resource_ptr);
         svt_shutdown_process(handle->initial_rate_control_results_resource_ptr);
+        svt_shutdown_process(handle->tpl_disp_tasks_resource_ptr);
         svt_shutdown_process(handle->picture_demux_results_resource_ptr);
         svt_shutdown_process(handle->rate_control_tasks_resource_ptr);
         svt_shutdown_process(handle->rate_control_results_resource_ptr);
@@ -1959,7 +2003,8 @@ void set_param_based_on_input(SequenceControlSet *scs_ptr)
     }
     else if (use_input_stat(scs_ptr)) {
         scs_ptr->static_config.look_ahead_distance = 16;
-        scs_ptr->static_config.enable_tpl_la = 1;
+        // TPL is not supported with dynamic super-res (see copy_api_from_app)
+        scs_ptr->static_config.enable_tpl_la = scs_ptr->static_config.superres_mode != SUPERRES_DYNAMIC;
         scs_ptr->static_config.intra_refresh_type     = 2;
     }
 
@@ -2216,6 +2261,7 @@ void copy_api_from_app(
 
     scs_ptr->static_config.injector_frame_rate = ((EbSvtAv1EncConfiguration*)config_struct)->injector_frame_rate;
     scs_ptr->static_config.speed_control_flag = ((EbSvtAv1EncConfiguration*)config_struct)->speed_control_flag;
+    scs_ptr->static_config.md_time_budget_us = ((EbSvtAv1EncConfiguration*)config_struct)->md_time_budget_us;
 
     // Buffers - Hardcoded(Cleanup)
     scs_ptr->static_config.use_cpu_flags = ((EbSvtAv1EncConfiguration*)config_struct)->use_cpu_flags;
@@ -2232,6 +2278,13 @@ void copy_api_from_app(
     scs_ptr->static_config.qp = ((EbSvtAv1EncConfiguration*)config_struct)->qp;
     scs_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)config_struct)->recon_enabled;
     scs_ptr->static_config.enable_tpl_la = ((EbSvtAv1EncConfiguration*)config_struct)->enable_tpl_la;
+    // TPL assumes all the pictures of its window are coded at the sequence resolution, which
+    // the dynamic super-res mode may change from one picture to the next
+    if (scs_ptr->static_config.enable_tpl_la &&
+        ((EbSvtAv1EncConfiguration*)config_struct)->superres_mode == SUPERRES_DYNAMIC) {
+        SVT_LOG("SVT [Warning]: enable_tpl_la is not supported with dynamic super-res, force enable_tpl_la to 0\n");
+        scs_ptr->static_config.enable_tpl_la = 0;
+    }
     // Extract frame rate from Numerator and Denominator if not 0
     if (scs_ptr->static_config.frame_rate_numerator != 0 && scs_ptr->static_config.frame_rate_denominator != 0)
         scs_ptr->frame_rate = scs_ptr->static_config.frame_rate = (((scs_ptr->static_config.frame_rate_numerator << 8) / (scs_ptr->static_config.frame_rate_denominator)) << 8);
@@ -2837,9 +2890,9 @@ static EbErrorType verify_settings(
         }
     }
 
-    if (config->superres_mode > 2) {
-        SVT_LOG("Error instance %u: invalid superres-mode %d, should be in the range [%d - %d], "
-                "only SUPERRES_NONE (0), SUPERRES_FIXED (1) and SUPERRES_RANDOM (2) are currently implemented \n", channel_number + 1, config->superres_mode, 0, 2);
+    if (config->superres_mode > SUPERRES_RANDOM && config->superres_mode != SUPERRES_DYNAMIC) {
+        SVT_LOG("Error instance %u: invalid superres-mode %d, should be in the range [%d - %d] or %d, "
+                "only SUPERRES_NONE (0), SUPERRES_FIXED (1), SUPERRES_RANDOM (2) and SUPERRES_DYNAMIC (5) are currently implemented \n", channel_number + 1, config->superres_mode, 0, 2, SUPERRES_DYNAMIC);
         return_error = EB_ErrorBadParameter;
     }
 
@@ -2999,6 +3052,7 @@ EbErrorType svt_svt_enc_init_parameter(
     // Latency
     config_ptr->injector_frame_rate = 60 << 16;
     config_ptr->speed_control_flag = 0;
+    config_ptr->md_time_budget_us = 0;
     config_ptr->super_block_size = 128;
 
     config_ptr->sb_sz = 64;
@@ -3434,6 +3488,7 @@ static void copy_input_buffer(
     dst->size = src->size;
     dst->qp = src->qp;
     dst->pic_type = src->pic_type;
+    dst->superres_denom = src->superres_denom;
 
     // Copy the picture buffer
     if (src->p_buffer != NULL)
@@ -65,6 +65,7 @@ struct _EbEncHandle {
     EbHandle  picture_decision_thread_handle;
     EbHandle *motion_estimation_thread_handle_array;
     EbHandle  initial_rate_control_thread_handle;
+    EbHandle *tpl_disp_thread_handle_array;
     EbHandle *source_based_operations_thread_handle_array;
     EbHandle  picture_manager_thread_handle;
     EbHandle  rate_control_thread_handle;
@@ -83,6 +84,7 @@ struct _EbEncHandle {
     EbThreadContext * picture_decision_context_ptr;
     EbThreadContext **motion_estimation_context_ptr_array;
     EbThreadContext * initial_rate_control_context_ptr;
+    EbThreadContext **tpl_disp_context_ptr_array;
     EbThreadContext **source_based_operations_context_ptr_array;
     EbThreadContext * picture_manager_context_ptr;
     EbThreadContext * rate_control_context_ptr;
@@ -104,6 +106,7 @@ struct _EbEncHandle {
     EbSystemResource * picture_decision_results_resource_ptr;
     EbSystemResource * motion_estimation_results_resource_ptr;
     EbSystemResource * initial_rate_control_results_resource_ptr;
+    EbSystemResource * tpl_disp_tasks_resource_ptr;
     EbSystemResource * picture_demux_results_resource_ptr;
     EbSystemResource * rate_control_tasks_resource_ptr;
     EbSystemResource * rate_control_results_resource_ptr;
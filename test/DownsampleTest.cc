@@ -0,0 +1,83 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file DownsampleTest.cc
+ *
+ * @brief Unit test for the kernels building the 1/4 & 1/16 source pyramid:
+ * - decimation_2d_avx2
+ * - downsample_2d_avx2
+ *
+ * Test strategy:
+ * Feed the same random picture, area and step to the C reference and the
+ * AVX2 kernel and check the outputs are bit-exact, including the samples
+ * around the written area.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+typedef void (*DownsampleFunc)(uint8_t *input_samples, uint32_t input_stride,
+                               uint32_t input_area_width,
+                               uint32_t input_area_height,
+                               uint8_t *decim_samples, uint32_t decim_stride,
+                               uint32_t decim_step);
+
+static const int in_stride = 320;
+static const int in_height = 72;
+static const int out_stride = in_stride / 2;
+static const int out_height = in_height / 2;
+static const int test_times = 1000;
+
+static void run_test(DownsampleFunc ref_func, DownsampleFunc tst_func) {
+    SVTRandom rnd_pel(8, false);
+    SVTRandom rnd_width(1, in_stride);
+    SVTRandom rnd_height(1, in_height);
+    uint8_t *input = new uint8_t[in_stride * in_height];
+    uint8_t *output_ref = new uint8_t[out_stride * out_height];
+    uint8_t *output_tst = new uint8_t[out_stride * out_height];
+
+    for (int i = 0; i < test_times; i++) {
+        for (int j = 0; j < in_stride * in_height; j++)
+            input[j] = (uint8_t)rnd_pel.random();
+        memset(output_ref, 0, out_stride * out_height);
+        memset(output_tst, 0, out_stride * out_height);
+        const uint32_t width = rnd_width.random();
+        const uint32_t height = rnd_height.random();
+        const uint32_t step = (i & 1) ? 2 : 4;
+
+        ref_func(input, in_stride, width, height, output_ref, out_stride, step);
+        tst_func(input, in_stride, width, height, output_tst, out_stride, step);
+        ASSERT_EQ(0, memcmp(output_ref, output_tst, out_stride * out_height))
+            << "area " << width << "x" << height << " step " << step;
+    }
+
+    delete[] input;
+    delete[] output_ref;
+    delete[] output_tst;
+}
+
+TEST(DownsampleTest, decimation_2d) {
+    run_test(decimation_2d_c, decimation_2d_avx2);
+}
+
+TEST(DownsampleTest, downsample_2d) {
+    run_test(downsample_2d_c, downsample_2d_avx2);
+}
+
+}  // namespace
@@ -12,7 +12,9 @@
 /******************************************************************************
  * @file EncodeTxbAsmTest.cc
  *
- * @brief Unit test for svt_av1_txb_init_levels_avx2:
+ * @brief Unit test for svt_av1_txb_init_levels_avx2,
+ * svt_av1_get_nz_map_contexts_sse2, svt_av1_cost_coeffs_txb_inner_avx2 and
+ * svt_av1_update_coeff_eob_fast_avx2:
  *
  * @author Cidana-Wenyao
  *
@@ -311,4 +313,236 @@ INSTANTIATE_TEST_CASE_P(
     ::testing::Combine(::testing::Values(&svt_av1_txb_init_levels_avx512),
                        ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
 #endif
+
+// test assembly code of svt_av1_cost_coeffs_txb_inner
+using CostCoeffsTxbInnerFunc = int32_t (*)(
+    const uint8_t *const levels, const int16_t *const scan,
+    const TranLow *const qcoeff, const int8_t *const coeff_contexts,
+    const int32_t (*base_cost)[8],
+    const int32_t (*lps_cost)[COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1],
+    const uint16_t eob, const int32_t bwl, const TxClass tx_class);
+using CostCoeffsTxbInnerParam = std::tuple<CostCoeffsTxbInnerFunc, int, int>;
+/**
+ * @brief Unit test for svt_av1_cost_coeffs_txb_inner_avx2:
+ *
+ * Test strategy:
+ * Verify this assembly code by comparing with reference c implementation.
+ * Levels and coefficient contexts are derived from the quantized
+ * coefficients with the c functions, as the encoder does, and the cost
+ * tables are filled with random values.
+ *
+ * Expect result:
+ * Rate from assemble function should be exactly same as rate from c.
+ *
+ * Test coverage:
+ * Quantized coefficients: sparse random levels, from 0 up to the golomb
+ * range
+ * eob: every value from 1 to the number of coefficients
+ * tx_type, tx_size: all
+ *
+ */
+class EncodeTxbCostCoeffsTest
+    : public ::testing::TestWithParam<CostCoeffsTxbInnerParam> {
+  public:
+    EncodeTxbCostCoeffsTest()
+        : rnd_(0, 1 << 16), ref_func_(&svt_av1_cost_coeffs_txb_inner_c) {
+    }
+
+    virtual ~EncodeTxbCostCoeffsTest() {
+        aom_clear_system_state();
+    }
+
+    void run_test(const CostCoeffsTxbInnerFunc test_func, const int tx_type,
+                  const int tx_size) {
+        const TxClass tx_class = tx_type_to_class[tx_type];
+        const int bwl = get_txb_bwl((TxSize)tx_size);
+        const int width = get_txb_wide((TxSize)tx_size);
+        const int height = get_txb_high((TxSize)tx_size);
+        const int16_t *const scan = av1_scan_orders[tx_size][tx_type].scan;
+        uint8_t *const levels = set_levels(levels_buf_, width);
+
+        for (int i = 0; i < SIG_COEF_CONTEXTS; i++)
+            for (int j = 0; j < 8; j++) base_cost_[i][j] = rnd_.random();
+        for (int i = 0; i < LEVEL_CONTEXTS; i++)
+            for (int j = 0; j < COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1;
+                 j++)
+                lps_cost_[i][j] = rnd_.random();
+
+        for (int eob = 1; eob <= width * height; ++eob) {
+            memset(qcoeff_, 0, sizeof(qcoeff_));
+            for (int c = 0; c < eob; ++c) qcoeff_[scan[c]] = random_level();
+            if (qcoeff_[scan[eob - 1]] == 0) qcoeff_[scan[eob - 1]] = 1;
+
+            svt_av1_txb_init_levels_c(qcoeff_, width, height, levels);
+            svt_av1_get_nz_map_contexts_c(
+                levels, scan, eob, (TxSize)tx_size, tx_class, coeff_contexts_);
+
+            const int32_t ref = ref_func_(levels,
+                                          scan,
+                                          qcoeff_,
+                                          coeff_contexts_,
+                                          base_cost_,
+                                          lps_cost_,
+                                          eob,
+                                          bwl,
+                                          tx_class);
+            const int32_t tst = test_func(levels,
+                                          scan,
+                                          qcoeff_,
+                                          coeff_contexts_,
+                                          base_cost_,
+                                          lps_cost_,
+                                          eob,
+                                          bwl,
+                                          tx_class);
+            ASSERT_EQ(ref, tst) << " tx_type " << tx_type << " tx_size "
+                                << tx_size << " eob " << eob;
+        }
+    }
+
+  private:
+    // Mostly zeros and small levels, with a tail reaching the golomb range.
+    TranLow random_level() {
+        const int r = rnd_.random();
+        TranLow level;
+        if (r & 1)
+            level = 0;
+        else if (r & 2)
+            level = 1 + ((r >> 2) & 3);
+        else if (r & 4)
+            level = 1 + ((r >> 3) & 31);
+        else
+            level = (r >> 3) & 4095;
+        return (r & 8) ? -level : level;
+    }
+
+    SVTRandom rnd_;
+    uint8_t levels_buf_[TX_PAD_2D];
+    DECLARE_ALIGNED(32, TranLow, qcoeff_[MAX_TX_SQUARE]);
+    // Padded like the encoder's array, the AVX2 code gathers 4 bytes per context
+    DECLARE_ALIGNED(16, int8_t, coeff_contexts_[MAX_TX_SQUARE + 3]);
+    int32_t base_cost_[SIG_COEF_CONTEXTS][8];
+    int32_t lps_cost_[LEVEL_CONTEXTS]
+                     [COEFF_BASE_RANGE + 1 + COEFF_BASE_RANGE + 1];
+    const CostCoeffsTxbInnerFunc ref_func_;
+};
+
+TEST_P(EncodeTxbCostCoeffsTest, cost_coeffs_txb_inner_match) {
+    run_test(TEST_GET_PARAM(0), TEST_GET_PARAM(1), TEST_GET_PARAM(2));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, EncodeTxbCostCoeffsTest,
+    ::testing::Combine(::testing::Values(&svt_av1_cost_coeffs_txb_inner_avx2),
+                       ::testing::Range(0, static_cast<int>(TX_TYPES), 1),
+                       ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
+
+// test assembly code of svt_av1_update_coeff_eob_fast
+using UpdateCoeffEobFastFunc = void (*)(uint16_t *eob, int shift,
+                                        const int16_t *dequant_ptr,
+                                        const int16_t *scan,
+                                        const TranLow *coeff_ptr,
+                                        TranLow *qcoeff_ptr,
+                                        TranLow *dqcoeff_ptr);
+using UpdateCoeffEobFastParam = std::tuple<UpdateCoeffEobFastFunc, int>;
+/**
+ * @brief Unit test for svt_av1_update_coeff_eob_fast_avx2:
+ *
+ * Test strategy:
+ * Verify this assembly code by comparing with reference c implementation.
+ * Feed the same data and check the difference between test output
+ * and reference output.
+ *
+ * Expect result:
+ * eob, quantized and dequantized coefficients from assemble function
+ * should be exactly same as output from c.
+ *
+ * Test coverage:
+ * Coefficients: random, around the dead zone of random dequant values
+ * shift: 0 to 2
+ * eob: every value from 1 to the number of coefficients
+ * tx_size: all
+ *
+ */
+class EncodeTxbUpdateEobFastTest
+    : public ::testing::TestWithParam<UpdateCoeffEobFastParam> {
+  public:
+    EncodeTxbUpdateEobFastTest()
+        : rnd_(0, 1 << 16), ref_func_(&svt_av1_update_coeff_eob_fast_c) {
+    }
+
+    virtual ~EncodeTxbUpdateEobFastTest() {
+        aom_clear_system_state();
+    }
+
+    void run_test(const UpdateCoeffEobFastFunc test_func, const int tx_size) {
+        const int width = get_txb_wide((TxSize)tx_size);
+        const int height = get_txb_high((TxSize)tx_size);
+        const int16_t *const scan = av1_scan_orders[tx_size][DCT_DCT].scan;
+
+        for (int shift = 0; shift <= 2; ++shift) {
+            for (int eob = 1; eob <= width * height; ++eob) {
+                const int16_t dequant[2] = {(int16_t)(4 + rnd_.random() % 1024),
+                                            (int16_t)(4 + rnd_.random() % 1024)};
+                for (int c = 0; c < width * height; ++c) {
+                    const int rc = scan[c];
+                    // Magnitudes around the dead zone, so runs of
+                    // coefficients are dropped before one is kept.
+                    const int r = rnd_.random();
+                    coeff_[rc] = (r % (2 * dequant[rc != 0] + 1)) >> shift;
+                    if (r & 1) coeff_[rc] = -coeff_[rc];
+                    qcoeff_ref_[rc] = qcoeff_tst_[rc] =
+                        (r & 6) ? coeff_[rc] / dequant[rc != 0] : 0;
+                    dqcoeff_ref_[rc] = dqcoeff_tst_[rc] = coeff_[rc];
+                }
+                uint16_t eob_ref = eob, eob_tst = eob;
+                ref_func_(&eob_ref,
+                          shift,
+                          dequant,
+                          scan,
+                          coeff_,
+                          qcoeff_ref_,
+                          dqcoeff_ref_);
+                test_func(&eob_tst,
+                          shift,
+                          dequant,
+                          scan,
+                          coeff_,
+                          qcoeff_tst_,
+                          dqcoeff_tst_);
+
+                ASSERT_EQ(eob_ref, eob_tst)
+                    << " tx_size " << tx_size << " shift " << shift;
+                ASSERT_EQ(0,
+                          memcmp(qcoeff_ref_,
+                                 qcoeff_tst_,
+                                 sizeof(*qcoeff_ref_) * width * height))
+                    << " tx_size " << tx_size << " shift " << shift;
+                ASSERT_EQ(0,
+                          memcmp(dqcoeff_ref_,
+                                 dqcoeff_tst_,
+                                 sizeof(*dqcoeff_ref_) * width * height))
+                    << " tx_size " << tx_size << " shift " << shift;
+            }
+        }
+    }
+
+  private:
+    SVTRandom rnd_;
+    TranLow coeff_[MAX_TX_SQUARE];
+    TranLow qcoeff_ref_[MAX_TX_SQUARE];
+    TranLow qcoeff_tst_[MAX_TX_SQUARE];
+    TranLow dqcoeff_ref_[MAX_TX_SQUARE];
+    TranLow dqcoeff_tst_[MAX_TX_SQUARE];
+    const UpdateCoeffEobFastFunc ref_func_;
+};
+
+TEST_P(EncodeTxbUpdateEobFastTest, update_coeff_eob_fast_match) {
+    run_test(TEST_GET_PARAM(0), TEST_GET_PARAM(1));
+}
+
+INSTANTIATE_TEST_CASE_P(
+    AVX2, EncodeTxbUpdateEobFastTest,
+    ::testing::Combine(::testing::Values(&svt_av1_update_coeff_eob_fast_avx2),
+                       ::testing::Range(0, static_cast<int>(TX_SIZES_ALL), 1)));
 }  // namespace
@@ -422,6 +422,9 @@ class DenoiseModelRunTest : public ::testing::Test {
             svt_aom_ifft8x8_float = svt_aom_ifft8x8_float_avx2;
             svt_aom_ifft2x2_float = svt_aom_ifft2x2_float_c;
             svt_aom_ifft4x4_float = svt_aom_ifft4x4_float_sse2;
+
+            svt_av1_add_block_observations_internal =
+                svt_av1_add_block_observations_internal_c;
         }
     }
 
@@ -469,3 +472,27 @@ TEST_F(DenoiseModelRunTest, OutputFilmGrainCheck) {
     check_filmgrain();
     EXPECT_FALSE(HasFailure());
 }
+
+TEST(AddBlockObservationsTest, MatchTest) {
+    libaom_test::ACMRandom rnd(libaom_test::ACMRandom::DeterministicSeed());
+    // lag 3 luma (24 coefficients) and chroma (one more for the luma term)
+    const uint32_t sizes[] = {24, 25, 7, 1};
+    const double norm_sq = 1023.0 * 1023.0;
+    for (uint32_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s) {
+        const uint32_t n = sizes[s];
+        double A_ref[25 * 25] = {0}, A_tst[25 * 25] = {0};
+        double b_ref[25] = {0}, b_tst[25] = {0};
+        double buffer[25];
+        for (int iter = 0; iter < 1000; ++iter) {
+            for (uint32_t i = 0; i < n; ++i)
+                buffer[i] = (double)((int)rnd.Rand16() % 2047 - 1023) / 4;
+            const double val = (double)((int)rnd.Rand16() % 2047 - 1023);
+            svt_av1_add_block_observations_internal_c(
+                n, buffer, val, norm_sq, A_ref, b_ref);
+            svt_av1_add_block_observations_internal_avx2(
+                n, buffer, val, norm_sq, A_tst, b_tst);
+        }
+        EXPECT_EQ(0, memcmp(A_ref, A_tst, sizeof(A_ref))) << "n " << n;
+        EXPECT_EQ(0, memcmp(b_ref, b_tst, sizeof(b_ref))) << "n " << n;
+    }
+}
@@ -14,6 +14,7 @@
  *
  * @brief Unit test for forward 2d transform functions written in assembly code:
  * - svt_av1_fwd_txfm2d_{4, 8, 16, 32, 64}x{4, 8, 16, 32, 64}_avx2
+ * - svt_av1_fwd_txfm2d_col_avx2 and svt_av1_fwd_txfm2d_row_avx2
  *
  * @author Cidana-Wenyao
  *
@@ -67,6 +68,9 @@ static const FwdTxfm2dFunc fwd_txfm_2d_asm_func[TX_SIZES_ALL] = {
  * Feed the same data and check test output and reference output.
  * The test output and reference output are different at the beginning.
  *
+ * The split column/row passes, in C and avx2, are checked against the same
+ * 2d c implementation.
+ *
  * Expect result:
  * Output from assemble function should be exactly same as output from c.
  *
@@ -134,7 +138,48 @@ class FwdTxfm2dAsmTest : public ::testing::TestWithParam<FwdTxfm2dAsmParam> {
         }
     }
 
+    void run_split_test() {
+        FwdTxfm2dFunc ref_func = fwd_txfm_2d_c_func[tx_size_];
+        if (ref_func == nullptr)
+            return;
+
+        ASSERT_NE(rnd_, nullptr) << "Failed to create random generator";
+        for (int tx_type = 0; tx_type < TX_TYPES; ++tx_type) {
+            TxType type = static_cast<TxType>(tx_type);
+            if (is_txfm_allowed(type, tx_size_) == false)
+                continue;
+
+            const int loops = 100;
+            for (int k = 0; k < loops; k++) {
+                populate_with_random();
+
+                ref_func(input_, output_ref_, stride_, type, (uint8_t)bd_);
+                // column pass then row pass, in C and in avx2
+                svt_av1_fwd_txfm2d_col_c(
+                    input_, col_buf_, stride_, tx_size_, type, (uint8_t)bd_);
+                svt_av1_fwd_txfm2d_row_c(
+                    col_buf_, output_test_, tx_size_, type, (uint8_t)bd_);
+                check_output(output_test_, k, tx_type, "c");
+                svt_av1_fwd_txfm2d_col_avx2(
+                    input_, col_buf_, stride_, tx_size_, type, (uint8_t)bd_);
+                svt_av1_fwd_txfm2d_row_avx2(
+                    col_buf_, output_test_, tx_size_, type, (uint8_t)bd_);
+                check_output(output_test_, k, tx_type, "avx2");
+            }
+        }
+    }
+
   private:
+    void check_output(const int32_t *output, int k, int tx_type,
+                      const char *impl) {
+        for (int i = 0; i < height_; i++)
+            for (int j = 0; j < width_; j++)
+                ASSERT_EQ(output_ref_[i * width_ + j], output[i * width_ + j])
+                    << impl << " split loop: " << k << " tx_type: " << tx_type
+                    << " tx_size: " << tx_size_ << " Mismatch at (" << j
+                    << " x " << i << ")";
+    }
+
     void populate_with_random() {
         for (int i = 0; i < height_; i++) {
             for (int j = 0; j < width_; j++) {
@@ -158,12 +203,17 @@ class FwdTxfm2dAsmTest : public ::testing::TestWithParam<FwdTxfm2dAsmParam> {
     int16_t *input_;       /**< aligned address for input */
     int32_t *output_test_; /**< aligned address for output test */
     int32_t *output_ref_;  /**< aligned address for output ref */
+    int32_t col_buf_[MAX_TX_SQUARE]; /**< column pass output of split txfm */
 };
 
 TEST_P(FwdTxfm2dAsmTest, match_test) {
     run_match_test();
 }
 
+TEST_P(FwdTxfm2dAsmTest, split_match_test) {
+    run_split_test();
+}
+
 INSTANTIATE_TEST_CASE_P(
     TX, FwdTxfm2dAsmTest,
     ::testing::Combine(::testing::Range(static_cast<int>(TX_4X4),
@@ -0,0 +1,232 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file HashTest.cc
+ *
+ * @brief Unit test for the IntraBC hash table:
+ * - svt_av1_get_crc32c_value_avx2
+ * - svt_av1_get_block_2x2_hash_row_avx2
+ * - incremental update of the hash table
+ *
+ * Test strategy:
+ * Check the C crc32c against the standard check value, then feed the same
+ * random data to the C reference and the AVX2 kernel and check the outputs
+ * are bit-exact. The pictures are drawn from a few values so the same-value
+ * flags of the 2x2 blocks are set.
+ * Update a hash table built on a picture with a changed copy of the picture,
+ * and check the table is the same, bucket by bucket and in the same order, as
+ * a full build of the changed picture.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "hash.h"
+#include "hash_motion.h"
+#include "EbPictureControlSet.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const int test_times = 1000;
+
+TEST(HashTest, crc32c) {
+    CRC32C crc32c;
+    svt_av1_crc32c_calculator_init(&crc32c);
+    uint8_t check[] = "123456789";
+    ASSERT_EQ(0xE3069283u, svt_av1_get_crc32c_value_c(&crc32c, check, 9));
+
+    const int max_length = 256;
+    SVTRandom rnd_pel(8, false);
+    SVTRandom rnd_len(0, max_length);
+    SVTRandom rnd_offset(0, 7);
+    uint8_t buf[max_length + 8];
+    for (int i = 0; i < test_times; i++) {
+        for (int j = 0; j < max_length + 8; j++)
+            buf[j] = (uint8_t)rnd_pel.random();
+        const int offset = rnd_offset.random();
+        const int length = rnd_len.random();
+        ASSERT_EQ(svt_av1_get_crc32c_value_c(&crc32c, buf + offset, length),
+                  svt_av1_get_crc32c_value_avx2(&crc32c, buf + offset, length))
+            << "length " << length << " offset " << offset;
+    }
+}
+
+TEST(HashTest, block_2x2_hash_row) {
+    const int stride = 160;
+    CRC_CALCULATOR crc1;
+    CRC32C crc2;
+    svt_av1_crc_calculator_init(&crc1, 24, 0x5D6DCB);
+    svt_av1_crc32c_calculator_init(&crc2);
+
+    SVTRandom rnd_pel(0, 3);
+    SVTRandom rnd_width(1, stride - 1);
+    uint8_t src[2 * stride];
+    uint32_t hash1_ref[stride], hash1_tst[stride];
+    uint32_t hash2_ref[stride], hash2_tst[stride];
+    int8_t row_ref[stride], row_tst[stride];
+    int8_t col_ref[stride], col_tst[stride];
+
+    for (int i = 0; i < test_times; i++) {
+        const int scale = (i & 1) ? 1 : 85;
+        for (int j = 0; j < 2 * stride; j++)
+            src[j] = (uint8_t)(rnd_pel.random() * scale);
+        const int width = rnd_width.random();
+
+        svt_av1_get_block_2x2_hash_row_c(src, stride, width, &crc1, &crc2,
+                                         hash1_ref, hash2_ref, row_ref,
+                                         col_ref);
+        svt_av1_get_block_2x2_hash_row_avx2(src, stride, width, &crc1,
+                                            &crc2, hash1_tst, hash2_tst,
+                                            row_tst, col_tst);
+        ASSERT_EQ(0, memcmp(hash1_ref, hash1_tst, width * sizeof(uint32_t)))
+            << "width " << width;
+        ASSERT_EQ(0, memcmp(hash2_ref, hash2_tst, width * sizeof(uint32_t)))
+            << "width " << width;
+        ASSERT_EQ(0, memcmp(row_ref, row_tst, width)) << "width " << width;
+        ASSERT_EQ(0, memcmp(col_ref, col_tst, width)) << "width " << width;
+    }
+}
+
+// Builds the hash table of the source of pcs the way MDC does, with the
+// segments of each stage run one after the other.
+static void build_hash_table(PictureControlSet *pcs, uint32_t segment_count) {
+    const int pic_size = pcs->parent_pcs_ptr->aligned_width *
+                         pcs->parent_pcs_ptr->aligned_height;
+    svt_av1_crc_calculator_init(&pcs->crc_calculator1, 24, 0x5D6DCB);
+    svt_av1_crc32c_calculator_init(&pcs->crc_calculator2);
+    svt_av1_hash_table_prepare_update(pcs);
+    if (pcs->hash_dirty_top < pcs->hash_dirty_bottom) {
+        for (int k = 0; k < 2; k++) {
+            for (int j = 0; j < 2; j++)
+                pcs->hash_block_values[k][j] =
+                    (uint32_t *)malloc(sizeof(uint32_t) * pic_size);
+            for (int j = 0; j < 3; j++)
+                pcs->hash_is_block_same[k][j] = (int8_t *)malloc(pic_size);
+        }
+        for (uint32_t stage = 0; stage < HASH_TABLE_BUILD_STAGES; stage++)
+            for (uint32_t seg = 0; seg < segment_count; seg++)
+                svt_av1_hash_table_build_segment(pcs, stage, seg, segment_count);
+        svt_av1_hash_table_save_source(pcs);
+        for (int k = 0; k < 2; k++) {
+            for (int j = 0; j < 2; j++) free(pcs->hash_block_values[k][j]);
+            for (int j = 0; j < 3; j++) free(pcs->hash_is_block_same[k][j]);
+        }
+    }
+    free(pcs->hash_dirty_sum);
+    pcs->hash_dirty_sum = NULL;
+}
+
+class HashTableUpdateTest : public ::testing::Test {
+  protected:
+    static const int width = 264;
+    static const int height = 200;
+
+    void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
+        setup_rtcd_internal(get_cpu_flags_to_use());
+        memset(&pic_, 0, sizeof(pic_));
+        pic_.width = width;
+        pic_.height = height;
+        pic_.stride_y = width;
+        pic_.stride_cb = width / 2;
+        pic_.buffer_y = src_;
+        pic_.buffer_cb = src_;
+        pic_.buffer_cr = src_;
+        for (int i = 0; i < 2; i++) {
+            ppcs_[i] = (PictureParentControlSet *)calloc(1, sizeof(*ppcs_[i]));
+            ppcs_[i]->enhanced_picture_ptr = &pic_;
+            ppcs_[i]->aligned_width = width;
+            ppcs_[i]->aligned_height = height;
+            pcs_[i] = (PictureControlSet *)calloc(1, sizeof(*pcs_[i]));
+            pcs_[i]->parent_pcs_ptr = ppcs_[i];
+            svt_av1_hash_table_create(&pcs_[i]->hash_table.table);
+        }
+    }
+
+    void TearDown() override {
+        for (int i = 0; i < 2; i++) {
+            svt_av1_hash_table_record_destroy(&pcs_[i]->hash_table);
+            free(pcs_[i]);
+            free(ppcs_[i]);
+        }
+    }
+
+    // Screen-like picture: flat areas with a few random rectangles
+    void fill_picture(SVTRandom &rnd) {
+        memset(src_, (uint8_t)rnd.random(), sizeof(src_));
+        for (int i = 0; i < 40; i++)
+            change_rect(rnd);
+    }
+
+    void change_rect(SVTRandom &rnd) {
+        const int x0 = rnd.random() % width, y0 = rnd.random() % height;
+        const int w = 1 + rnd.random() % 40, h = 1 + rnd.random() % 40;
+        const int noisy = rnd.random() & 1;
+        const uint8_t value = (uint8_t)rnd.random();
+        for (int y = y0; y < AOMMIN(height, y0 + h); y++)
+            for (int x = x0; x < AOMMIN(width, x0 + w); x++)
+                src_[y * width + x] =
+                    noisy ? (uint8_t)(rnd.random() & 3) : value;
+    }
+
+    static void check_same_table(const HashTable *ref, const HashTable *tst) {
+        for (int i = 0; i < (1 << 19); i++) {
+            const Vector *ref_bucket = ref->p_lookup_table[i];
+            const Vector *tst_bucket = tst->p_lookup_table[i];
+            const size_t ref_size = ref_bucket ? ref_bucket->size : 0;
+            const size_t tst_size = tst_bucket ? tst_bucket->size : 0;
+            ASSERT_EQ(ref_size, tst_size) << "bucket " << i;
+            for (size_t j = 0; j < ref_size; j++) {
+                const BlockHash *a = (const BlockHash *)ref_bucket->data + j;
+                const BlockHash *b = (const BlockHash *)tst_bucket->data + j;
+                ASSERT_TRUE(a->x == b->x && a->y == b->y &&
+                            a->hash_value2 == b->hash_value2)
+                    << "bucket " << i << " entry " << j;
+            }
+        }
+    }
+
+    uint8_t src_[width * height];
+    EbPictureBufferDesc pic_;
+    PictureParentControlSet *ppcs_[2];
+    PictureControlSet *pcs_[2];
+};
+
+TEST_F(HashTableUpdateTest, MatchFullBuild) {
+    SVTRandom rnd(0, 255);
+    HashTableRecord latest;
+    memset(&latest, 0, sizeof(latest));
+    fill_picture(rnd);
+    for (int i = 0; i < 8; i++) {
+        const uint32_t segment_count = 1 + (i % 3);
+        // pcs_[0] is updated from the latest picture, pcs_[1] is built in full
+        ppcs_[0]->decode_order = i;
+        svt_av1_hash_table_take_latest(&pcs_[0]->hash_table, &latest);
+        build_hash_table(pcs_[0], segment_count);
+        ASSERT_EQ(i > 0, pcs_[0]->hash_table_incremental);
+        pcs_[1]->hash_table.source_valid = EB_FALSE;
+        build_hash_table(pcs_[1], 1);
+        check_same_table(&pcs_[1]->hash_table.table, &pcs_[0]->hash_table.table);
+        // hand the table over to the next picture
+        svt_av1_hash_table_take_latest(&latest, &pcs_[0]->hash_table);
+        ASSERT_TRUE(latest.source_valid);
+        for (int j = 0; j < (i & 3); j++) change_rect(rnd);
+    }
+    svt_av1_hash_table_record_destroy(&latest);
+}
+
+}  // namespace
@@ -0,0 +1,111 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file HistogramTest.cc
+ *
+ * @brief Unit test for the scene change histogram function:
+ * - calculate_histogram_avx2
+ *
+ ******************************************************************************/
+
+#include <string.h>
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "random.h"
+
+/**
+ * @brief Unit test for the scene change histogram function:
+ * - calculate_histogram_avx2
+ *
+ * Test strategy:
+ * Verify the AVX2 function by comparing with the reference C implementation
+ * on random and flat inputs, for the luma (full resolution) and chroma
+ * (decimated by 4) sampling, over region sizes that cover both the vector
+ * and the scalar paths.
+ *
+ * Expected result:
+ * Histograms and sums from the AVX2 function are the same as from C.
+ */
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const uint32_t max_width  = 512;
+static const uint32_t max_height = 288;
+static const uint32_t stride     = max_width + 13;
+
+typedef struct {
+    uint32_t width;
+    uint32_t height;
+    uint8_t  decim_step;
+} HistogramParam;
+
+static const HistogramParam params[] = {{22, 18, 1},
+                                        {120, 67, 1},
+                                        {127, 90, 1},
+                                        {480, 270, 1},
+                                        {44, 36, 4},
+                                        {240, 135, 4},
+                                        {253, 141, 4},
+                                        {max_width, max_height, 4}};
+
+static void run_histogram_test(SVTRandom *rnd, bool flat) {
+    uint8_t *input = new uint8_t[stride * max_height];
+    uint32_t hist_ref[256], hist_tst[256];
+
+    for (size_t p = 0; p < sizeof(params) / sizeof(params[0]); p++) {
+        const HistogramParam &prm = params[p];
+        for (int t = 0; t < 20; t++) {
+            const uint8_t flat_val = (uint8_t)rnd->random();
+            for (uint32_t i = 0; i < stride * max_height; i++)
+                input[i] = flat ? flat_val : (uint8_t)rnd->random();
+            for (int i = 0; i < 256; i++) hist_ref[i] = hist_tst[i] = 1;
+            uint64_t sum_ref = 0, sum_tst = 0;
+
+            calculate_histogram_c(input,
+                                  prm.width,
+                                  prm.height,
+                                  stride,
+                                  prm.decim_step,
+                                  hist_ref,
+                                  &sum_ref);
+            calculate_histogram_avx2(input,
+                                     prm.width,
+                                     prm.height,
+                                     stride,
+                                     prm.decim_step,
+                                     hist_tst,
+                                     &sum_tst);
+
+            ASSERT_EQ(sum_ref, sum_tst)
+                << "sum mismatch at " << prm.width << "x" << prm.height
+                << " decim " << (int)prm.decim_step;
+            ASSERT_EQ(0, memcmp(hist_ref, hist_tst, sizeof(hist_ref)))
+                << "histogram mismatch at " << prm.width << "x" << prm.height
+                << " decim " << (int)prm.decim_step;
+        }
+    }
+    delete[] input;
+}
+
+TEST(HistogramTest, MatchRandom) {
+    SVTRandom rnd(8, false);
+    run_histogram_test(&rnd, false);
+}
+
+TEST(HistogramTest, MatchFlat) {
+    SVTRandom rnd(8, false);
+    run_histogram_test(&rnd, true);
+}
+
+}  // namespace
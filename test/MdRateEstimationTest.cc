@@ -0,0 +1,104 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file MdRateEstimationTest.cc
+ *
+ * @brief Unit test for the incremental update of the MD rate tables:
+ * - av1_estimate_syntax_rate
+ * - av1_estimate_coefficients_rate
+ *
+ * Test strategy:
+ * Adapt a few random CDFs of a frame context the way the entropy coder
+ * does, then update a rate table from the previous frame context and check
+ * it is the same as a table fully estimated from the new frame context.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
+#include "EbMdRateEstimation.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+// Adapts one random CDF of the array of CDFs of nsymbs symbols at cdfs
+#define ADAPT_RANDOM_CDF(cdfs, nsymbs)                                          \
+    do {                                                                        \
+        const int count = sizeof(cdfs) / sizeof(AomCdfProb) / CDF_SIZE(nsymbs); \
+        AomCdfProb *cdf =                                                       \
+            (AomCdfProb *)(cdfs) + (rnd.random() % count) * CDF_SIZE(nsymbs);   \
+        update_cdf(cdf, rnd.random() % (nsymbs), nsymbs);                       \
+    } while (0)
+
+class MdRateEstimationTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
+        setup_rtcd_internal(get_cpu_flags_to_use());
+        fc_ = (FRAME_CONTEXT *)calloc(1, sizeof(*fc_));
+        prev_fc_ = (FRAME_CONTEXT *)calloc(1, sizeof(*prev_fc_));
+        ref_ = (MdRateEstimationContext *)calloc(1, sizeof(*ref_));
+        tst_ = (MdRateEstimationContext *)calloc(1, sizeof(*tst_));
+        svt_av1_default_coef_probs(fc_, 128);
+        init_mode_probs(fc_);
+    }
+
+    void TearDown() override {
+        free(fc_);
+        free(prev_fc_);
+        free(ref_);
+        free(tst_);
+    }
+
+    void adapt_cdfs(SVTRandom &rnd) {
+        const int n = rnd.random() % 8;
+        for (int i = 0; i < n; i++) {
+            switch (rnd.random() % 10) {
+            case 0: ADAPT_RANDOM_CDF(fc_->skip_cdfs, 2); break;
+            case 1: ADAPT_RANDOM_CDF(fc_->y_mode_cdf, INTRA_MODES); break;
+            case 2: ADAPT_RANDOM_CDF(fc_->kf_y_cdf, INTRA_MODES); break;
+            case 3: ADAPT_RANDOM_CDF(fc_->cfl_alpha_cdf, CFL_ALPHABET_SIZE); break;
+            case 4: ADAPT_RANDOM_CDF(fc_->newmv_cdf, 2); break;
+            case 5: ADAPT_RANDOM_CDF(fc_->txb_skip_cdf, 2); break;
+            case 6: ADAPT_RANDOM_CDF(fc_->coeff_base_cdf, 4); break;
+            case 7: ADAPT_RANDOM_CDF(fc_->coeff_br_cdf, BR_CDF_SIZE); break;
+            case 8: ADAPT_RANDOM_CDF(fc_->eob_flag_cdf16, 5); break;
+            default: ADAPT_RANDOM_CDF(fc_->dc_sign_cdf, 2); break;
+            }
+        }
+    }
+
+    FRAME_CONTEXT *fc_;
+    FRAME_CONTEXT *prev_fc_;
+    MdRateEstimationContext *ref_;
+    MdRateEstimationContext *tst_;
+};
+
+TEST_F(MdRateEstimationTest, IncrementalMatchFullEstimation) {
+    SVTRandom rnd(0, (1 << 16) - 1);
+    av1_estimate_syntax_rate(tst_, EB_FALSE, fc_, NULL);
+    av1_estimate_coefficients_rate(tst_, fc_, NULL);
+    for (int i = 0; i < 100; i++) {
+        memcpy(prev_fc_, fc_, sizeof(*fc_));
+        adapt_cdfs(rnd);
+        av1_estimate_syntax_rate(tst_, EB_FALSE, fc_, prev_fc_);
+        av1_estimate_coefficients_rate(tst_, fc_, prev_fc_);
+        av1_estimate_syntax_rate(ref_, EB_FALSE, fc_, NULL);
+        av1_estimate_coefficients_rate(ref_, fc_, NULL);
+        ASSERT_EQ(0, memcmp(ref_, tst_, sizeof(*ref_))) << "iteration " << i;
+    }
+}
+
+}  // namespace
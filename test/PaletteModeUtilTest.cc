@@ -13,8 +13,8 @@
  * @file PaletteModeUtilTest.cc
  *
  * @brief Unit test for util functions in palette mode:
- * - svt_av1_count_colors
- * - svt_av1_count_colors_highbd
+ * - svt_av1_count_colors_c/avx2
+ * - svt_av1_count_colors_highbd_c/avx2
  * - av1_k_means_dim1
  * - av1_k_means_dim2
  *
@@ -37,6 +37,7 @@
 #include "util.h"
 #include "EbTime.h"
 #include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
 
 using std::tuple;
 using std::vector;
@@ -44,26 +45,26 @@ using svt_av1_test_tool::SVTRandom;
 
 namespace {
 
-extern "C" int svt_av1_count_colors(const uint8_t *src, int stride, int rows,
-                                    int cols, int *val_count);
-extern "C" int svt_av1_count_colors_highbd(uint16_t *src, int stride, int rows,
-                                           int cols, int bit_depth, int *val_count);
-
 /**
  * @brief Unit test for counting colors:
- * - svt_av1_count_colors
- * - svt_av1_count_colors_highbd
+ * - svt_av1_count_colors_c/avx2
+ * - svt_av1_count_colors_highbd_c/avx2
  *
  * Test strategy:
  * Feeds the random value both into test function and the vector without
  * duplicated, then compares the count of result and the individual item count
- * in vector.
+ * in vector. Every other input is made of runs of the same value, as in screen
+ * content.
  *
  * Expected result:
- * The count numbers from test function and vector are the same.
+ * The count numbers from test function and vector are the same, and the
+ * histograms of the C and AVX2 functions are the same. The AVX2 functions are
+ * only checked when the CPU supports AVX2.
  *
  * Test coverage:
- * The input can be 8-bit and 8-bit/10-bit/12-bit for HBD cases
+ * The input can be 8-bit and 8-bit/10-bit/12-bit for HBD cases.
+ * The block sizes go from 1x1 to 64x64, including widths that are not
+ * multiples of 16 or 32 to cover the tails of the AVX2 row loops.
  */
 template <typename Sample>
 class ColorCountTest : public ::testing::Test {
@@ -74,6 +75,8 @@ class ColorCountTest : public ::testing::Test {
         bd_ = 8;
         ref_.clear();
         val_count_ = nullptr;
+        val_count_avx2_ = nullptr;
+        cols_ = rows_ = 64;
     }
 
     ~ColorCountTest() {
@@ -84,14 +87,18 @@ class ColorCountTest : public ::testing::Test {
         aom_clear_system_state();
     }
 
-    void prepare_data() {
+    void prepare_data(bool runs) {
         memset(input_, 0, MAX_PALETTE_SQUARE * sizeof(Sample));
         ref_.clear();
         const int32_t mask = (1 << bd_) - 1;
         for (size_t i = 0; i < MAX_PALETTE_SQUARE; i++) {
-            input_[i] = rnd_.random() & mask;
-            /** put same value into a vector for reference */
-            ref_.push_back(input_[i]);
+            if (runs && i && (rnd_.random() & 63))
+                input_[i] = input_[i - 1];
+            else
+                input_[i] = rnd_.random() & mask;
+            /** put same value of the block into a vector for reference */
+            if ((int)(i % 64) < cols_ && (int)(i / 64) < rows_)
+                ref_.push_back(input_[i]);
         }
         /** remove all duplicated items */
         std::sort(ref_.begin(), ref_.end());
@@ -100,20 +107,42 @@ class ColorCountTest : public ::testing::Test {
     }
 
     void run_test(size_t times) {
+        static const int sizes[] = {64, 63, 48, 33, 32, 31, 17, 16, 15, 7, 1};
+        const int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+        const bool test_avx2 = (get_cpu_flags_to_use() & CPU_FLAGS_AVX2) != 0;
         const int max_colors = (1 << bd_);
         val_count_ = (int *)svt_aom_memalign(32, max_colors * sizeof(int));
+        val_count_avx2_ = (int *)svt_aom_memalign(32, max_colors * sizeof(int));
         for (size_t i = 0; i < times; i++) {
-            prepare_data();
+            cols_ = sizes[(i / 2) % num_sizes];
+            rows_ = sizes[(i / 2 / num_sizes) % num_sizes];
+            prepare_data(i & 1);
             ASSERT_EQ(count_color(), ref_.size())
-                << "color count failed at: " << i;
+                << "color count failed at: " << i << " (" << cols_ << "x"
+                << rows_ << ")";
+            if (!test_avx2)
+                continue;
+            ASSERT_EQ(count_color_avx2(), ref_.size())
+                << "avx2 color count failed at: " << i << " (" << cols_
+                << "x" << rows_ << ")";
+            ASSERT_EQ(0,
+                      memcmp(val_count_,
+                             val_count_avx2_,
+                             max_colors * sizeof(int)))
+                << "avx2 histogram failed at: " << i;
         }
         if (val_count_) {
             svt_aom_free(val_count_);
             val_count_ = nullptr;
         }
+        if (val_count_avx2_) {
+            svt_aom_free(val_count_avx2_);
+            val_count_avx2_ = nullptr;
+        }
     }
 
     virtual unsigned int count_color() = 0;
+    virtual unsigned int count_color_avx2() = 0;
 
   protected:
     SVTRandom rnd_;
@@ -121,6 +150,9 @@ class ColorCountTest : public ::testing::Test {
     uint8_t bd_;
     vector<int> ref_;
     int *val_count_;
+    int *val_count_avx2_;
+    int cols_;
+    int rows_;
 };
 
 class ColorCountLbdTest : public ColorCountTest<uint8_t> {
@@ -128,8 +160,13 @@ class ColorCountLbdTest : public ColorCountTest<uint8_t> {
     unsigned int count_color() override {
         const int max_colors = (1 << bd_);
         memset(val_count_, 0, max_colors * sizeof(int));
-        unsigned int colors =
-            (unsigned int)svt_av1_count_colors(input_, 64, 64, 64, val_count_);
+        unsigned int colors = (unsigned int)svt_av1_count_colors_c(
+            input_, 64, rows_, cols_, val_count_);
+        return colors;
+    }
+    unsigned int count_color_avx2() override {
+        unsigned int colors = (unsigned int)svt_av1_count_colors_avx2(
+            input_, 64, rows_, cols_, val_count_avx2_);
         return colors;
     }
 };
@@ -143,8 +180,13 @@ class ColorCountHbdTest : public ColorCountTest<uint16_t> {
     unsigned int count_color() override {
         const int max_colors = (1 << bd_);
         memset(val_count_, 0, max_colors * sizeof(int));
-        unsigned int colors = (unsigned int)svt_av1_count_colors_highbd(
-            input_, 64, 64, 64, bd_, val_count_);
+        unsigned int colors = (unsigned int)svt_av1_count_colors_highbd_c(
+            input_, 64, rows_, cols_, bd_, val_count_);
+        return colors;
+    }
+    unsigned int count_color_avx2() override {
+        unsigned int colors = (unsigned int)svt_av1_count_colors_highbd_avx2(
+            input_, 64, rows_, cols_, bd_, val_count_avx2_);
         return colors;
     }
 };
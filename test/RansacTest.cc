@@ -0,0 +1,85 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file RansacTest.cc
+ *
+ * @brief Unit test for the RANSAC hypothesis scoring kernel:
+ * - svt_av1_ransac_find_inliers_avx2
+ *
+ * Test strategy:
+ * Project random corners with a random affine model, and move the matches
+ * around the inlier threshold. Feed the same model and points to the C
+ * reference and the AVX2 kernel and check the inliers and the distance sums
+ * are bit-exact.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const int max_points = 1024;
+static const int test_times = 1000;
+
+TEST(RansacTest, find_inliers) {
+    SVTRandom rnd_corner(0, 1920);
+    SVTRandom rnd_noise(-2048, 2048);
+    SVTRandom rnd_npoints(0, max_points);
+    double *corners1 = new double[2 * max_points];
+    double *corners2 = new double[2 * max_points];
+    int *inliers_ref = new int[max_points];
+    int *inliers_tst = new int[max_points];
+
+    for (int i = 0; i < test_times; i++) {
+        double mat[6];
+        mat[0] = rnd_noise.random() / 64.0;
+        mat[1] = rnd_noise.random() / 64.0;
+        mat[2] = 1.0 + rnd_noise.random() / 65536.0;
+        mat[3] = rnd_noise.random() / 65536.0;
+        mat[4] = rnd_noise.random() / 65536.0;
+        mat[5] = 1.0 + rnd_noise.random() / 65536.0;
+        const int npoints = rnd_npoints.random();
+        for (int j = 0; j < npoints; j++) {
+            const double x = rnd_corner.random();
+            const double y = rnd_corner.random();
+            corners1[2 * j] = x;
+            corners1[2 * j + 1] = y;
+            corners2[2 * j] =
+                (int)(mat[2] * x + mat[3] * y + mat[0] + rnd_noise.random() / 1024.0);
+            corners2[2 * j + 1] =
+                (int)(mat[4] * x + mat[5] * y + mat[1] + rnd_noise.random() / 1024.0);
+        }
+
+        double sum_ref = 0, sum_sq_ref = 0, sum_tst = 0, sum_sq_tst = 0;
+        const int num_ref = svt_av1_ransac_find_inliers_c(
+            mat, corners1, corners2, npoints, inliers_ref, &sum_ref, &sum_sq_ref);
+        const int num_tst = svt_av1_ransac_find_inliers_avx2(
+            mat, corners1, corners2, npoints, inliers_tst, &sum_tst, &sum_sq_tst);
+
+        ASSERT_EQ(num_ref, num_tst) << "npoints " << npoints;
+        ASSERT_EQ(0, memcmp(inliers_ref, inliers_tst, num_ref * sizeof(int)));
+        ASSERT_EQ(0, memcmp(&sum_ref, &sum_tst, sizeof(sum_ref)));
+        ASSERT_EQ(0, memcmp(&sum_sq_ref, &sum_sq_tst, sizeof(sum_sq_ref)));
+    }
+
+    delete[] corners1;
+    delete[] corners2;
+    delete[] inliers_ref;
+    delete[] inliers_tst;
+}
+
+}  // namespace
@@ -0,0 +1,215 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file ResizeTest.cc
+ *
+ * @brief Unit test for the resize kernels used by super-res / reference scaling:
+ * - svt_av1_down2_symeven_avx2
+ * - svt_av1_down2_symodd_avx2
+ * - svt_av1_interpolate_core_avx2
+ * - svt_av1_resize_vert_row_avx2
+ * - svt_av1_highbd_down2_symeven_avx2
+ * - svt_av1_highbd_down2_symodd_avx2
+ * - svt_av1_highbd_interpolate_core_avx2
+ * - svt_av1_highbd_resize_vert_row_avx2
+ *
+ * Test strategy:
+ * Feed the same random data, lengths and filters to the C reference and the
+ * AVX2 kernel and check the outputs are bit-exact.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "EbDefinitions.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const int max_length = 512;
+static const int test_times = 2000;
+static const int num_filters = 64;
+
+static void prepare_filters(int16_t *filters, SVTRandom *rnd) {
+    for (int i = 0; i < num_filters * SUBPEL_TAPS; i++)
+        filters[i] = (int16_t)rnd->random();
+}
+
+TEST(ResizeTest, down2_and_interpolate_8bit) {
+    SVTRandom rnd_pel(8, false);
+    SVTRandom rnd_len(1, max_length);
+    SVTRandom rnd_coef(-64, 160);
+    DECLARE_ALIGNED(32, uint8_t, input[max_length]);
+    DECLARE_ALIGNED(32, uint8_t, output_ref[max_length]);
+    DECLARE_ALIGNED(32, uint8_t, output_tst[max_length]);
+    int16_t filters[num_filters * SUBPEL_TAPS];
+
+    for (int i = 0; i < test_times; i++) {
+        for (int j = 0; j < max_length; j++)
+            input[j] = (uint8_t)rnd_pel.random();
+        prepare_filters(filters, &rnd_coef);
+        const int in_length = rnd_len.random();
+        const int out_length = rnd_len.random();
+
+        svt_av1_down2_symeven_c(input, in_length, output_ref);
+        svt_av1_down2_symeven_avx2(input, in_length, output_tst);
+        ASSERT_EQ(0, memcmp(output_ref, output_tst, (in_length + 1) >> 1))
+            << "down2_symeven length " << in_length;
+
+        svt_av1_down2_symodd_c(input, in_length, output_ref);
+        svt_av1_down2_symodd_avx2(input, in_length, output_tst);
+        ASSERT_EQ(0, memcmp(output_ref, output_tst, (in_length + 1) >> 1))
+            << "down2_symodd length " << in_length;
+
+        svt_av1_interpolate_core_c(
+            input, in_length, output_ref, out_length, filters, SUBPEL_TAPS);
+        svt_av1_interpolate_core_avx2(
+            input, in_length, output_tst, out_length, filters, SUBPEL_TAPS);
+        ASSERT_EQ(0, memcmp(output_ref, output_tst, out_length))
+            << "interpolate_core " << in_length << " -> " << out_length;
+    }
+}
+
+TEST(ResizeTest, down2_and_interpolate_highbd) {
+    SVTRandom rnd_len(1, max_length);
+    SVTRandom rnd_coef(-64, 160);
+    DECLARE_ALIGNED(32, uint16_t, input[max_length]);
+    DECLARE_ALIGNED(32, uint16_t, output_ref[max_length]);
+    DECLARE_ALIGNED(32, uint16_t, output_tst[max_length]);
+    int16_t filters[num_filters * SUBPEL_TAPS];
+
+    for (int bd = 10; bd <= 12; bd += 2) {
+        SVTRandom rnd_pel(bd, false);
+        for (int i = 0; i < test_times; i++) {
+            for (int j = 0; j < max_length; j++)
+                input[j] = (uint16_t)rnd_pel.random();
+            prepare_filters(filters, &rnd_coef);
+            const int in_length = rnd_len.random();
+            const int out_length = rnd_len.random();
+
+            svt_av1_highbd_down2_symeven_c(input, in_length, output_ref, bd);
+            svt_av1_highbd_down2_symeven_avx2(
+                input, in_length, output_tst, bd);
+            ASSERT_EQ(0,
+                      memcmp(output_ref,
+                             output_tst,
+                             sizeof(output_ref[0]) * ((in_length + 1) >> 1)))
+                << "highbd_down2_symeven length " << in_length;
+
+            svt_av1_highbd_down2_symodd_c(input, in_length, output_ref, bd);
+            svt_av1_highbd_down2_symodd_avx2(input, in_length, output_tst, bd);
+            ASSERT_EQ(0,
+                      memcmp(output_ref,
+                             output_tst,
+                             sizeof(output_ref[0]) * ((in_length + 1) >> 1)))
+                << "highbd_down2_symodd length " << in_length;
+
+            svt_av1_highbd_interpolate_core_c(input,
+                                              in_length,
+                                              output_ref,
+                                              out_length,
+                                              bd,
+                                              filters,
+                                              SUBPEL_TAPS);
+            svt_av1_highbd_interpolate_core_avx2(input,
+                                                 in_length,
+                                                 output_tst,
+                                                 out_length,
+                                                 bd,
+                                                 filters,
+                                                 SUBPEL_TAPS);
+            ASSERT_EQ(0,
+                      memcmp(output_ref,
+                             output_tst,
+                             sizeof(output_ref[0]) * out_length))
+                << "highbd_interpolate_core " << in_length << " -> "
+                << out_length;
+        }
+    }
+}
+
+TEST(ResizeTest, vert_row_8bit) {
+    const int stride = 80, height = 40;
+    SVTRandom rnd_pel(8, false);
+    SVTRandom rnd_width(1, stride);
+    SVTRandom rnd_row(-SUBPEL_TAPS, height);
+    SVTRandom rnd_coef(-64, 160);
+    DECLARE_ALIGNED(32, uint8_t, input[stride * height]);
+    DECLARE_ALIGNED(32, uint8_t, output_ref[stride]);
+    DECLARE_ALIGNED(32, uint8_t, output_tst[stride]);
+    int16_t filters[num_filters * SUBPEL_TAPS];
+
+    for (int i = 0; i < test_times; i++) {
+        for (int j = 0; j < stride * height; j++)
+            input[j] = (uint8_t)rnd_pel.random();
+        prepare_filters(filters, &rnd_coef);
+        const int width = rnd_width.random();
+        const int first_row = rnd_row.random();
+
+        svt_av1_resize_vert_row_c(
+            input, stride, height, first_row, filters, output_ref, width);
+        svt_av1_resize_vert_row_avx2(
+            input, stride, height, first_row, filters, output_tst, width);
+        ASSERT_EQ(0, memcmp(output_ref, output_tst, width))
+            << "resize_vert_row width " << width << " first row "
+            << first_row;
+    }
+}
+
+TEST(ResizeTest, vert_row_highbd) {
+    const int stride = 80, height = 40;
+    SVTRandom rnd_width(1, stride);
+    SVTRandom rnd_row(-SUBPEL_TAPS, height);
+    SVTRandom rnd_coef(-64, 160);
+    DECLARE_ALIGNED(32, uint16_t, input[stride * height]);
+    DECLARE_ALIGNED(32, uint16_t, output_ref[stride]);
+    DECLARE_ALIGNED(32, uint16_t, output_tst[stride]);
+    int16_t filters[num_filters * SUBPEL_TAPS];
+
+    for (int bd = 10; bd <= 12; bd += 2) {
+        SVTRandom rnd_pel(bd, false);
+        for (int i = 0; i < test_times; i++) {
+            for (int j = 0; j < stride * height; j++)
+                input[j] = (uint16_t)rnd_pel.random();
+            prepare_filters(filters, &rnd_coef);
+            const int width = rnd_width.random();
+            const int first_row = rnd_row.random();
+
+            svt_av1_highbd_resize_vert_row_c(input,
+                                             stride,
+                                             height,
+                                             first_row,
+                                             filters,
+                                             output_ref,
+                                             width,
+                                             bd);
+            svt_av1_highbd_resize_vert_row_avx2(input,
+                                                stride,
+                                                height,
+                                                first_row,
+                                                filters,
+                                                output_tst,
+                                                width,
+                                                bd);
+            ASSERT_EQ(0,
+                      memcmp(output_ref,
+                             output_tst,
+                             sizeof(output_ref[0]) * width))
+                << "highbd_resize_vert_row width " << width << " first row "
+                << first_row;
+        }
+    }
+}
+
+}  // namespace
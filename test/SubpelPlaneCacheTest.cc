@@ -0,0 +1,145 @@
+/*
+ * Copyright(c) 2019 Intel Corporation
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+ */
+
+/******************************************************************************
+ * @file SubpelPlaneCacheTest.cc
+ *
+ * @brief Unit test for the subpel plane cache of the MD subpel search:
+ * - svt_get_cached_subpel_pred
+ *
+ * Test strategy:
+ * Read the predictions of random blocks, half and quarter-pel phases and
+ * search filters from the cached planes of a random reference window, and
+ * check they are bit-exact with the block interpolated by
+ * svt_aom_upsampled_pred. The filter is changed and the window is restarted
+ * now and then, as the MD search does between PD passes and SBs.
+ *
+ ******************************************************************************/
+
+#include "gtest/gtest.h"
+#include "aom_dsp_rtcd.h"
+#include "common_dsp_rtcd.h"
+#include "mcomp.h"
+#include "random.h"
+
+namespace {
+
+using svt_av1_test_tool::SVTRandom;
+
+static const int test_times = 2000;
+// Reference samples around the window read by the interpolation filters
+static const int ref_border = 16;
+
+class SubpelPlaneCacheTest : public ::testing::Test {
+  protected:
+    void SetUp() override {
+        setup_common_rtcd_internal(get_cpu_flags_to_use());
+        setup_rtcd_internal(get_cpu_flags_to_use());
+        size_ = MAX_SB_SIZE + 2 * SUBPEL_CACHE_MARGIN;
+        ref_stride_ = size_ + 2 * ref_border;
+        ref_ = (uint8_t *)malloc(ref_stride_ * ref_stride_);
+        cache_ = (SubpelPlaneCache *)calloc(1, sizeof(*cache_));
+        cache_->tile_pred = (uint8_t *)malloc(SUBPEL_CACHE_TILE_PRED_SIZE);
+        cache_->ref = ref_ + ref_border * ref_stride_ + ref_border;
+        cache_->ref_stride = ref_stride_;
+        cache_->size = size_;
+    }
+
+    void TearDown() override {
+        for (int phase = 0; phase < SUBPEL_CACHE_PHASES; phase++)
+            free(cache_->plane[phase]);
+        free(cache_->tile_pred);
+        free(cache_);
+        free(ref_);
+    }
+
+    int size_;
+    int ref_stride_;
+    uint8_t *ref_;
+    SubpelPlaneCache *cache_;
+};
+
+TEST_F(SubpelPlaneCacheTest, MatchUpsampledPred) {
+    static const SUBPEL_SEARCH_TYPE filters[] = {USE_2_TAPS, USE_4_TAPS, USE_8_TAPS};
+    SVTRandom rnd_pel(8, false);
+    SVTRandom rnd(0, (1 << 16) - 1);
+    DECLARE_ALIGNED(16, uint8_t, pred[MAX_SB_SQUARE]);
+    for (int i = 0; i < ref_stride_ * ref_stride_; i++)
+        ref_[i] = (uint8_t)rnd_pel.random();
+
+    SUBPEL_SEARCH_VAR_PARAMS var_params;
+    memset(&var_params, 0, sizeof(var_params));
+    var_params.plane_cache = cache_;
+    var_params.subpel_search_type = USE_8_TAPS;
+    for (int i = 0; i < test_times; i++) {
+        if (rnd.random() % 64 == 0)
+            var_params.subpel_search_type = filters[rnd.random() % 3];
+        // A new SB starts the window over
+        if (rnd.random() % 256 == 0)
+            cache_->phase_used = 0;
+        const int w = 4 << (rnd.random() % 6);
+        const int h = 4 << (rnd.random() % 6);
+        var_params.w = w;
+        var_params.h = h;
+        // Block position in the window, and prediction position read by the MV
+        var_params.cache_blk_x = rnd.random() % (size_ - w + 1);
+        var_params.cache_blk_y = rnd.random() % (size_ - h + 1);
+        const int x = rnd.random() % (size_ - w + 1);
+        const int y = rnd.random() % (size_ - h + 1);
+        const int subpel_x_q3 = (rnd.random() % 4) << 1;
+        const int subpel_y_q3 = (subpel_x_q3 ? rnd.random() % 4 : 1 + rnd.random() % 3) << 1;
+        const MV mv = {(int16_t)((y - var_params.cache_blk_y) * 8 + subpel_y_q3),
+                       (int16_t)((x - var_params.cache_blk_x) * 8 + subpel_x_q3)};
+
+        const uint8_t *cached = svt_get_cached_subpel_pred(&var_params, &mv);
+        ASSERT_NE(nullptr, cached) << "iteration " << i;
+        svt_aom_upsampled_pred(NULL,
+                               NULL,
+                               0,
+                               0,
+                               NULL,
+                               pred,
+                               w,
+                               h,
+                               subpel_x_q3,
+                               subpel_y_q3,
+                               cache_->ref + y * ref_stride_ + x,
+                               ref_stride_,
+                               var_params.subpel_search_type);
+        for (int r = 0; r < h; r++)
+            ASSERT_EQ(0, memcmp(pred + r * w, cached + r * size_, w))
+                << "iteration " << i << " row " << r << " block " << w << "x" << h
+                << " at (" << x << ", " << y << ") phase (" << subpel_x_q3 << ", "
+                << subpel_y_q3 << ") filter " << var_params.subpel_search_type;
+    }
+}
+
+TEST_F(SubpelPlaneCacheTest, NotCached) {
+    SUBPEL_SEARCH_VAR_PARAMS var_params;
+    memset(&var_params, 0, sizeof(var_params));
+    var_params.plane_cache = cache_;
+    var_params.subpel_search_type = USE_8_TAPS;
+    var_params.w = 16;
+    var_params.h = 16;
+    var_params.cache_blk_x = 0;
+    var_params.cache_blk_y = 0;
+    // Eighth-pel phases are not kept
+    const MV eighth_pel = {4, 1};
+    EXPECT_EQ(nullptr, svt_get_cached_subpel_pred(&var_params, &eighth_pel));
+    // Nor blocks reaching out of the window
+    const MV outside = {-8 + 4, 2};
+    EXPECT_EQ(nullptr, svt_get_cached_subpel_pred(&var_params, &outside));
+    var_params.cache_blk_x = size_ - 16;
+    const MV right = {4, 8 + 2};
+    EXPECT_EQ(nullptr, svt_get_cached_subpel_pred(&var_params, &right));
+}
+
+}  // namespace
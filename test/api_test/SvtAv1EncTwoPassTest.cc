@@ -0,0 +1,147 @@
+/*
+* Copyright(c) 2019 Netflix, Inc.
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at https://www.aomedia.org/license/software-license. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at https://www.aomedia.org/license/patent-license.
+*/
+
+/******************************************************************************
+ * @file SvtAv1EncTwoPassTest.cc
+ *
+ * @brief SVT-AV1 encoder two-pass smoke test
+ *
+ ******************************************************************************/
+#include <string.h>
+#include <vector>
+#include "EbSvtAv1Enc.h"
+#include "gtest/gtest.h"
+#include "SvtAv1EncApiTest.h"
+
+using namespace svt_av1_test;
+
+namespace {
+
+static const uint32_t test_width = 176;
+static const uint32_t test_height = 144;
+static const uint32_t test_frames = 8;
+
+/* Encode test_frames frames of a moving gradient with the given preset and
+ * passes stats, and return the number of packets. When stats_out is not null,
+ * the first pass stats are enabled and copied to it at the end of the stream. */
+static uint32_t encode_frames(int8_t enc_mode, const SvtAv1FixedBuf *stats_in,
+                              std::vector<uint8_t> *stats_out) {
+    SvtAv1Context context;
+    memset(&context, 0, sizeof(context));
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_init_handle(
+                  &context.enc_handle, &context, &context.enc_params))
+        << "svt_av1_enc_init_handle failed";
+    context.enc_params.source_width = test_width;
+    context.enc_params.source_height = test_height;
+    context.enc_params.enc_mode = enc_mode;
+    if (stats_in)
+        context.enc_params.rc_twopass_stats_in = *stats_in;
+    if (stats_out)
+        context.enc_params.rc_firstpass_stats_out = EB_TRUE;
+    EXPECT_EQ(EB_ErrorNone,
+              svt_av1_enc_set_parameter(context.enc_handle, &context.enc_params))
+        << "svt_av1_enc_set_parameter failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_init(context.enc_handle))
+        << "svt_av1_enc_init failed";
+
+    const uint32_t luma_size = test_width * test_height;
+    std::vector<uint8_t> luma(luma_size), chroma(luma_size / 4, 128);
+    EbSvtIOFormat frame;
+    memset(&frame, 0, sizeof(frame));
+    frame.luma = luma.data();
+    frame.cb = chroma.data();
+    frame.cr = chroma.data();
+    frame.y_stride = test_width;
+    frame.cb_stride = test_width / 2;
+    frame.cr_stride = test_width / 2;
+    frame.width = test_width;
+    frame.height = test_height;
+    frame.color_fmt = EB_YUV420;
+
+    EbBufferHeaderType header;
+    memset(&header, 0, sizeof(header));
+    header.size = sizeof(header);
+    for (uint32_t i = 0; i < test_frames; i++) {
+        for (uint32_t y = 0; y < test_height; y++)
+            for (uint32_t x = 0; x < test_width; x++)
+                luma[y * test_width + x] = (uint8_t)(x + y + 2 * i);
+        header.p_buffer = (uint8_t *)&frame;
+        header.n_filled_len = luma_size * 3 / 2;
+        header.pts = i;
+        header.pic_type = EB_AV1_INVALID_PICTURE;
+        header.flags = 0;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_send_picture(context.enc_handle, &header));
+    }
+    header.p_buffer = NULL;
+    header.n_filled_len = 0;
+    header.flags = EB_BUFFERFLAG_EOS;
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_send_picture(context.enc_handle, &header));
+
+    uint32_t packet_count = 0;
+    EbBool eos = EB_FALSE;
+    while (!eos) {
+        EbBufferHeaderType *packet = NULL;
+        EbErrorType status =
+            svt_av1_enc_get_packet(context.enc_handle, &packet, 1);
+        if (status != EB_ErrorNone) {
+            ADD_FAILURE() << "svt_av1_enc_get_packet failed";
+            break;
+        }
+        eos = (packet->flags & EB_BUFFERFLAG_EOS) ? EB_TRUE : EB_FALSE;
+        packet_count++;
+        svt_av1_enc_release_out_buffer(&packet);
+    }
+    if (eos && stats_out) {
+        SvtAv1FixedBuf first_pass_stat;
+        EXPECT_EQ(EB_ErrorNone,
+                  svt_av1_enc_get_stream_info(
+                      context.enc_handle,
+                      SVT_AV1_STREAM_INFO_FIRST_PASS_STATS_OUT,
+                      &first_pass_stat));
+        const uint8_t *buf = (const uint8_t *)first_pass_stat.buf;
+        stats_out->assign(buf, buf + first_pass_stat.sz);
+    }
+
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit(context.enc_handle))
+        << "svt_av1_enc_deinit failed";
+    EXPECT_EQ(EB_ErrorNone, svt_av1_enc_deinit_handle(context.enc_handle))
+        << "svt_av1_enc_deinit_handle failed";
+    return packet_count;
+}
+
+/** @brief two_pass_encode is a api test case
+ * EncApiTest.two_pass_encode is a smoke test of the two-pass encoding
+ *
+ * Test strategy: <br>
+ * Encode a few frames with the first pass stats out, then encode them again
+ * with those stats in.
+ *
+ * Expected result: <br>
+ * Both passes reach the end of the stream without any error, and the first
+ * pass outputs stats.
+ *
+ * Test coverage:
+ * First pass mode decision and second pass rate control.
+ */
+TEST(EncApiTest, two_pass_encode) {
+    std::vector<uint8_t> stats;
+    EXPECT_GT(encode_frames(8, NULL, &stats), 0u);
+    ASSERT_FALSE(stats.empty()) << "no first pass stats";
+
+    SvtAv1FixedBuf stats_in;
+    stats_in.buf = stats.data();
+    stats_in.sz = stats.size();
+    EXPECT_GT(encode_frames(8, &stats_in, NULL), 0u);
+}
+
+}  // namespace